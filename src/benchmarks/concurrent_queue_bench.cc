@@ -0,0 +1,80 @@
+// Copyright 2023 School21 @tandraym
+// Throughput of s21::concurrent_queue with 1 to 16 producer threads pushing
+// 2M messages in total to 2 consumer threads, which drain it either one
+// element per lock (wait_pop) or up to 64 per lock (pop_batch). Producers
+// close the queue when done; consumers stop when it reports closed and
+// drained. Reports messages per second.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+#include "../s21_concurrent_queue.h"
+#include "../s21_vector.h"
+
+namespace {
+constexpr std::int64_t kMessages = std::int64_t{1} << 21;
+constexpr int kConsumers = 2;
+constexpr std::size_t kBatch = 64;
+
+volatile std::int64_t sink;
+
+double MeasureMsgPerSec(int producers, bool batch) {
+  s21::concurrent_queue<std::int64_t> queue;
+  auto start = std::chrono::steady_clock::now();
+  s21::vector<std::thread> consumers;
+  for (int c = 0; c < kConsumers; ++c) {
+    consumers.push_back(std::thread([&queue, batch] {
+      std::int64_t sum = 0;
+      if (batch) {
+        std::int64_t values[kBatch];
+        while (std::size_t n = queue.pop_batch(values, kBatch)) {
+          for (std::size_t i = 0; i < n; ++i) {
+            sum += values[i];
+          }
+        }
+      } else {
+        std::int64_t value;
+        while (queue.wait_pop(value)) {
+          sum += value;
+        }
+      }
+      sink = sum;
+    }));
+  }
+  s21::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.push_back(std::thread([&queue, producers] {
+      for (std::int64_t i = 0; i < kMessages / producers; ++i) {
+        queue.push(i);
+      }
+    }));
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  queue.close();
+  for (std::thread &thread : consumers) {
+    thread.join();
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  return kMessages / seconds / 1e6;
+}
+}  // namespace
+
+int main() {
+  std::printf("%lld messages, %d consumers, batch %zu, %u hardware threads\n",
+              static_cast<long long>(kMessages), kConsumers, kBatch,
+              std::thread::hardware_concurrency());
+  std::printf("%-10s %16s %16s %8s\n", "producers", "wait_pop", "pop_batch",
+              "speedup");
+  for (int producers = 1; producers <= 16; producers *= 2) {
+    double single = MeasureMsgPerSec(producers, false);
+    double batched = MeasureMsgPerSec(producers, true);
+    std::printf("%-10d %10.2f M/s %10.2f M/s %7.2fx\n", producers, single,
+                batched, batched / single);
+  }
+  return 0;
+}
@@ -0,0 +1,93 @@
+// Copyright 2023 School21 @tandraym
+// Queue workloads on s21::deque, s21::list and s21::vector with 8-byte
+// elements: appending and scanning 8M elements, a FIFO that stays at 256
+// elements over 8M push/pop pairs (vector pops with erase(begin())), and
+// 8M push_front calls, which vector does not support in O(1).
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "../s21_deque.h"
+#include "../s21_list.h"
+#include "../s21_vector.h"
+
+namespace {
+constexpr std::int64_t kOps = std::int64_t{1} << 23;
+constexpr std::int64_t kDepth = 256;
+
+volatile std::int64_t sink;
+
+template <class Fn>
+double MeasureMs(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+template <class Container>
+double AppendAndScan() {
+  return MeasureMs([] {
+    Container c;
+    for (std::int64_t i = 0; i < kOps; ++i) {
+      c.push_back(i);
+    }
+    std::int64_t sum = 0;
+    for (std::int64_t x : c) {
+      sum += x;
+    }
+    sink = sum;
+  });
+}
+
+template <class Container, class Pop>
+double SteadyQueue(Pop &&pop) {
+  return MeasureMs([&] {
+    Container c;
+    std::int64_t sum = 0;
+    for (std::int64_t i = 0; i < kOps; ++i) {
+      c.push_back(i);
+      if (i >= kDepth) {
+        sum += c.front();
+        pop(c);
+      }
+    }
+    sink = sum;
+  });
+}
+
+template <class Container>
+double PushFront() {
+  return MeasureMs([] {
+    Container c;
+    for (std::int64_t i = 0; i < kOps; ++i) {
+      c.push_front(i);
+    }
+    sink = c.front();
+  });
+}
+}  // namespace
+
+int main() {
+  using Deque = s21::deque<std::int64_t>;
+  using List = s21::list<std::int64_t>;
+  using Vector = s21::vector<std::int64_t>;
+  double append[] = {AppendAndScan<Deque>(), AppendAndScan<List>(),
+                     AppendAndScan<Vector>()};
+  double fifo[] = {
+      SteadyQueue<Deque>([](Deque &c) { c.pop_front(); }),
+      SteadyQueue<List>([](List &c) { c.pop_front(); }),
+      SteadyQueue<Vector>([](Vector &c) { c.erase(c.begin()); })};
+  double front[] = {PushFront<Deque>(), PushFront<List>()};
+
+  std::printf("%lld operations per row, ms\n", static_cast<long long>(kOps));
+  std::printf("%-22s %10s %10s %10s\n", "workload", "deque", "list",
+              "vector");
+  std::printf("%-22s %10.1f %10.1f %10.1f\n", "push_back + scan", append[0],
+              append[1], append[2]);
+  std::printf("%-22s %10.1f %10.1f %10.1f\n", "fifo, depth 256", fifo[0],
+              fifo[1], fifo[2]);
+  std::printf("%-22s %10.1f %10.1f %10s\n", "push_front", front[0],
+              front[1], "-");
+  return 0;
+}
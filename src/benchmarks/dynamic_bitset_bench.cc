@@ -0,0 +1,90 @@
+// Copyright 2023 School21 @tandraym
+// Filter masks of 256M flags: s21::dynamic_bitset (one bit per flag) against
+// s21::vector<bool> (one byte per flag) for building by push_back, counting
+// set flags, combining two masks with AND and walking the set positions.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "../s21_dynamic_bitset.h"
+#include "../s21_vector.h"
+
+namespace {
+constexpr std::size_t kSize = std::size_t{1} << 28;
+
+volatile std::size_t sink;
+
+template <class Fn>
+double MeasureMs(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+bool Flag(std::size_t i, unsigned salt) {
+  return ((i * 2654435761u) ^ salt) % 7 == 0;
+}
+
+void Report(const char *op, double bits_ms, double bytes_ms) {
+  std::printf("%-10s %14.1f %14.1f %7.1fx\n", op, bits_ms, bytes_ms,
+              bytes_ms / bits_ms);
+}
+}  // namespace
+
+int main() {
+  s21::dynamic_bitset a, b;
+  double bits_build = MeasureMs([&] {
+    for (std::size_t i = 0; i < kSize; ++i) {
+      a.push_back(Flag(i, 1));
+      b.push_back(Flag(i, 2));
+    }
+  });
+  double bits_count = MeasureMs([&] { sink = a.count(); });
+  double bits_and = MeasureMs([&] { a &= b; });
+  double bits_walk = MeasureMs([&] {
+    std::size_t n = 0;
+    for (std::size_t i = a.find_first(); i != s21::dynamic_bitset::npos;
+         i = a.find_next(i)) {
+      n += i;
+    }
+    sink = n;
+  });
+
+  s21::vector<bool> c, d;
+  double bytes_build = MeasureMs([&] {
+    for (std::size_t i = 0; i < kSize; ++i) {
+      c.push_back(Flag(i, 1));
+      d.push_back(Flag(i, 2));
+    }
+  });
+  double bytes_count = MeasureMs([&] {
+    std::size_t n = 0;
+    for (bool flag : c) {
+      n += flag;
+    }
+    sink = n;
+  });
+  double bytes_and = MeasureMs([&] {
+    for (std::size_t i = 0; i < kSize; ++i) {
+      c[i] = c[i] && d[i];
+    }
+  });
+  double bytes_walk = MeasureMs([&] {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < kSize; ++i) {
+      n += c[i] ? i : 0;
+    }
+    sink = n;
+  });
+
+  std::printf("%zu flags: %zu MB as bits, %zu MB as bytes; ms\n", kSize,
+              a.num_blocks() * 8 >> 20, c.size() >> 20);
+  std::printf("%-10s %14s %14s %8s\n", "op", "dynamic_bitset",
+              "vector<bool>", "speedup");
+  Report("push_back", bits_build, bytes_build);
+  Report("count", bits_count, bytes_count);
+  Report("and", bits_and, bytes_and);
+  Report("walk set", bits_walk, bytes_walk);
+  return 0;
+}
@@ -0,0 +1,92 @@
+// Copyright 2023 School21 @tandraym
+// Read-side cost of s21::epoch: nanoseconds per protected read of a shared
+// pointer with no protection at all, under an epoch::guard (outermost, and
+// nested inside another), under a hazard pointer as s21::concurrent_stack
+// uses it, and under a std::mutex. Single-threaded, so every figure is the
+// uncontended cost. A last row measures retire() of fresh nodes, including
+// the amortized collection.
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+
+#include "../s21_concurrent_stack.h"
+#include "../s21_epoch.h"
+
+namespace {
+constexpr int kReads = 1 << 24;
+constexpr int kRetires = 1 << 20;
+
+struct Node {
+  std::int64_t value;
+};
+
+volatile std::int64_t sink;
+
+template <class Fn>
+double MeasureMs(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+double NsPerRead(double ms) { return ms * 1e6 / kReads; }
+
+template <class Protect>
+double MeasureReads(std::atomic<Node *> &shared, Protect &&protect) {
+  return NsPerRead(MeasureMs([&] {
+    std::int64_t sum = 0;
+    for (int i = 0; i < kReads; ++i) {
+      protect([&] { sum += shared.load(std::memory_order_acquire)->value; });
+    }
+    sink = sum;
+  }));
+}
+}  // namespace
+
+int main() {
+  Node node{1};
+  std::atomic<Node *> shared{&node};
+  std::mutex mutex;
+
+  double plain = MeasureReads(shared, [](auto &&read) { read(); });
+  double guard = MeasureReads(shared, [](auto &&read) {
+    s21::epoch::guard g;
+    read();
+  });
+  double nested = 0;
+  {
+    s21::epoch::guard outer;
+    nested = MeasureReads(shared, [](auto &&read) {
+      s21::epoch::guard g;
+      read();
+    });
+  }
+  double hazard = MeasureReads(shared, [&](auto &&read) {
+    s21::internal::HazardPointers::Protect(shared.load());
+    read();
+    s21::internal::HazardPointers::Clear();
+  });
+  double locked = MeasureReads(shared, [&](auto &&read) {
+    std::lock_guard<std::mutex> lock(mutex);
+    read();
+  });
+  double retire = MeasureMs([] {
+    for (int i = 0; i < kRetires; ++i) {
+      s21::epoch::retire(new Node{i});
+    }
+    s21::epoch::collect();
+  });
+
+  std::printf("membarrier: %s\n",
+              s21::internal::EpochDomain::Asymmetric() ? "yes" : "no");
+  std::printf("%-22s %8.2f ns\n", "unprotected", plain);
+  std::printf("%-22s %8.2f ns\n", "epoch::guard", guard);
+  std::printf("%-22s %8.2f ns\n", "epoch::guard nested", nested);
+  std::printf("%-22s %8.2f ns\n", "hazard pointer", hazard);
+  std::printf("%-22s %8.2f ns\n", "std::mutex", locked);
+  std::printf("%-22s %8.2f ns\n", "epoch::retire", retire * 1e6 / kRetires);
+  return 0;
+}
@@ -0,0 +1,70 @@
+// Copyright 2023 School21 @tandraym
+// Startup and first full scan of a 256 MB array file: s21::mmap_vector
+// maps it, the baseline reads it into an s21::vector with fread. The file
+// is in the page cache after it is written, so this is the best case for
+// the read path; on a cold cache it also waits for the disk up front.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <string>
+
+#include "../s21_mmap_vector.h"
+#include "../s21_vector.h"
+
+namespace {
+constexpr std::size_t kSize = std::size_t{32} << 20;
+
+volatile std::int64_t sink;
+
+template <class Fn>
+double MeasureMs(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+}  // namespace
+
+int main() {
+  std::string path = "/tmp/s21_mmap_vector_bench.bin";
+  std::remove(path.c_str());
+  double append_ms = MeasureMs([&] {
+    s21::mmap_vector<std::int64_t> v(path);
+    for (std::size_t i = 0; i < kSize; ++i) {
+      v.push_back(static_cast<std::int64_t>(i));
+    }
+  });
+  std::printf("%zu MB file, appended through mmap_vector in %.1f ms\n",
+              kSize * sizeof(std::int64_t) >> 20, append_ms);
+
+  s21::mmap_vector<std::int64_t> mapped;
+  double map_open = MeasureMs([&] {
+    mapped.open(path, s21::mmap_vector<std::int64_t>::mode::read_only);
+    mapped.advise(s21::mmap_vector<std::int64_t>::access::sequential);
+  });
+  double map_scan = MeasureMs([&] {
+    sink = std::accumulate(mapped.begin(), mapped.end(), std::int64_t{0});
+  });
+
+  s21::vector<std::int64_t> loaded;
+  double read_open = MeasureMs([&] {
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    loaded.resize(kSize);
+    std::size_t got =
+        std::fread(loaded.data(), sizeof(std::int64_t), kSize, file);
+    std::fclose(file);
+    sink = static_cast<std::int64_t>(got);
+  });
+  double read_scan = MeasureMs([&] {
+    sink = std::accumulate(loaded.begin(), loaded.end(), std::int64_t{0});
+  });
+
+  std::printf("%-24s open %9.3f ms   first scan %8.1f ms\n",
+              "s21::mmap_vector", map_open, map_scan);
+  std::printf("%-24s open %9.3f ms   first scan %8.1f ms\n",
+              "fread into s21::vector", read_open, read_scan);
+  mapped.close();
+  std::remove(path.c_str());
+  return 0;
+}
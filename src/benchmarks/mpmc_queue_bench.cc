@@ -0,0 +1,117 @@
+// Copyright 2023 School21 @tandraym
+// Fan-in of 4M messages from 8 producer threads to 2 consumer threads, the
+// shape of a logging pipeline: s21::mpmc_queue with its blocking push/pop
+// and with 32-message bulk pops, against s21::queue guarded by a std::mutex
+// and two condition variables. Reports messages per second.
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "../s21_mpmc_queue.h"
+#include "../s21_queue.h"
+#include "../s21_vector.h"
+
+namespace {
+constexpr std::int64_t kMessages = std::int64_t{1} << 22;
+constexpr std::size_t kCapacity = 1024;
+constexpr int kProducers = 8;
+constexpr int kConsumers = 2;
+constexpr std::size_t kBatch = 32;
+
+volatile std::int64_t sink;
+
+class MutexQueue {
+ public:
+  void push(std::int64_t value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [this] { return queue_.size() < kCapacity; });
+    queue_.push(value);
+    not_empty_.notify_one();
+  }
+
+  void pop(std::int64_t &out) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return !queue_.empty(); });
+    out = queue_.front();
+    queue_.pop();
+    not_full_.notify_one();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  s21::queue<std::int64_t> queue_;
+};
+
+// Each consumer takes exactly its share; pop returns how many it took.
+template <class Queue, class Pop>
+void Run(const char *name, Queue &queue, Pop pop) {
+  auto start = std::chrono::steady_clock::now();
+  s21::vector<std::thread> threads;
+  for (int p = 0; p < kProducers; ++p) {
+    threads.push_back(std::thread([&queue] {
+      for (std::int64_t i = 0; i < kMessages / kProducers; ++i) {
+        queue.push(i);
+      }
+    }));
+  }
+  for (int c = 0; c < kConsumers; ++c) {
+    threads.push_back(std::thread([&queue, &pop] {
+      std::int64_t sum = 0;
+      std::int64_t left = kMessages / kConsumers;
+      while (left > 0) {
+        left -= pop(queue, sum, left);
+      }
+      sink = sum;
+    }));
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  std::printf("%-26s %8.2f M msg/s\n", name, kMessages / seconds / 1e6);
+}
+}  // namespace
+
+int main() {
+  std::printf("%lld messages, %d producers, %d consumers, capacity %zu, "
+              "%u hardware threads\n",
+              static_cast<long long>(kMessages), kProducers, kConsumers,
+              kCapacity, std::thread::hardware_concurrency());
+  auto pop_one = [](auto &queue, std::int64_t &sum,
+                    std::int64_t) -> std::int64_t {
+    std::int64_t value;
+    queue.pop(value);
+    sum += value;
+    return 1;
+  };
+  s21::mpmc_queue<std::int64_t> mpmc(kCapacity);
+  Run("s21::mpmc_queue", mpmc, pop_one);
+  s21::mpmc_queue<std::int64_t> bulk(kCapacity);
+  Run("s21::mpmc_queue, bulk pop", bulk,
+      [](auto &queue, std::int64_t &sum, std::int64_t left) -> std::int64_t {
+        // Never take more than this consumer's share, or the other one
+        // would wait forever for messages that were never sent.
+        std::int64_t values[kBatch];
+        std::size_t n =
+            queue.try_pop(values, std::min<std::size_t>(kBatch, left));
+        if (n == 0) {
+          queue.pop(values[0]);
+          n = 1;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+          sum += values[i];
+        }
+        return static_cast<std::int64_t>(n);
+      });
+  MutexQueue locked;
+  Run("mutex + s21::queue", locked, pop_one);
+  return 0;
+}
@@ -0,0 +1,112 @@
+// Copyright 2023 School21 @tandraym
+// Scaling of the s21::parallel algorithms on a 4M-element s21::vector of
+// doubles with thread pools of 1 to 32 workers, against the serial std::
+// algorithm. Speedups are bounded by the cores of the machine running it.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+
+#include "../s21_parallel.h"
+#include "../s21_vector.h"
+
+namespace {
+constexpr std::size_t kSize = std::size_t{1} << 22;
+
+volatile double sink;
+
+template <class Fn>
+double MeasureMs(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+s21::vector<double> Shuffled() {
+  s21::vector<double> v(kSize);
+  unsigned seed = 42;
+  for (double &x : v) {
+    seed = seed * 1103515245 + 12345;
+    x = static_cast<double>(seed >> 8);
+  }
+  return v;
+}
+
+// Times serial_fn when pool is null, parallel_fn otherwise.
+template <class Parallel, class Serial>
+double Time(s21::task_pool *pool, Parallel &&parallel_fn,
+            Serial &&serial_fn) {
+  return pool ? MeasureMs(parallel_fn) : MeasureMs(serial_fn);
+}
+
+void RunAll(s21::task_pool *pool, double *ms) {
+  s21::parallel::policy pol{pool, 0};
+  s21::vector<double> data = Shuffled();
+  s21::vector<double> out(kSize);
+  auto heavy = [](double x) { return std::sqrt(x) * std::log1p(x); };
+  auto bump = [&](double &x) { x = heavy(x + 1); };
+  double *first = data.data();
+  double *last = first + kSize;
+  double *d_first = out.data();
+  double *d_last = d_first + kSize;
+  ms[0] = Time(
+      pool, [&] { s21::parallel::fill(pol, d_first, d_last, 1.0); },
+      [&] { std::fill(d_first, d_last, 1.0); });
+  ms[1] = Time(
+      pool, [&] { s21::parallel::for_each(pol, d_first, d_last, bump); },
+      [&] { std::for_each(d_first, d_last, bump); });
+  ms[2] = Time(
+      pool,
+      [&] { s21::parallel::transform(pol, first, last, d_first, heavy); },
+      [&] { std::transform(first, last, d_first, heavy); });
+  ms[3] = Time(
+      pool, [&] { sink = s21::parallel::reduce(pol, first, last); },
+      [&] { sink = std::accumulate(first, last, 0.0); });
+  ms[4] = Time(
+      pool,
+      [&] { s21::parallel::inclusive_scan(pol, first, last, d_first); },
+      [&] { std::inclusive_scan(first, last, d_first); });
+  ms[5] = Time(
+      pool, [&] { s21::parallel::sort(pol, first, last); },
+      [&] { std::sort(first, last); });
+  data = Shuffled();
+  first = data.data();
+  last = first + kSize;
+  ms[6] = Time(
+      pool, [&] { s21::parallel::stable_sort(pol, first, last); },
+      [&] { std::stable_sort(first, last); });
+}
+}  // namespace
+
+int main() {
+  const char *names[] = {"fill",   "for_each",       "transform",
+                         "reduce", "inclusive_scan", "sort",
+                         "stable_sort"};
+  constexpr int kAlgorithms = 7;
+  double serial[kAlgorithms];
+  RunAll(nullptr, serial);
+  std::printf("%zu doubles, %u hardware threads; ms (speedup vs serial)\n",
+              kSize, std::thread::hardware_concurrency());
+  std::printf("%-15s %9s", "algorithm", "serial");
+  const std::size_t threads[] = {1, 2, 4, 8, 16, 32};
+  for (std::size_t t : threads) {
+    std::printf(" %13zu", t);
+  }
+  std::printf("\n");
+  double results[6][kAlgorithms];
+  for (int t = 0; t < 6; ++t) {
+    s21::task_pool pool(threads[t]);
+    RunAll(&pool, results[t]);
+  }
+  for (int a = 0; a < kAlgorithms; ++a) {
+    std::printf("%-15s %9.1f", names[a], serial[a]);
+    for (int t = 0; t < 6; ++t) {
+      std::printf(" %7.1f (%3.1fx)", results[t][a],
+                  serial[a] / results[t][a]);
+    }
+    std::printf("\n");
+  }
+  return 0;
+}
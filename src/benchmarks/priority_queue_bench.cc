@@ -0,0 +1,201 @@
+// Copyright 2023 School21 @tandraym
+// s21::priority_queue (binary and 4-ary) and s21::indexed_heap against
+// s21::set used as a heap: 1M pushes of random keys followed by popping
+// everything, building from 1M keys at once (push_many against inserting
+// one by one), and Dijkstra over a 512 x 512 grid with random edge weights,
+// where a shorter path found to a queued vertex is a decrease_key on the
+// indexed heap and an erase plus insert on the set.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <utility>
+
+#include "../s21_priority_queue.h"
+#include "../s21_set.h"
+#include "../s21_vector.h"
+
+namespace {
+constexpr int kKeys = 1 << 20;
+constexpr int kSide = 512;
+constexpr std::int64_t kFar = std::numeric_limits<std::int64_t>::max();
+
+using Entry = std::pair<std::int64_t, int>;
+
+volatile std::int64_t sink;
+
+template <class Fn>
+double MeasureMs(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+s21::vector<std::int64_t> RandomKeys(int n, std::uint64_t seed) {
+  s21::vector<std::int64_t> keys;
+  keys.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    keys.push_back(static_cast<std::int64_t>(seed >> 33));
+  }
+  return keys;
+}
+
+// Pairs each key with its index, so keys stay unique in the set.
+template <class Heap>
+double PushPopHeap(const s21::vector<std::int64_t> &keys) {
+  return MeasureMs([&] {
+    Heap heap;
+    for (int i = 0; i < kKeys; ++i) {
+      heap.push(Entry{keys[i], i});
+    }
+    std::int64_t sum = 0;
+    while (!heap.empty()) {
+      sum += heap.top().first;
+      heap.pop();
+    }
+    sink = sum;
+  });
+}
+
+double PushPopSet(const s21::vector<std::int64_t> &keys) {
+  return MeasureMs([&] {
+    s21::set<Entry> set;
+    for (int i = 0; i < kKeys; ++i) {
+      set.insert(Entry{keys[i], i});
+    }
+    std::int64_t sum = 0;
+    while (!set.empty()) {
+      sum += (*set.begin()).first;
+      set.erase(set.begin());
+    }
+    sink = sum;
+  });
+}
+
+template <class Heap>
+double BuildHeap(const s21::vector<Entry> &entries) {
+  return MeasureMs([&] {
+    Heap heap;
+    heap.push_many(entries.begin(), entries.end());
+    sink = heap.top().first;
+  });
+}
+
+double BuildSet(const s21::vector<Entry> &entries) {
+  return MeasureMs([&] {
+    s21::set<Entry> set;
+    for (const Entry &entry : entries) {
+      set.insert(entry);
+    }
+    sink = (*set.begin()).first;
+  });
+}
+
+// Weight of the edge leaving vertex v in direction d (0..3).
+std::int64_t Weight(const s21::vector<std::int64_t> &weights, int v, int d) {
+  return weights[v * 4 + d] % 100 + 1;
+}
+
+template <class Relax>
+void ForEachNeighbour(int v, Relax &&relax) {
+  int row = v / kSide;
+  int col = v % kSide;
+  if (row > 0) {
+    relax(v - kSide, 0);
+  }
+  if (row + 1 < kSide) {
+    relax(v + kSide, 1);
+  }
+  if (col > 0) {
+    relax(v - 1, 2);
+  }
+  if (col + 1 < kSide) {
+    relax(v + 1, 3);
+  }
+}
+
+double DijkstraIndexedHeap(const s21::vector<std::int64_t> &weights) {
+  return MeasureMs([&] {
+    constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+    s21::indexed_heap<Entry, std::greater<Entry>, 4> heap;
+    s21::vector<std::int64_t> dist(kSide * kSide);
+    std::fill(dist.begin(), dist.end(), kFar);
+    s21::vector<std::size_t> handle(kSide * kSide);
+    std::fill(handle.begin(), handle.end(), kNone);
+    dist[0] = 0;
+    handle[0] = heap.push(Entry{0, 0});
+    while (!heap.empty()) {
+      int v = heap.top().second;
+      heap.pop();
+      ForEachNeighbour(v, [&](int u, int d) {
+        std::int64_t through = dist[v] + Weight(weights, v, d);
+        if (through < dist[u]) {
+          dist[u] = through;
+          if (handle[u] != kNone && heap.contains(handle[u]) &&
+              heap[handle[u]].second == u) {
+            heap.decrease_key(handle[u], Entry{through, u});
+          } else {
+            handle[u] = heap.push(Entry{through, u});
+          }
+        }
+      });
+    }
+    sink = dist[kSide * kSide - 1];
+  });
+}
+
+double DijkstraSet(const s21::vector<std::int64_t> &weights) {
+  return MeasureMs([&] {
+    s21::set<Entry> set;
+    s21::vector<std::int64_t> dist(kSide * kSide);
+    std::fill(dist.begin(), dist.end(), kFar);
+    dist[0] = 0;
+    set.insert(Entry{0, 0});
+    while (!set.empty()) {
+      int v = (*set.begin()).second;
+      set.erase(set.begin());
+      ForEachNeighbour(v, [&](int u, int d) {
+        std::int64_t through = dist[v] + Weight(weights, v, d);
+        if (through < dist[u]) {
+          if (dist[u] != kFar) {
+            set.erase(set.find(Entry{dist[u], u}));
+          }
+          dist[u] = through;
+          set.insert(Entry{through, u});
+        }
+      });
+    }
+    sink = dist[kSide * kSide - 1];
+  });
+}
+}  // namespace
+
+int main() {
+  using Binary = s21::priority_queue<Entry, s21::vector<Entry>,
+                                     std::greater<Entry>, 2>;
+  using FourAry = s21::priority_queue<Entry, s21::vector<Entry>,
+                                      std::greater<Entry>, 4>;
+  s21::vector<std::int64_t> keys = RandomKeys(kKeys, 42);
+  s21::vector<Entry> entries;
+  entries.reserve(kKeys);
+  for (int i = 0; i < kKeys; ++i) {
+    entries.push_back(Entry{keys[i], i});
+  }
+  s21::vector<std::int64_t> weights = RandomKeys(kSide * kSide * 4, 7);
+
+  std::printf("%-22s %12s %12s %12s\n", "", "push+pop 1M", "build 1M",
+              "dijkstra");
+  std::printf("%-22s %9.1f ms %9.1f ms %12s\n", "priority_queue d=2",
+              PushPopHeap<Binary>(keys), BuildHeap<Binary>(entries), "-");
+  std::printf("%-22s %9.1f ms %9.1f ms %12s\n", "priority_queue d=4",
+              PushPopHeap<FourAry>(keys), BuildHeap<FourAry>(entries), "-");
+  std::printf("%-22s %12s %12s %9.1f ms\n", "indexed_heap d=4", "-", "-",
+              DijkstraIndexedHeap(weights));
+  std::printf("%-22s %9.1f ms %9.1f ms %9.1f ms\n", "s21::set",
+              PushPopSet(keys), BuildSet(entries), DijkstraSet(weights));
+  return 0;
+}
@@ -0,0 +1,85 @@
+// Copyright 2023 School21 @tandraym
+// Parse-to-process FIFO of 8M 32-byte messages that stays under 1024
+// entries: s21::queue over s21::list, s21::deque and s21::ring_buffer with
+// one push and pop per message, and ring_buffer bulk push/pop of 64
+// messages at a time.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "../s21_deque.h"
+#include "../s21_list.h"
+#include "../s21_queue.h"
+#include "../s21_ring_buffer.h"
+
+namespace {
+constexpr std::int64_t kMessages = std::int64_t{1} << 23;
+constexpr std::int64_t kDepth = 1024;
+constexpr std::int64_t kBatch = 64;
+
+struct Message {
+  std::int64_t id;
+  std::int64_t payload[3];
+};
+
+volatile std::int64_t sink;
+
+template <class Fn>
+double MeasureMs(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+template <class Queue>
+double PerMessage() {
+  return MeasureMs([] {
+    Queue q;
+    std::int64_t sum = 0;
+    for (std::int64_t i = 0; i < kMessages; ++i) {
+      q.push(Message{i, {i, i, i}});
+      if (i >= kDepth) {
+        sum += q.front().id;
+        q.pop();
+      }
+    }
+    sink = sum;
+  });
+}
+
+double Batched() {
+  return MeasureMs([] {
+    s21::ring_buffer<Message> ring(2 * kDepth);
+    Message in[kBatch];
+    Message out[kBatch];
+    std::int64_t sum = 0;
+    for (std::int64_t i = 0; i < kMessages; i += kBatch) {
+      for (std::int64_t j = 0; j < kBatch; ++j) {
+        in[j] = Message{i + j, {i, i, i}};
+      }
+      ring.push(in, kBatch);
+      if (i >= kDepth) {
+        std::size_t n = ring.pop(out, kBatch);
+        for (std::size_t j = 0; j < n; ++j) {
+          sum += out[j].id;
+        }
+      }
+    }
+    sink = sum;
+  });
+}
+}  // namespace
+
+int main() {
+  double list = PerMessage<s21::queue<Message, s21::list<Message>>>();
+  double deque = PerMessage<s21::queue<Message, s21::deque<Message>>>();
+  double ring = PerMessage<s21::queue<Message, s21::ring_buffer<Message>>>();
+  double batched = Batched();
+  std::printf("%lld messages, ms\n", static_cast<long long>(kMessages));
+  std::printf("%-28s %8.1f\n", "queue<list>", list);
+  std::printf("%-28s %8.1f\n", "queue<deque>", deque);
+  std::printf("%-28s %8.1f\n", "queue<ring_buffer>", ring);
+  std::printf("%-28s %8.1f\n", "ring_buffer push/pop x64", batched);
+  return 0;
+}
@@ -0,0 +1,124 @@
+// Copyright 2023 School21 @tandraym
+// Throughput of the s21::simd kernels over a 4 MB s21::vector, once per
+// instruction set the CPU supports; "scalar" is the std:: algorithm loop.
+// The last rows run the widest kernels over an s21::aligned_vector, once
+// from its 64-byte aligned start and once from 4 bytes past it, where every
+// full-width load splits a cache line.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "../s21_simd.h"
+#include "../s21_vector.h"
+
+namespace {
+constexpr std::size_t kSize = std::size_t{1} << 20;
+constexpr int kReps = 200;
+
+volatile std::size_t sink;
+
+template <class Fn>
+double MeasureMs(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+// bytes_per_rep is what one call reads or writes; equal reads two buffers.
+template <class Fn>
+void Report(const char *op, std::size_t bytes_per_rep, Fn &&fn) {
+  double ms = MeasureMs([&] {
+    for (int i = 0; i < kReps; ++i) {
+      fn();
+    }
+  });
+  double gb = static_cast<double>(bytes_per_rep) * kReps / 1e9;
+  std::printf("  %-12s %8.2f GB/s\n", op, gb / (ms / 1000.0));
+}
+
+const char *IsaName(s21::simd::isa level) {
+  switch (level) {
+    case s21::simd::isa::avx512:
+      return "avx512";
+    case s21::simd::isa::avx2:
+      return "avx2";
+    case s21::simd::isa::sse2:
+      return "sse2";
+    case s21::simd::isa::scalar:
+      break;
+  }
+  return "scalar";
+}
+
+template <class T>
+void Run(const char *type_name) {
+  s21::vector<T> a(kSize);
+  for (std::size_t i = 0; i < kSize; ++i) {
+    a[i] = static_cast<T>(i % 1000);
+  }
+  s21::vector<T> b(a);
+  s21::vector<T> out(kSize);
+  const T *first = a.data();
+  const T *last = first + kSize;
+  const std::size_t bytes = kSize * sizeof(T);
+  const s21::simd::isa levels[] = {s21::simd::isa::scalar,
+                                   s21::simd::isa::sse2, s21::simd::isa::avx2,
+                                   s21::simd::isa::avx512};
+  for (s21::simd::isa requested : levels) {
+    if (s21::simd::set_isa(requested) != requested) {
+      continue;
+    }
+    std::printf("%s, %s\n", type_name, IsaName(requested));
+    Report("find (miss)", bytes, [&] {
+      sink = s21::simd::find(first, last, T(-1)) - first;
+    });
+    Report("count", bytes,
+           [&] { sink = s21::simd::count(first, last, T(7)); });
+    Report("min_element", bytes, [&] {
+      sink = s21::simd::min_element(first, last) - first;
+    });
+    Report("max_element", bytes, [&] {
+      sink = s21::simd::max_element(first, last) - first;
+    });
+    Report("equal", 2 * bytes, [&] {
+      sink = s21::simd::equal(first, last, b.data());
+    });
+    Report("fill", bytes, [&] {
+      s21::simd::fill(out.data(), out.data() + kSize, T(3));
+    });
+  }
+  s21::simd::set_isa(s21::simd::detected_isa());
+}
+
+void RunAlignment() {
+  s21::aligned_vector<float, 64> a(kSize + 16);
+  s21::aligned_vector<float, 64> out(kSize + 16);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<float>(i % 1000);
+  }
+  const std::size_t bytes = kSize * sizeof(float);
+  for (std::size_t offset : {0, 1}) {
+    const float *first = a.data() + offset;
+    float *d_first = out.data() + offset;
+    std::printf("float, %s, data() + %zu\n",
+                IsaName(s21::simd::active_isa()), offset);
+    Report("count", bytes, [&] {
+      sink = s21::simd::count(first, first + kSize, 7.0f);
+    });
+    Report("max_element", bytes, [&] {
+      sink = s21::simd::max_element(first, first + kSize) - first;
+    });
+    Report("fill", bytes,
+           [&] { s21::simd::fill(d_first, d_first + kSize, 3.0f); });
+  }
+}
+}  // namespace
+
+int main() {
+  std::printf("%zu elements per call, %d calls per row\n", kSize, kReps);
+  Run<std::int32_t>("int32_t");
+  Run<float>("float");
+  RunAlignment();
+  return 0;
+}
@@ -0,0 +1,84 @@
+// Copyright 2023 School21 @tandraym
+// One-field passes over 4M particles: summing the x coordinate and scaling
+// the mass, stored as an s21::vector of 32-byte structs and as an
+// s21::soa_vector with one column per field. The struct layout reads all
+// eight fields of every particle to use one of them.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "../s21_soa_vector.h"
+#include "../s21_vector.h"
+
+namespace {
+constexpr std::size_t kSize = std::size_t{1} << 22;
+constexpr int kReps = 20;
+
+volatile float sink;
+
+template <class Fn>
+double MeasureMs(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kReps; ++i) {
+    fn();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count() /
+         kReps;
+}
+
+struct Particle {
+  float x, y, z;
+  float vx, vy, vz;
+  float mass;
+  std::int32_t id;
+};
+}  // namespace
+
+int main() {
+  s21::vector<Particle> aos;
+  s21::soa_vector<float, float, float, float, float, float, float,
+                  std::int32_t>
+      soa;
+  aos.reserve(kSize);
+  soa.reserve(kSize);
+  for (std::size_t i = 0; i < kSize; ++i) {
+    float f = static_cast<float>(i % 1024);
+    aos.push_back({f, f, f, f, f, f, 1.0f, static_cast<std::int32_t>(i)});
+    soa.emplace_back(f, f, f, f, f, f, 1.0f, static_cast<std::int32_t>(i));
+  }
+
+  double aos_sum = MeasureMs([&] {
+    float sum = 0;
+    for (const Particle &p : aos) {
+      sum += p.x;
+    }
+    sink = sum;
+  });
+  double soa_sum = MeasureMs([&] {
+    float sum = 0;
+    for (float x : soa.get<0>()) {
+      sum += x;
+    }
+    sink = sum;
+  });
+  double aos_scale = MeasureMs([&] {
+    for (Particle &p : aos) {
+      p.mass *= 1.0001f;
+    }
+  });
+  double soa_scale = MeasureMs([&] {
+    for (float &mass : soa.get<6>()) {
+      mass *= 1.0001f;
+    }
+  });
+
+  std::printf("%zu particles, ms per pass\n", kSize);
+  std::printf("%-12s %12s %12s %8s\n", "pass", "vector<T>", "soa_vector",
+              "speedup");
+  std::printf("%-12s %12.2f %12.2f %7.1fx\n", "sum x", aos_sum, soa_sum,
+              aos_sum / soa_sum);
+  std::printf("%-12s %12.2f %12.2f %7.1fx\n", "scale mass", aos_scale,
+              soa_scale, aos_scale / soa_scale);
+  return 0;
+}
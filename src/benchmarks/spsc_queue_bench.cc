@@ -0,0 +1,122 @@
+// Copyright 2023 School21 @tandraym
+// Hand-off of 4M timestamped messages from a producer thread to a consumer
+// thread pinned to different CPUs (the same CPU when only one exists):
+// s21::spsc_queue against s21::queue guarded by a std::mutex. Reports
+// messages per second and the median and p99 latency from push to pop.
+// Both sides spin, yielding when they make no progress.
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "../s21_queue.h"
+#include "../s21_spsc_queue.h"
+#include "../s21_vector.h"
+
+namespace {
+constexpr std::int64_t kMessages = std::int64_t{1} << 22;
+constexpr std::size_t kCapacity = 1024;
+
+struct Message {
+  std::int64_t seq;
+  std::int64_t sent_ns;
+};
+
+std::int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void Pin(unsigned cpu) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu % std::max(1u, std::thread::hardware_concurrency()), &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+class MutexQueue {
+ public:
+  bool try_push(const Message &m) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.size() == kCapacity) {
+      return false;
+    }
+    queue_.push(m);
+    return true;
+  }
+
+  bool try_pop(Message &out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) {
+      return false;
+    }
+    out = queue_.front();
+    queue_.pop();
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  s21::queue<Message> queue_;
+};
+
+template <class Queue>
+void Run(const char *name, Queue &queue) {
+  s21::vector<std::int64_t> latencies(kMessages);
+  auto start = std::chrono::steady_clock::now();
+  std::thread producer([&] {
+    Pin(1);
+    for (std::int64_t i = 0; i < kMessages;) {
+      if (queue.try_push(Message{i, NowNs()})) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+  std::thread consumer([&] {
+    Pin(0);
+    Message m;
+    for (std::int64_t i = 0; i < kMessages;) {
+      if (queue.try_pop(m)) {
+        latencies[i++] = NowNs() - m.sent_ns;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+  producer.join();
+  consumer.join();
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  std::int64_t *first = latencies.data();
+  std::int64_t *last = first + kMessages;
+  std::nth_element(first, first + kMessages / 2, last);
+  std::int64_t median = first[kMessages / 2];
+  std::nth_element(first, first + kMessages * 99 / 100, last);
+  std::int64_t p99 = first[kMessages * 99 / 100];
+  std::printf("%-22s %8.2f M msg/s %12lld ns %12lld ns\n", name,
+              kMessages / seconds / 1e6, static_cast<long long>(median),
+              static_cast<long long>(p99));
+}
+}  // namespace
+
+int main() {
+  std::printf("%lld messages, capacity %zu, %u hardware threads\n",
+              static_cast<long long>(kMessages), kCapacity,
+              std::thread::hardware_concurrency());
+  std::printf("%-22s %16s %15s %15s\n", "queue", "throughput", "median",
+              "p99");
+  s21::spsc_queue<Message> spsc(kCapacity);
+  Run("s21::spsc_queue", spsc);
+  MutexQueue locked;
+  Run("mutex + s21::queue", locked);
+  return 0;
+}
@@ -0,0 +1,134 @@
+// Copyright 2023 School21 @tandraym
+// Middle insert/erase and push_back growth on 1M-element vectors: the
+// trivially relocatable (memmove) path against the element-wise path.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "../s21_vector.h"
+
+namespace {
+struct Record {
+  std::int64_t fields[4];
+};
+
+// Not trivially copyable, so it takes the element-wise move path...
+struct Handle {
+  std::unique_ptr<std::int64_t> owner;
+  std::int64_t fields[3];
+};
+
+// ...unless it opts in: moving a unique_ptr's bytes is a valid relocation.
+struct RelocatableHandle {
+  std::unique_ptr<std::int64_t> owner;
+  std::int64_t fields[3];
+};
+}  // namespace
+
+template <>
+struct s21::is_trivially_relocatable<RelocatableHandle> : std::true_type {};
+
+namespace {
+constexpr std::size_t kSize = 1000000;
+constexpr int kOps = 200;
+
+template <class Fn>
+double MeasureMs(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+template <class T>
+T Make(std::int64_t i) {
+  if constexpr (std::is_same_v<T, Record>) {
+    return T{{i, 0, 0, 0}};
+  } else {
+    return T{nullptr, {i, 0, 0}};
+  }
+}
+
+template <class Vector>
+void MiddleInsertErase(const char *name) {
+  using T = typename Vector::value_type;
+  Vector v;
+  v.reserve(kSize + kOps);
+  for (std::size_t i = 0; i < kSize; ++i) {
+    v.push_back(Make<T>(i));
+  }
+  double insert_ms = MeasureMs([&] {
+    for (int i = 0; i < kOps; ++i) {
+      v.insert(v.begin() + v.size() / 2, Make<T>(i));
+    }
+  });
+  double erase_ms = MeasureMs([&] {
+    for (int i = 0; i < kOps; ++i) {
+      v.erase(v.begin() + v.size() / 2);
+    }
+  });
+  std::printf("%-40s insert %8.1f us/op   erase %8.1f us/op\n", name,
+              insert_ms * 1000.0 / kOps, erase_ms * 1000.0 / kOps);
+}
+
+template <class Vector>
+void PushBackGrowth(const char *name) {
+  using T = typename Vector::value_type;
+  double ms = MeasureMs([&] {
+    Vector v;
+    for (std::size_t i = 0; i < kSize * 8; ++i) {
+      v.push_back(Make<T>(i));
+    }
+  });
+  std::printf("%-40s push_back x8M %8.1f ms\n", name, ms);
+}
+
+template <class Vector>
+void GrowthCost(const char *name) {
+  using T = typename Vector::value_type;
+  Vector v;
+  double ms = MeasureMs([&] {
+    for (std::size_t i = 0; i < kSize * 8; ++i) {
+      v.push_back(Make<T>(i));
+    }
+  });
+  std::printf("%-40s %8.1f ms  %3zu reallocations  %7.1f MB moved\n", name,
+              ms, v.stats().reallocations,
+              static_cast<double>(v.stats().bytes_moved) / (1 << 20));
+}
+}  // namespace
+
+int main() {
+  std::printf("1M x 32-byte elements, %d middle inserts then erases\n", kOps);
+  MiddleInsertErase<s21::vector<Record>>("s21::vector<Record>");
+  MiddleInsertErase<std::vector<Record>>("std::vector<Record>");
+  MiddleInsertErase<s21::vector<Handle>>("s21::vector<Handle> (element-wise)");
+  MiddleInsertErase<s21::vector<RelocatableHandle>>(
+      "s21::vector<RelocatableHandle> (memmove)");
+  MiddleInsertErase<std::vector<Handle>>("std::vector<Handle>");
+
+  std::printf("\npush_back growth from empty\n");
+  PushBackGrowth<s21::vector<Record>>("s21::vector<Record>");
+  PushBackGrowth<s21::vector<Record, s21::malloc_allocator<Record>>>(
+      "s21::vector<Record, malloc_allocator>");
+  PushBackGrowth<std::vector<Record>>("std::vector<Record>");
+  PushBackGrowth<s21::vector<Handle>>("s21::vector<Handle> (element-wise)");
+  PushBackGrowth<s21::vector<RelocatableHandle>>(
+      "s21::vector<RelocatableHandle> (memcpy)");
+
+  std::printf("\ngrowth policy / allocator cost, push_back x8M Record\n");
+  GrowthCost<s21::vector<Record>>("doubling, std::allocator");
+  GrowthCost<s21::vector<Record, std::allocator<Record>,
+                         s21::growth::one_and_half>>(
+      "one_and_half, std::allocator");
+  GrowthCost<s21::vector<Record, std::allocator<Record>,
+                         s21::growth::page_rounded<>>>(
+      "page_rounded, std::allocator");
+  GrowthCost<s21::vector<Record, s21::malloc_allocator<Record>>>(
+      "doubling, malloc_allocator");
+  GrowthCost<s21::vector<Record, s21::mmap_allocator<Record>>>(
+      "doubling, mmap_allocator (mremap)");
+  return 0;
+}
@@ -6,8 +6,13 @@
 #include <limits>
 
 namespace s21 {
-template <typename T, std::size_t N>
+// Align raises the alignment of the element storage above alignof(T), e.g.
+// to a cache line for arrays scanned with SIMD; see aligned_array.
+template <typename T, std::size_t N, std::size_t Align = alignof(T)>
 class array {
+  static_assert((Align & (Align - 1)) == 0, "alignment must be a power of 2");
+  static_assert(Align >= alignof(T), "alignment is weaker than alignof(T)");
+
  public:
   using value_type = T;
   using reference = T &;
@@ -55,21 +60,31 @@ class array {
 
   constexpr reference operator[](size_type pos) { return *(array_ + pos); }
 
+  constexpr const_reference operator[](size_type pos) const {
+    return *(array_ + pos);
+  }
+
   constexpr const_reference front() { return *array_; }
 
   constexpr const_reference back() { return *(array_ + size_ - 1); }
 
   constexpr iterator data() { return array_; }
 
+  constexpr const_iterator data() const { return array_; }
+
   constexpr iterator begin() { return array_; }
 
+  constexpr const_iterator begin() const { return array_; }
+
   constexpr iterator end() { return array_ + size_; }
 
-  constexpr bool empty() { return size_ == 0; }
+  constexpr const_iterator end() const { return array_ + size_; }
 
-  constexpr size_type size() { return size_; }
+  constexpr bool empty() const { return size_ == 0; }
 
-  constexpr size_type max_size() { return size(); }
+  constexpr size_type size() const { return size_; }
+
+  constexpr size_type max_size() const { return size(); }
 
   constexpr void swap(array &other) {
     std::swap(array_, other.array_);
@@ -84,8 +99,11 @@ class array {
 
  private:
   size_type size_ = N;
-  value_type array_[N];
+  alignas(Align) value_type array_[N];
 };
+
+template <typename T, std::size_t N, std::size_t Align = 64>
+using aligned_array = array<T, N, Align>;
 }  // namespace s21
 
 #endif  // CPP2_S21_CONTAINERS_SRC_S21_ARRAY_H_
@@ -0,0 +1,456 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_CHANNEL_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_CHANNEL_H_
+
+#if !defined(__cpp_impl_coroutine)
+#error "s21_channel.h needs C++20 coroutines; build with -std=c++20"
+#endif
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "s21_ring_buffer.h"
+
+// Coroutine channels for code that runs on one event loop. A coroutine
+// that sends into a full channel, or receives from an empty one, suspends
+// instead of blocking the thread; the loop runs other coroutines meanwhile
+// and resumes it once the operation has completed.
+//
+//   s21::task Producer(s21::channel<int> &ch) {
+//     for (int i = 0; i < 10; ++i) {
+//       co_await ch.send(i);
+//     }
+//     ch.close();
+//   }
+//
+//   s21::task Consumer(s21::channel<int> &ch) {
+//     while (std::optional<int> v = co_await ch.receive()) {
+//       ...
+//     }
+//   }
+//
+// s21::executor is the loop: a ring buffer of coroutines ready to run,
+// resumed in order by run(). Nothing here is thread-safe; a channel, its
+// executor and every coroutine using them belong to one thread.
+namespace s21 {
+class executor;
+
+// Coroutine type for code scheduled on an s21::executor. It does not start
+// until executor::spawn() queues it, and frees itself when it returns.
+// An exception escaping it is rethrown by the executor's run().
+class task {
+ public:
+  class promise_type {
+   public:
+    ~promise_type();
+
+    task get_return_object() noexcept {
+      return task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    std::suspend_never final_suspend() noexcept { return {}; }
+
+    void return_void() noexcept {}
+
+    void unhandled_exception() noexcept;
+
+   private:
+    friend class executor;
+
+    executor *owner_ = nullptr;
+    promise_type *prev_ = nullptr;
+    promise_type *next_ = nullptr;
+  };
+
+  task(task &&other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+
+  task(const task &) = delete;
+  task &operator=(const task &) = delete;
+  task &operator=(task &&) = delete;
+
+  // A task that was never spawned is destroyed without having run.
+  ~task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+ private:
+  friend class executor;
+
+  explicit task(std::coroutine_handle<promise_type> handle) noexcept
+      : handle_(handle) {}
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+// Single-threaded run loop. Spawned tasks and coroutines woken by a
+// channel are queued and resumed one at a time, in order.
+class executor {
+ public:
+  using size_type = std::size_t;
+
+  executor() = default;
+
+  executor(const executor &) = delete;
+  executor &operator=(const executor &) = delete;
+
+  // Destroys the tasks that have not finished, such as ones still waiting
+  // on a channel nobody will send to.
+  ~executor() {
+    ready_.clear();
+    while (live_ != nullptr) {
+      std::coroutine_handle<task::promise_type>::from_promise(*live_)
+          .destroy();
+    }
+  }
+
+  void spawn(task t) {
+    std::coroutine_handle<task::promise_type> handle =
+        std::exchange(t.handle_, {});
+    task::promise_type &promise = handle.promise();
+    promise.owner_ = this;
+    promise.next_ = live_;
+    if (live_ != nullptr) {
+      live_->prev_ = &promise;
+    }
+    live_ = &promise;
+    ++tasks_;
+    post(handle);
+  }
+
+  // Queues handle to be resumed by run().
+  void post(std::coroutine_handle<> handle) { ready_.push_back(handle); }
+
+  // Resumes the oldest ready coroutine. Returns false if none was ready.
+  bool run_one() {
+    if (ready_.empty()) {
+      return false;
+    }
+    std::coroutine_handle<> handle = ready_.front();
+    ready_.pop_front();
+    handle.resume();
+    if (error_) {
+      std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+    return true;
+  }
+
+  // Runs until no coroutine is ready and returns how many were resumed.
+  // Tasks left waiting on a channel stay suspended.
+  size_type run() {
+    size_type resumed = 0;
+    while (run_one()) {
+      ++resumed;
+    }
+    return resumed;
+  }
+
+  // Spawned tasks that have not finished yet.
+  size_type tasks() const noexcept { return tasks_; }
+
+  bool idle() const noexcept { return ready_.empty(); }
+
+ private:
+  friend class task::promise_type;
+
+  void Forget_(task::promise_type &promise) noexcept {
+    if (promise.prev_ != nullptr) {
+      promise.prev_->next_ = promise.next_;
+    } else {
+      live_ = promise.next_;
+    }
+    if (promise.next_ != nullptr) {
+      promise.next_->prev_ = promise.prev_;
+    }
+    --tasks_;
+  }
+
+  ring_buffer<std::coroutine_handle<>> ready_;
+  task::promise_type *live_ = nullptr;
+  size_type tasks_ = 0;
+  std::exception_ptr error_;
+};
+
+inline task::promise_type::~promise_type() {
+  if (owner_ != nullptr) {
+    owner_->Forget_(*this);
+  }
+}
+
+inline void task::promise_type::unhandled_exception() noexcept {
+  if (owner_ != nullptr && !owner_->error_) {
+    owner_->error_ = std::current_exception();
+  }
+}
+
+// FIFO channel between coroutines on one executor, buffered in an
+// s21::ring_buffer. A bounded channel holds at most capacity() values and
+// suspends senders beyond that; an unbounded one never suspends a sender.
+// Capacity 0 makes a rendezvous channel: each send waits for a receive.
+//
+// A completed operation hands its value over before the waiting coroutine
+// is woken: a receiver that finds senders waiting moves the oldest one's
+// value into the freed slot, and a send to a waiting receiver stores the
+// value in that receiver directly. A woken coroutine therefore never
+// retries, and waiters are served in the order they arrived.
+//
+// close() ends the stream: sends fail from then on, while receivers still
+// get what is buffered and then std::nullopt. cancel() closes and also
+// drops what is buffered.
+template <class T>
+class channel {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static constexpr size_type unbounded = std::numeric_limits<size_type>::max();
+
+  explicit channel(executor &ex, size_type capacity = unbounded)
+      : executor_(ex), capacity_(capacity) {}
+
+  channel(const channel &) = delete;
+  channel &operator=(const channel &) = delete;
+
+  // Coroutines still waiting here are left suspended; their executor
+  // destroys them.
+  ~channel() {
+    Detach_(senders_);
+    Detach_(receivers_);
+  }
+
+  // Returns false, leaving value untouched, if the channel is closed or
+  // full.
+  bool try_send(T &&value) {
+    if (closed_) {
+      return false;
+    }
+    if (ReceiveAwaiter_ *receiver = receivers_.PopFront()) {
+      receiver->result_.emplace(std::move(value));
+      Wake_(*receiver);
+      return true;
+    }
+    if (buffer_.size() >= capacity_) {
+      return false;
+    }
+    buffer_.push_back(std::move(value));
+    return true;
+  }
+
+  bool try_send(const T &value) {
+    T copy(value);
+    return try_send(std::move(copy));
+  }
+
+  // Returns std::nullopt if nothing is buffered and no sender is waiting.
+  std::optional<T> try_receive() {
+    std::optional<T> value;
+    if (!buffer_.empty()) {
+      value.emplace(std::move(buffer_.front()));
+      buffer_.pop_front();
+      if (SendAwaiter_ *sender = senders_.PopFront()) {
+        buffer_.push_back(std::move(sender->value_));
+        sender->result_ = true;
+        Wake_(*sender);
+      }
+    } else if (SendAwaiter_ *sender = senders_.PopFront()) {
+      value.emplace(std::move(sender->value_));
+      sender->result_ = true;
+      Wake_(*sender);
+    }
+    return value;
+  }
+
+  // co_await ch.send(v) completes with true once v is in the channel or
+  // with a receiver, or with false if the channel is or gets closed.
+  auto send(T value) { return SendAwaiter_(*this, std::move(value)); }
+
+  // co_await ch.receive() completes with the oldest value, or with
+  // std::nullopt once the channel is closed and drained.
+  auto receive() { return ReceiveAwaiter_(*this); }
+
+  // Fails every waiting sender and wakes every waiting receiver empty.
+  void close() {
+    closed_ = true;
+    while (SendAwaiter_ *sender = senders_.PopFront()) {
+      sender->result_ = false;
+      Wake_(*sender);
+    }
+    while (ReceiveAwaiter_ *receiver = receivers_.PopFront()) {
+      Wake_(*receiver);
+    }
+  }
+
+  // Closes the channel and discards the buffered values.
+  void cancel() {
+    close();
+    buffer_.clear();
+  }
+
+  bool closed() const noexcept { return closed_; }
+
+  size_type size() const noexcept { return buffer_.size(); }
+
+  bool empty() const noexcept { return buffer_.empty(); }
+
+  size_type capacity() const noexcept { return capacity_; }
+
+ private:
+  // A suspended operation, linked into its channel until completed.
+  template <class Awaiter>
+  struct WaitList_ {
+    void PushBack(Awaiter *waiter) noexcept {
+      waiter->prev_ = tail;
+      waiter->next_ = nullptr;
+      if (tail != nullptr) {
+        tail->next_ = waiter;
+      } else {
+        head = waiter;
+      }
+      tail = waiter;
+      waiter->linked_ = true;
+    }
+
+    Awaiter *PopFront() noexcept {
+      Awaiter *waiter = head;
+      if (waiter != nullptr) {
+        Erase(waiter);
+      }
+      return waiter;
+    }
+
+    void Erase(Awaiter *waiter) noexcept {
+      if (waiter->prev_ != nullptr) {
+        waiter->prev_->next_ = waiter->next_;
+      } else {
+        head = waiter->next_;
+      }
+      if (waiter->next_ != nullptr) {
+        waiter->next_->prev_ = waiter->prev_;
+      } else {
+        tail = waiter->prev_;
+      }
+      waiter->linked_ = false;
+    }
+
+    Awaiter *head = nullptr;
+    Awaiter *tail = nullptr;
+  };
+
+  // Links and unlinks itself; a coroutine destroyed while suspended takes
+  // its awaiter out of the channel with it.
+  template <class Self>
+  class Waiter_ {
+   public:
+    Waiter_(const Waiter_ &) = delete;
+    Waiter_ &operator=(const Waiter_ &) = delete;
+
+   protected:
+    explicit Waiter_(channel &ch) noexcept : channel_(&ch) {}
+
+    ~Waiter_() {
+      if (linked_ && channel_ != nullptr) {
+        channel_->template List_<Self>().Erase(static_cast<Self *>(this));
+      }
+    }
+
+    void Suspend_(std::coroutine_handle<> handle) noexcept {
+      handle_ = handle;
+      channel_->template List_<Self>().PushBack(static_cast<Self *>(this));
+    }
+
+   private:
+    friend class channel;
+    friend struct WaitList_<Self>;
+
+    channel *channel_;
+    std::coroutine_handle<> handle_;
+    Self *prev_ = nullptr;
+    Self *next_ = nullptr;
+    bool linked_ = false;
+  };
+
+  class SendAwaiter_ : public Waiter_<SendAwaiter_> {
+   public:
+    SendAwaiter_(channel &ch, T &&value)
+        : Waiter_<SendAwaiter_>(ch), value_(std::move(value)) {}
+
+    bool await_ready() {
+      channel &ch = *this->channel_;
+      result_ = ch.try_send(std::move(value_));
+      return result_ || ch.closed_;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept {
+      this->Suspend_(handle);
+    }
+
+    bool await_resume() const noexcept { return result_; }
+
+   private:
+    friend class channel;
+
+    T value_;
+    bool result_ = false;
+  };
+
+  class ReceiveAwaiter_ : public Waiter_<ReceiveAwaiter_> {
+   public:
+    explicit ReceiveAwaiter_(channel &ch) : Waiter_<ReceiveAwaiter_>(ch) {}
+
+    bool await_ready() {
+      channel &ch = *this->channel_;
+      result_ = ch.try_receive();
+      return result_.has_value() || ch.closed_;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept {
+      this->Suspend_(handle);
+    }
+
+    std::optional<T> await_resume() { return std::move(result_); }
+
+   private:
+    friend class channel;
+
+    std::optional<T> result_;
+  };
+
+  template <class Awaiter>
+  WaitList_<Awaiter> &List_() noexcept {
+    if constexpr (std::is_same_v<Awaiter, SendAwaiter_>) {
+      return senders_;
+    } else {
+      return receivers_;
+    }
+  }
+
+  template <class Awaiter>
+  void Wake_(Awaiter &waiter) {
+    executor_.post(waiter.handle_);
+  }
+
+  template <class Awaiter>
+  static void Detach_(WaitList_<Awaiter> &list) noexcept {
+    while (Awaiter *waiter = list.PopFront()) {
+      waiter->channel_ = nullptr;
+    }
+  }
+
+  executor &executor_;
+  size_type capacity_;
+  ring_buffer<T> buffer_;
+  WaitList_<SendAwaiter_> senders_;
+  WaitList_<ReceiveAwaiter_> receivers_;
+  bool closed_ = false;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_CHANNEL_H_
@@ -0,0 +1,162 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_CONCURRENT_QUEUE_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_CONCURRENT_QUEUE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+#include "s21_deque.h"
+#include "s21_queue.h"
+
+namespace s21 {
+// Unbounded FIFO shared by any number of threads: an s21::queue behind one
+// mutex, with a condition variable for consumers waiting on an empty queue.
+// pop_batch() moves up to max_n elements out under a single lock
+// acquisition, so a consumer that drains in batches pays for the mutex once
+// per batch rather than once per element.
+//
+// close() ends the stream: later pushes are refused and return false, while
+// consumers still receive what was queued before and then get false (or 0
+// from pop_batch) instead of blocking.
+template <typename T, class Container = s21::deque<T>>
+class concurrent_queue {
+ public:
+  using container_type = Container;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+
+  concurrent_queue() = default;
+
+  concurrent_queue(const concurrent_queue &) = delete;
+  concurrent_queue &operator=(const concurrent_queue &) = delete;
+
+  // Each returns false, and leaves the queue unchanged, once closed.
+  bool push(const_reference value) { return emplace(value); }
+
+  bool push(value_type &&value) { return emplace(std::move(value)); }
+
+  template <typename... Args>
+  bool emplace(Args &&...args) {
+    bool wake;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closed_) {
+        return false;
+      }
+      queue_.emplace(std::forward<Args>(args)...);
+      wake = waiting_ != 0;
+    }
+    // Consumers that find the queue non-empty never sleep, so a push only
+    // pays for a notify when someone is actually waiting.
+    if (wake) {
+      not_empty_.notify_one();
+    }
+    return true;
+  }
+
+  // Moves the oldest element into out; returns false if the queue is empty.
+  bool try_pop(reference out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) {
+      return false;
+    }
+    PopInto_(out);
+    return true;
+  }
+
+  // Blocks until an element arrives; returns false once the queue is closed
+  // and drained.
+  bool wait_pop(reference out) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    WaitReady_(lock);
+    if (queue_.empty()) {
+      return false;
+    }
+    PopInto_(out);
+    return true;
+  }
+
+  // As wait_pop, but also returns false when timeout passes first.
+  template <class Rep, class Period>
+  bool wait_pop_for(reference out,
+                    const std::chrono::duration<Rep, Period> &timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++waiting_;
+    not_empty_.wait_for(lock, timeout,
+                        [this] { return !queue_.empty() || closed_; });
+    --waiting_;
+    if (queue_.empty()) {
+      return false;
+    }
+    PopInto_(out);
+    return true;
+  }
+
+  // Blocks until the queue is non-empty, then moves up to max_n of the
+  // oldest elements into out[0, n) under one lock; returns n, which is 0
+  // only once the queue is closed and drained (or when max_n is 0).
+  size_type pop_batch(T *out, size_type max_n) {
+    if (max_n == 0) {
+      return 0;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    WaitReady_(lock);
+    size_type n = 0;
+    while (n < max_n && !queue_.empty()) {
+      PopInto_(out[n++]);
+    }
+    return n;
+  }
+
+  // Refuses further pushes and wakes every waiting consumer.
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+    }
+    not_empty_.notify_all();
+  }
+
+  bool closed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+  }
+
+  // Snapshots; another thread may change the queue right after.
+  bool empty() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.empty();
+  }
+
+  size_type size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+  }
+
+ private:
+  // Waits, holding lock, until there is an element or the queue is closed.
+  void WaitReady_(std::unique_lock<std::mutex> &lock) {
+    ++waiting_;
+    not_empty_.wait(lock, [this] { return !queue_.empty() || closed_; });
+    --waiting_;
+  }
+
+  void PopInto_(reference out) {
+    out = std::move(queue_.front());
+    queue_.pop();
+  }
+
+  mutable std::mutex mutex_;
+  std::condition_variable not_empty_;
+  queue<T, Container> queue_;
+  size_type waiting_ = 0;
+  bool closed_ = false;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_CONCURRENT_QUEUE_H_
@@ -0,0 +1,331 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_CONCURRENT_STACK_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_CONCURRENT_STACK_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#include "s21_memory.h"
+#include "s21_vector.h"
+
+namespace s21 {
+namespace internal {
+// Hazard pointers (Michael, 2004), one per thread. Before dereferencing a
+// shared node a thread publishes its address in its hazard slot and checks
+// that the node is still reachable; a retired node is freed only by a scan
+// that finds it in no slot. Retired nodes wait in a per-thread list, which
+// is scanned once it outgrows twice the number of slots, so each free
+// costs O(1) amortized. Lists left behind by exiting threads are adopted
+// by the next scan anywhere, and whatever remains at exit is freed then.
+class HazardPointers {
+ public:
+  using Deleter = void (*)(void *);
+
+  // The calling thread's slot; it stays published until cleared.
+  static void Protect(void *p) noexcept {
+    Local_().record->hazard.store(p, std::memory_order_seq_cst);
+  }
+
+  static void Clear() noexcept {
+    Local_().record->hazard.store(nullptr, std::memory_order_release);
+  }
+
+  // Frees p with deleter once no thread holds it in its slot.
+  static void Retire(void *p, Deleter deleter) {
+    Local &local = Local_();
+    local.retired.push_back(Retired_{p, deleter});
+    if (local.retired.size() >=
+        2 * records_.load(std::memory_order_relaxed) + 16) {
+      Scan_(local.retired);
+    }
+  }
+
+ private:
+  struct Retired_ {
+    void *pointer;
+    Deleter deleter;
+  };
+
+  struct alignas(cache_line_size) Record_ {
+    std::atomic<void *> hazard{nullptr};
+    std::atomic<bool> active{true};
+    Record_ *next = nullptr;
+  };
+
+  // The thread's slot and retired list; the slot returns to the pool and
+  // the unfreed nodes to the orphans when the thread exits.
+  struct Local {
+    Local() : record(Acquire_()) {}
+
+    ~Local() {
+      record->hazard.store(nullptr, std::memory_order_release);
+      Scan_(retired);
+      Orphans_ &orphans = Orphans();
+      std::lock_guard<std::mutex> lock(orphans.mutex);
+      for (const Retired_ &node : retired) {
+        orphans.nodes.push_back(node);
+      }
+      record->active.store(false, std::memory_order_release);
+    }
+
+    Record_ *record;
+    s21::vector<Retired_> retired;
+  };
+
+  struct Orphans_ {
+    // Runs after every thread, the main one included, has exited, so
+    // nothing can hold a hazard any more.
+    ~Orphans_() {
+      for (const Retired_ &node : nodes) {
+        node.deleter(node.pointer);
+      }
+    }
+
+    std::mutex mutex;
+    s21::vector<Retired_> nodes;
+  };
+
+  static Local &Local_() {
+    thread_local Local local;
+    return local;
+  }
+
+  static Orphans_ &Orphans() {
+    static Orphans_ orphans;
+    return orphans;
+  }
+
+  // Reuses the slot of an exited thread, or links a new one; slots are
+  // never freed, so readers may walk the list without protection.
+  static Record_ *Acquire_() {
+    Orphans();  // constructed first, so destroyed after every Local
+    for (Record_ *r = head_.load(std::memory_order_acquire); r != nullptr;
+         r = r->next) {
+      bool idle = false;
+      if (!r->active.load(std::memory_order_relaxed) &&
+          r->active.compare_exchange_strong(idle, true,
+                                            std::memory_order_acquire)) {
+        return r;
+      }
+    }
+    auto *record = new Record_;
+    record->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(record->next, record,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+    records_.fetch_add(1, std::memory_order_relaxed);
+    return record;
+  }
+
+  static void Scan_(s21::vector<Retired_> &retired) {
+    Orphans_ &orphans = Orphans();
+    std::unique_lock<std::mutex> lock(orphans.mutex, std::try_to_lock);
+    if (lock.owns_lock()) {
+      for (const Retired_ &node : orphans.nodes) {
+        retired.push_back(node);
+      }
+      orphans.nodes.clear();
+      lock.unlock();
+    }
+    s21::vector<void *> hazards;
+    for (Record_ *r = head_.load(std::memory_order_acquire); r != nullptr;
+         r = r->next) {
+      if (void *p = r->hazard.load(std::memory_order_seq_cst)) {
+        hazards.push_back(p);
+      }
+    }
+    std::sort(hazards.begin(), hazards.end());
+    s21::vector<Retired_> kept;
+    for (const Retired_ &node : retired) {
+      if (std::binary_search(hazards.begin(), hazards.end(), node.pointer)) {
+        kept.push_back(node);
+      } else {
+        node.deleter(node.pointer);
+      }
+    }
+    retired.swap(kept);
+  }
+
+  inline static std::atomic<Record_ *> head_{nullptr};
+  inline static std::atomic<std::size_t> records_{0};
+};
+}  // namespace internal
+
+// Lock-free LIFO for any number of threads (Treiber's stack). A popping
+// thread holds its hazard pointer on the head while it reads head->next
+// and swings the head past it; popped nodes are retired through
+// s21::internal::HazardPointers. That also rules out the ABA problem
+// without tagging the head: a node is never pushed twice, and its address
+// cannot come back as a new node while any thread still holds it, so a
+// pop's CAS succeeds only if its node is still the top. A push never
+// dereferences the head it read, so a head that changed and changed back
+// under it is harmless.
+//
+// When a CAS on the head fails, the thread backs off to an elimination
+// array: a push parks its node in a random slot for a short spin, and a
+// pop that finds a parked node takes it directly. A push and a pop that
+// meet this way cancel out without touching the head, which is what lets
+// the stack scale when many threads hammer it at once.
+template <class T>
+class concurrent_stack {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  concurrent_stack() = default;
+
+  concurrent_stack(const concurrent_stack &) = delete;
+  concurrent_stack &operator=(const concurrent_stack &) = delete;
+
+  // Destroys the remaining elements; no other thread may still use the
+  // stack.
+  ~concurrent_stack() {
+    Node_ *node = head_.load(std::memory_order_acquire);
+    while (node != nullptr) {
+      delete std::exchange(node, node->next);
+    }
+  }
+
+  void push(const T &value) { emplace(value); }
+
+  void push(T &&value) { emplace(std::move(value)); }
+
+  template <typename... Args>
+  void emplace(Args &&...args) {
+    auto *node = new Node_{T(std::forward<Args>(args)...), nullptr};
+    node->next = head_.load(std::memory_order_relaxed);
+    while (true) {
+      if (head_.compare_exchange_weak(node->next, node,
+                                      std::memory_order_release,
+                                      std::memory_order_relaxed)) {
+        return;
+      }
+      if (OfferToPop_(node)) {
+        return;
+      }
+      node->next = head_.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Moves the top element into out; returns false if the stack is empty.
+  bool try_pop(T &out) {
+    while (true) {
+      Node_ *node = head_.load(std::memory_order_acquire);
+      if (node == nullptr) {
+        return false;
+      }
+      internal::HazardPointers::Protect(node);
+      if (head_.load(std::memory_order_acquire) != node) {
+        continue;
+      }
+      Node_ *expected = node;
+      if (head_.compare_exchange_strong(expected, node->next,
+                                        std::memory_order_acquire,
+                                        std::memory_order_relaxed)) {
+        internal::HazardPointers::Clear();
+        out = std::move(node->value);
+        Retire_(node);
+        return true;
+      }
+      internal::HazardPointers::Clear();
+      if (Node_ *parked = TakeFromPush_()) {
+        out = std::move(parked->value);
+        delete parked;
+        return true;
+      }
+    }
+  }
+
+  // Detaches every element with one exchange of the head and returns them
+  // top first.
+  s21::vector<T> pop_all() {
+    Node_ *head = head_.exchange(nullptr, std::memory_order_acquire);
+    s21::vector<T> values;
+    // Poppers that read the old head may still be looking at these nodes,
+    // so they are retired rather than deleted.
+    for (Node_ *node = head; node != nullptr;) {
+      values.push_back(std::move(node->value));
+      Retire_(std::exchange(node, node->next));
+    }
+    return values;
+  }
+
+  // A snapshot; another thread may push or pop right after.
+  bool empty() const noexcept {
+    return head_.load(std::memory_order_acquire) == nullptr;
+  }
+
+ private:
+  struct Node_ {
+    T value;
+    Node_ *next;
+  };
+
+  struct alignas(cache_line_size) Slot_ {
+    std::atomic<Node_ *> parked{nullptr};
+  };
+
+  static constexpr size_type kSlots_ = 8;
+  static constexpr int kParkSpins_ = 128;
+
+  static void Retire_(Node_ *node) {
+    internal::HazardPointers::Retire(
+        node, [](void *p) { delete static_cast<Node_ *>(p); });
+  }
+
+  Slot_ &RandomSlot_() noexcept {
+    thread_local std::uint32_t x =
+        static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&x)) | 1;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return slots_[x % kSlots_];
+  }
+
+  // Parks node in a free slot for a short spin. Returns true if a pop took
+  // it, false if it was withdrawn (or no slot was free).
+  bool OfferToPop_(Node_ *node) {
+    Slot_ &slot = RandomSlot_();
+    Node_ *empty = nullptr;
+    if (!slot.parked.compare_exchange_strong(empty, node,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+      return false;
+    }
+    for (int i = 0; i < kParkSpins_; ++i) {
+      if (slot.parked.load(std::memory_order_relaxed) != node) {
+        return true;
+      }
+      internal::CpuRelax();
+    }
+    Node_ *expected = node;
+    // Failing means a pop emptied the slot, and so owns node now.
+    return !slot.parked.compare_exchange_strong(expected, nullptr,
+                                                std::memory_order_relaxed);
+  }
+
+  // Takes a node a push has parked, or returns nullptr. The node was never
+  // on the stack, so the caller may delete it directly.
+  Node_ *TakeFromPush_() {
+    Slot_ &slot = RandomSlot_();
+    Node_ *node = slot.parked.load(std::memory_order_relaxed);
+    if (node != nullptr &&
+        slot.parked.compare_exchange_strong(node, nullptr,
+                                            std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+      return node;
+    }
+    return nullptr;
+  }
+
+  alignas(cache_line_size) std::atomic<Node_ *> head_{nullptr};
+  Slot_ slots_[kSlots_];
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_CONCURRENT_STACK_H_
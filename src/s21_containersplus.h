@@ -3,6 +3,27 @@
 #define CPP2_S21_CONTAINERS_SRC_S21_CONTAINERSPLUS_H_
 
 #include "s21_array.h"
+#if defined(__cpp_impl_coroutine)
+#include "s21_channel.h"
+#endif
+#include "s21_concurrent_queue.h"
+#include "s21_concurrent_stack.h"
+#include "s21_deque.h"
+#include "s21_dynamic_bitset.h"
+#include "s21_epoch.h"
+#include "s21_memory.h"
+#include "s21_mmap_vector.h"
+#include "s21_mpmc_queue.h"
 #include "s21_multiset.h"
+#include "s21_parallel.h"
+#include "s21_priority_queue.h"
+#include "s21_ring_buffer.h"
+#include "s21_simd.h"
+#include "s21_small_vector.h"
+#include "s21_snapshot.h"
+#include "s21_soa_vector.h"
+#include "s21_spsc_queue.h"
+#include "s21_task_pool.h"
+#include "s21_ws_deque.h"
 
 #endif  // CPP2_S21_CONTAINERS_SRC_S21_CONTAINERSPLUS_H_
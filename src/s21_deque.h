@@ -0,0 +1,435 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_DEQUE_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_DEQUE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+// Double-ended queue of fixed-size blocks of block_size elements, reached
+// through a map of block pointers. Pushing or popping at either end is
+// amortized O(1) and never moves an element, so references to elements stay
+// valid until the element is erased; iterators are invalidated by pushes,
+// as for std::deque. Element i lives in block (start + i) / block_size, and
+// block_size is a power of two, so indexing is a shift and a mask.
+//
+// Blocks emptied by pops stay in the map and are reused by later pushes, so
+// a queue that stays under a steady size stops allocating; shrink_to_fit()
+// releases them.
+template <class T, class Allocator = std::allocator<T>>
+class deque {
+  using AllocTraits_ = std::allocator_traits<Allocator>;
+  using MapAllocator_ = typename AllocTraits_::template rebind_alloc<T *>;
+  using MapTraits_ = std::allocator_traits<MapAllocator_>;
+
+  template <bool kConst>
+  class Iterator_;
+
+ public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = Iterator_<false>;
+  using const_iterator = Iterator_<true>;
+  using size_type = std::size_t;
+
+  static_assert(std::is_same_v<typename AllocTraits_::value_type, T>,
+                "Allocator::value_type must be T");
+
+  // Elements per block: the largest power of two that fits in 4 KiB, but
+  // at least 16.
+  static constexpr size_type block_size = [] {
+    size_type n = 16;
+    while (n * 2 * sizeof(T) <= 4096) {
+      n *= 2;
+    }
+    return n;
+  }();
+
+  deque() noexcept(noexcept(Allocator())) : alloc_() {}
+
+  explicit deque(const Allocator &alloc) noexcept : alloc_(alloc) {}
+
+  explicit deque(size_type n, const Allocator &alloc = Allocator())
+      : alloc_(alloc) {
+    for (size_type i = 0; i < n; ++i) {
+      emplace_back();
+    }
+  }
+
+  deque(std::initializer_list<value_type> const &items,
+        const Allocator &alloc = Allocator())
+      : alloc_(alloc) {
+    for (const value_type &item : items) {
+      push_back(item);
+    }
+  }
+
+  deque(const deque &other)
+      : alloc_(AllocTraits_::select_on_container_copy_construction(
+            other.alloc_)) {
+    for (const value_type &item : other) {
+      push_back(item);
+    }
+  }
+
+  deque(deque &&other) noexcept : alloc_(std::move(other.alloc_)) {
+    StealFrom_(other);
+  }
+
+  ~deque() { Release_(); }
+
+  deque &operator=(const deque &other) {
+    if (this == &other) {
+      return *this;
+    }
+    if constexpr (AllocTraits_::propagate_on_container_copy_assignment::
+                      value) {
+      if (alloc_ != other.alloc_) {
+        Release_();
+      }
+      alloc_ = other.alloc_;
+    }
+    clear();
+    for (const value_type &item : other) {
+      push_back(item);
+    }
+    return *this;
+  }
+
+  deque &operator=(deque &&other) noexcept(
+      AllocTraits_::propagate_on_container_move_assignment::value ||
+      AllocTraits_::is_always_equal::value) {
+    if (this == &other) {
+      return *this;
+    }
+    if constexpr (!AllocTraits_::propagate_on_container_move_assignment::
+                      value &&
+                  !AllocTraits_::is_always_equal::value) {
+      if (alloc_ != other.alloc_) {
+        // Blocks from other's allocator cannot be adopted, so the elements
+        // are moved into blocks of our own.
+        clear();
+        for (value_type &item : other) {
+          emplace_back(std::move(item));
+        }
+        other.clear();
+        return *this;
+      }
+    }
+    Release_();
+    if constexpr (AllocTraits_::propagate_on_container_move_assignment::
+                      value) {
+      alloc_ = std::move(other.alloc_);
+    }
+    StealFrom_(other);
+    return *this;
+  }
+
+  allocator_type get_allocator() const noexcept { return alloc_; }
+
+  reference at(size_type pos) {
+    if (pos >= size_) {
+      throw std::out_of_range("Out of bound exeption");
+    }
+    return (*this)[pos];
+  }
+
+  const_reference at(size_type pos) const {
+    return const_cast<deque *>(this)->at(pos);
+  }
+
+  reference operator[](size_type pos) { return *Slot_(start_ + pos); }
+
+  const_reference operator[](size_type pos) const {
+    return *Slot_(start_ + pos);
+  }
+
+  reference front() { return *Slot_(start_); }
+
+  const_reference front() const { return *Slot_(start_); }
+
+  reference back() { return *Slot_(start_ + size_ - 1); }
+
+  const_reference back() const { return *Slot_(start_ + size_ - 1); }
+
+  iterator begin() noexcept { return iterator(this, 0); }
+
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+  iterator end() noexcept { return iterator(this, size_); }
+
+  const_iterator end() const noexcept { return const_iterator(this, size_); }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type max_size() const noexcept {
+    return std::min<size_type>(AllocTraits_::max_size(alloc_),
+                               std::numeric_limits<std::ptrdiff_t>::max() /
+                                   sizeof(value_type)) /
+           2;
+  }
+
+  void clear() noexcept {
+    for (size_type i = 0; i < size_; ++i) {
+      AllocTraits_::destroy(alloc_, Slot_(start_ + i));
+    }
+    size_ = 0;
+  }
+
+  void push_back(const_reference value) { emplace_back(value); }
+
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    if (start_ + size_ == map_size_ * block_size) {
+      MakeRoom_(false);
+    }
+    T *slot = BlockFor_(start_ + size_) + (start_ + size_) % block_size;
+    AllocTraits_::construct(alloc_, slot, std::forward<Args>(args)...);
+    ++size_;
+    return *slot;
+  }
+
+  void push_front(const_reference value) { emplace_front(value); }
+
+  void push_front(value_type &&value) { emplace_front(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_front(Args &&...args) {
+    if (start_ == 0) {
+      MakeRoom_(true);
+    }
+    T *slot = BlockFor_(start_ - 1) + (start_ - 1) % block_size;
+    AllocTraits_::construct(alloc_, slot, std::forward<Args>(args)...);
+    --start_;
+    ++size_;
+    return *slot;
+  }
+
+  void pop_back() {
+    AllocTraits_::destroy(alloc_, Slot_(start_ + size_ - 1));
+    --size_;
+  }
+
+  void pop_front() {
+    AllocTraits_::destroy(alloc_, Slot_(start_));
+    ++start_;
+    --size_;
+  }
+
+  // Frees the blocks that hold no elements.
+  void shrink_to_fit() noexcept {
+    size_type first = start_ / block_size;
+    size_type last = size_ == 0 ? first : (start_ + size_ - 1) / block_size + 1;
+    for (size_type i = 0; i < map_size_; ++i) {
+      if ((i < first || i >= last) && map_[i] != nullptr) {
+        AllocTraits_::deallocate(alloc_, map_[i], block_size);
+        map_[i] = nullptr;
+      }
+    }
+  }
+
+  void swap(deque &other) noexcept {
+    if constexpr (AllocTraits_::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
+    std::swap(map_, other.map_);
+    std::swap(map_size_, other.map_size_);
+    std::swap(start_, other.start_);
+    std::swap(size_, other.size_);
+  }
+
+ private:
+  template <bool kConst>
+  class Iterator_ {
+    using Owner_ = std::conditional_t<kConst, const deque, deque>;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<kConst, const T &, T &>;
+    using pointer = std::conditional_t<kConst, const T *, T *>;
+
+    Iterator_() noexcept = default;
+
+    template <bool kOther, class = std::enable_if_t<kConst && !kOther>>
+    Iterator_(const Iterator_<kOther> &other) noexcept
+        : owner_(other.owner_), index_(other.index_) {}
+
+    reference operator*() const { return (*owner_)[index_]; }
+
+    pointer operator->() const { return &(*owner_)[index_]; }
+
+    reference operator[](difference_type n) const {
+      return (*owner_)[index_ + n];
+    }
+
+    Iterator_ &operator++() {
+      ++index_;
+      return *this;
+    }
+
+    Iterator_ operator++(int) {
+      Iterator_ old = *this;
+      ++index_;
+      return old;
+    }
+
+    Iterator_ &operator--() {
+      --index_;
+      return *this;
+    }
+
+    Iterator_ operator--(int) {
+      Iterator_ old = *this;
+      --index_;
+      return old;
+    }
+
+    Iterator_ &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+
+    Iterator_ &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+
+    Iterator_ operator+(difference_type n) const {
+      return Iterator_(owner_, index_ + n);
+    }
+
+    Iterator_ operator-(difference_type n) const {
+      return Iterator_(owner_, index_ - n);
+    }
+
+    difference_type operator-(const Iterator_ &other) const {
+      return static_cast<difference_type>(index_) -
+             static_cast<difference_type>(other.index_);
+    }
+
+    bool operator==(const Iterator_ &other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const Iterator_ &other) const {
+      return index_ != other.index_;
+    }
+    bool operator<(const Iterator_ &other) const {
+      return index_ < other.index_;
+    }
+    bool operator>(const Iterator_ &other) const {
+      return index_ > other.index_;
+    }
+    bool operator<=(const Iterator_ &other) const {
+      return index_ <= other.index_;
+    }
+    bool operator>=(const Iterator_ &other) const {
+      return index_ >= other.index_;
+    }
+
+   private:
+    friend class deque;
+    template <bool>
+    friend class Iterator_;
+
+    Iterator_(Owner_ *owner, size_type index) noexcept
+        : owner_(owner), index_(index) {}
+
+    Owner_ *owner_ = nullptr;
+    size_type index_ = 0;
+  };
+
+  // Address of the element at absolute position pos; its block exists.
+  T *Slot_(size_type pos) const noexcept {
+    return map_[pos / block_size] + pos % block_size;
+  }
+
+  // Block holding absolute position pos, allocated or reused on demand.
+  T *BlockFor_(size_type pos) {
+    T *&block = map_[pos / block_size];
+    if (block == nullptr) {
+      block = AllocTraits_::allocate(alloc_, block_size);
+    }
+    return block;
+  }
+
+  // Makes a free map slot before the first block (at_front) or after the
+  // last one. If at most half of the map is in use the block pointers are
+  // rotated to centre the used ones, keeping the spare blocks; otherwise
+  // the map doubles. Only pointers move, never elements.
+  void MakeRoom_(bool at_front) {
+    size_type first = start_ / block_size;
+    size_type last = size_ == 0 ? first : (start_ + size_ - 1) / block_size + 1;
+    size_type needed = last - first + 1;
+    if (needed > max_size() / block_size) {
+      throw std::length_error("deque size exceeds max_size");
+    }
+    size_type new_size = 2 * needed <= map_size_
+                             ? map_size_
+                             : std::max<size_type>(8, 2 * needed);
+    size_type new_first = (new_size - needed) / 2 + (at_front ? 1 : 0);
+    size_type shift = new_size + new_first - first % new_size;
+    if (new_size == map_size_) {
+      std::rotate(map_, map_ + (map_size_ - shift % map_size_) % map_size_,
+                  map_ + map_size_);
+    } else {
+      MapAllocator_ map_alloc(alloc_);
+      T **map = MapTraits_::allocate(map_alloc, new_size);
+      std::fill(map, map + new_size, nullptr);
+      for (size_type i = 0; i < map_size_; ++i) {
+        map[(i + shift) % new_size] = map_[i];
+      }
+      if (map_ != nullptr) {
+        MapTraits_::deallocate(map_alloc, map_, map_size_);
+      }
+      map_ = map;
+      map_size_ = new_size;
+    }
+    start_ = new_first * block_size + start_ % block_size;
+  }
+
+  void Release_() noexcept {
+    clear();
+    if (map_ != nullptr) {
+      for (size_type i = 0; i < map_size_; ++i) {
+        if (map_[i] != nullptr) {
+          AllocTraits_::deallocate(alloc_, map_[i], block_size);
+        }
+      }
+      MapAllocator_ map_alloc(alloc_);
+      MapTraits_::deallocate(map_alloc, map_, map_size_);
+    }
+    map_ = nullptr;
+    map_size_ = start_ = 0;
+  }
+
+  void StealFrom_(deque &other) noexcept {
+    map_ = std::exchange(other.map_, nullptr);
+    map_size_ = std::exchange(other.map_size_, 0);
+    start_ = std::exchange(other.start_, 0);
+    size_ = std::exchange(other.size_, 0);
+  }
+
+  T **map_ = nullptr;
+  size_type map_size_ = 0;
+  size_type start_ = 0;
+  size_type size_ = 0;
+  allocator_type alloc_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_DEQUE_H_
@@ -0,0 +1,310 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_DYNAMIC_BITSET_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_DYNAMIC_BITSET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_simd.h"
+#include "s21_vector.h"
+
+namespace s21 {
+// Growable sequence of bits packed 64 to a std::uint64_t block, held in a
+// cache-line aligned s21::vector. Bit i is bit i % 64 of block i / 64.
+// Bits past size() in the last block are always zero, so count(), the
+// find functions and comparisons work on whole blocks. count() and the
+// bulk &=, |=, ^= and and_not() run through the s21::simd bit kernels.
+class dynamic_bitset {
+ public:
+  using block_type = std::uint64_t;
+  using size_type = std::size_t;
+
+  static constexpr size_type bits_per_block = 64;
+  static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+  // Proxy for one bit.
+  class reference {
+   public:
+    operator bool() const noexcept { return (*block_ & mask_) != 0; }
+
+    bool operator~() const noexcept { return !bool(*this); }
+
+    reference &operator=(bool value) noexcept {
+      *block_ = value ? *block_ | mask_ : *block_ & ~mask_;
+      return *this;
+    }
+
+    reference &operator=(const reference &other) noexcept {
+      return *this = bool(other);
+    }
+
+    reference &flip() noexcept {
+      *block_ ^= mask_;
+      return *this;
+    }
+
+   private:
+    friend class dynamic_bitset;
+
+    reference(block_type *block, block_type mask) noexcept
+        : block_(block), mask_(mask) {}
+
+    block_type *block_;
+    block_type mask_;
+  };
+
+  dynamic_bitset() noexcept = default;
+
+  explicit dynamic_bitset(size_type size, bool value = false) {
+    resize(size, value);
+  }
+
+  bool test(size_type pos) const {
+    CheckPos_(pos);
+    return (*this)[pos];
+  }
+
+  reference operator[](size_type pos) {
+    return reference(&blocks_[pos / bits_per_block], Mask_(pos));
+  }
+
+  bool operator[](size_type pos) const {
+    return (blocks_[pos / bits_per_block] & Mask_(pos)) != 0;
+  }
+
+  const block_type *data() const noexcept { return blocks_.data(); }
+
+  size_type num_blocks() const noexcept { return blocks_.size(); }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type capacity() const noexcept {
+    return blocks_.capacity() * bits_per_block;
+  }
+
+  void reserve(size_type bits) { blocks_.reserve(BlocksFor_(bits)); }
+
+  void shrink_to_fit() { blocks_.shrink_to_fit(); }
+
+  void clear() noexcept {
+    blocks_.clear();
+    size_ = 0;
+  }
+
+  void resize(size_type size, bool value = false) {
+    if (size > size_ && value) {
+      if (size_ % bits_per_block != 0) {
+        blocks_.back() |= ~block_type{0} << size_ % bits_per_block;
+      }
+      blocks_.resize(BlocksFor_(size), ~block_type{0});
+    } else {
+      blocks_.resize(BlocksFor_(size), 0);
+    }
+    size_ = size;
+    ClearTail_();
+  }
+
+  // Appends one bit; a new block is started every 64 bits, so the cost is
+  // one OR into the last block.
+  void push_back(bool value) {
+    size_type offset = size_ % bits_per_block;
+    if (offset == 0) {
+      blocks_.push_back(block_type{value});
+    } else {
+      blocks_.back() |= block_type{value} << offset;
+    }
+    ++size_;
+  }
+
+  // Appends the low count bits of bits, least significant first. Throws
+  // std::invalid_argument if count exceeds bits_per_block.
+  void append(block_type bits, size_type count = bits_per_block) {
+    if (count > bits_per_block) {
+      throw std::invalid_argument("dynamic_bitset append count too large");
+    }
+    if (count == 0) {
+      return;
+    }
+    if (count < bits_per_block) {
+      bits &= (block_type{1} << count) - 1;
+    }
+    size_type offset = size_ % bits_per_block;
+    if (offset == 0) {
+      blocks_.push_back(bits);
+    } else {
+      blocks_.back() |= bits << offset;
+      if (offset + count > bits_per_block) {
+        blocks_.push_back(bits >> (bits_per_block - offset));
+      }
+    }
+    size_ += count;
+  }
+
+  void pop_back() {
+    --size_;
+    if (size_ % bits_per_block == 0) {
+      blocks_.pop_back();
+    } else {
+      blocks_.back() &= ~Mask_(size_);
+    }
+  }
+
+  dynamic_bitset &set() noexcept {
+    std::fill(blocks_.begin(), blocks_.end(), ~block_type{0});
+    ClearTail_();
+    return *this;
+  }
+
+  dynamic_bitset &set(size_type pos, bool value = true) {
+    CheckPos_(pos);
+    (*this)[pos] = value;
+    return *this;
+  }
+
+  dynamic_bitset &reset() noexcept {
+    std::fill(blocks_.begin(), blocks_.end(), block_type{0});
+    return *this;
+  }
+
+  dynamic_bitset &reset(size_type pos) { return set(pos, false); }
+
+  dynamic_bitset &flip() noexcept {
+    for (block_type &block : blocks_) {
+      block = ~block;
+    }
+    ClearTail_();
+    return *this;
+  }
+
+  dynamic_bitset &flip(size_type pos) {
+    CheckPos_(pos);
+    (*this)[pos].flip();
+    return *this;
+  }
+
+  size_type count() const noexcept {
+    return simd::popcount(blocks_.data(), blocks_.size());
+  }
+
+  bool all() const noexcept { return count() == size_; }
+
+  bool any() const noexcept { return find_first() != npos; }
+
+  bool none() const noexcept { return !any(); }
+
+  // Position of the first set bit, or npos.
+  size_type find_first() const noexcept { return FindFrom_(0); }
+
+  // Position of the first set bit after pos, or npos.
+  size_type find_next(size_type pos) const noexcept {
+    ++pos;
+    if (pos >= size_) {
+      return npos;
+    }
+    size_type block = pos / bits_per_block;
+    block_type rest = blocks_[block] & ~(Mask_(pos) - 1);
+    if (rest != 0) {
+      return block * bits_per_block + __builtin_ctzll(rest);
+    }
+    return FindFrom_(block + 1);
+  }
+
+  dynamic_bitset &operator&=(const dynamic_bitset &other) {
+    RequireSameSize_(other);
+    simd::bit_and(blocks_.data(), other.blocks_.data(), blocks_.size());
+    return *this;
+  }
+
+  dynamic_bitset &operator|=(const dynamic_bitset &other) {
+    RequireSameSize_(other);
+    simd::bit_or(blocks_.data(), other.blocks_.data(), blocks_.size());
+    return *this;
+  }
+
+  dynamic_bitset &operator^=(const dynamic_bitset &other) {
+    RequireSameSize_(other);
+    simd::bit_xor(blocks_.data(), other.blocks_.data(), blocks_.size());
+    return *this;
+  }
+
+  // Clears every bit that is set in other: *this &= ~other.
+  dynamic_bitset &and_not(const dynamic_bitset &other) {
+    RequireSameSize_(other);
+    simd::bit_andnot(blocks_.data(), other.blocks_.data(), blocks_.size());
+    return *this;
+  }
+
+  bool operator==(const dynamic_bitset &other) const noexcept {
+    return size_ == other.size_ &&
+           std::equal(blocks_.begin(), blocks_.end(), other.blocks_.begin());
+  }
+
+  bool operator!=(const dynamic_bitset &other) const noexcept {
+    return !(*this == other);
+  }
+
+  void swap(dynamic_bitset &other) noexcept {
+    blocks_.swap(other.blocks_);
+    std::swap(size_, other.size_);
+  }
+
+ private:
+  static size_type BlocksFor_(size_type bits) noexcept {
+    return (bits + bits_per_block - 1) / bits_per_block;
+  }
+
+  static block_type Mask_(size_type pos) noexcept {
+    return block_type{1} << pos % bits_per_block;
+  }
+
+  void ClearTail_() noexcept {
+    if (size_ % bits_per_block != 0) {
+      blocks_.back() &= ~(~block_type{0} << size_ % bits_per_block);
+    }
+  }
+
+  void CheckPos_(size_type pos) const {
+    if (pos >= size_) {
+      throw std::out_of_range("Out of bound exeption");
+    }
+  }
+
+  void RequireSameSize_(const dynamic_bitset &other) const {
+    if (size_ != other.size_) {
+      throw std::invalid_argument("dynamic_bitset sizes differ");
+    }
+  }
+
+  // First set bit in blocks [block, num_blocks()), or npos.
+  size_type FindFrom_(size_type block) const noexcept {
+    for (; block < blocks_.size(); ++block) {
+      if (blocks_[block] != 0) {
+        return block * bits_per_block + __builtin_ctzll(blocks_[block]);
+      }
+    }
+    return npos;
+  }
+
+  aligned_vector<block_type, 64> blocks_;
+  size_type size_ = 0;
+};
+
+inline dynamic_bitset operator&(dynamic_bitset a, const dynamic_bitset &b) {
+  return a &= b;
+}
+
+inline dynamic_bitset operator|(dynamic_bitset a, const dynamic_bitset &b) {
+  return a |= b;
+}
+
+inline dynamic_bitset operator^(dynamic_bitset a, const dynamic_bitset &b) {
+  return a ^= b;
+}
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_DYNAMIC_BITSET_H_
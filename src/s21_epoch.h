@@ -0,0 +1,321 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_EPOCH_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_EPOCH_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "s21_memory.h"
+#include "s21_vector.h"
+
+#if defined(__linux__)
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Epoch-based memory reclamation (Fraser, 2004) for lock-free containers.
+// A reader wraps every access to shared nodes in an epoch::guard; a writer
+// that unlinks a node hands it to epoch::retire() instead of deleting it.
+// The node is freed once every reader that might have seen it has left
+// its guard.
+//
+//   s21::epoch::guard g;               // reader
+//   Node *n = head.load(std::memory_order_acquire);
+//   ...
+//   s21::epoch::retire(old);           // writer, after unlinking old
+//
+// A global epoch counts up. Entering a guard stamps the thread's slot with
+// the current epoch; the epoch advances only when every thread inside a
+// guard carries the current stamp, so once it has moved twice past the
+// epoch in which a node was retired, no reader can still hold the node.
+// Retired nodes wait in three per-thread limbo lists, one per epoch
+// modulo 3, and every 64th retire tries to advance the epoch and frees
+// the lists that have become safe, so reclamation is amortized over
+// writers and never runs on the read path.
+//
+// Entering the outermost guard is one load of the global epoch and one
+// store to the thread's own slot. On Linux the store needs no fence: the
+// rare advancing thread issues membarrier(2), which forces a full barrier
+// on every other thread of the process instead. Where that is not
+// available, and under ThreadSanitizer, which cannot see membarrier, the
+// guard falls back to internal::FullFence().
+namespace s21 {
+namespace internal {
+class EpochDomain {
+ public:
+  using Deleter = void (*)(void *);
+
+  static void Enter() noexcept {
+    if (tls_depth_++ == 0) {
+      Record_ *record = tls_record_;
+      if (record == nullptr) {
+        record = Register_();
+      }
+      record->state.store(
+          global_.load(std::memory_order_relaxed) << 1 | kActive_,
+          std::memory_order_relaxed);
+      if (tls_asymmetric_) {
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+      } else {
+        FullFence();
+      }
+    }
+  }
+
+  static void Leave() noexcept {
+    if (--tls_depth_ == 0) {
+      tls_record_->state.store(0, std::memory_order_release);
+    }
+  }
+
+  static void Retire(void *p, Deleter deleter) {
+    Local_ &local = Local();
+    std::uint64_t epoch = global_.load(std::memory_order_acquire);
+    Bucket_ &bucket = local.limbo[epoch % 3];
+    if (bucket.epoch != epoch) {
+      // The bucket last took nodes three or more epochs ago.
+      Free_(bucket.nodes);
+      bucket.epoch = epoch;
+    }
+    bucket.nodes.push_back(Retired_{p, deleter});
+    if (++local.since_collect >= kCollectEvery_) {
+      local.since_collect = 0;
+      Collect();
+    }
+  }
+
+  // Advances the epoch if every thread in a guard has caught up, then
+  // frees the calling thread's lists, and any left by exited threads,
+  // that are two epochs old.
+  static void Collect() { CollectFor_(Local()); }
+
+  static std::uint64_t Current() noexcept {
+    return global_.load(std::memory_order_acquire);
+  }
+
+  // True when readers rely on membarrier(2) rather than their own fence.
+  static bool Asymmetric() { return Membarrier_(); }
+
+ private:
+  struct Retired_ {
+    void *pointer;
+    Deleter deleter;
+  };
+
+  struct Bucket_ {
+    std::uint64_t epoch = 0;
+    s21::vector<Retired_> nodes;
+  };
+
+  struct Orphan_ {
+    std::uint64_t epoch;
+    Retired_ node;
+  };
+
+  struct Local_;
+
+  static void CollectFor_(Local_ &local) {
+    TryAdvance_();
+    std::uint64_t epoch = global_.load(std::memory_order_acquire);
+    for (Bucket_ &bucket : local.limbo) {
+      if (bucket.epoch + 2 <= epoch) {
+        Free_(bucket.nodes);
+      }
+    }
+    Orphans_ &orphans = Orphans();
+    std::unique_lock<std::mutex> lock(orphans.mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+      return;
+    }
+    s21::vector<Orphan_> kept;
+    s21::vector<Retired_> ready;
+    for (const Orphan_ &orphan : orphans.nodes) {
+      if (orphan.epoch + 2 <= epoch) {
+        ready.push_back(orphan.node);
+      } else {
+        kept.push_back(orphan);
+      }
+    }
+    orphans.nodes.swap(kept);
+    lock.unlock();
+    Free_(ready);
+  }
+
+  // One per thread that ever entered a guard; reused after the thread
+  // exits and never freed, so scans walk the list without protection.
+  struct alignas(cache_line_size) Record_ {
+    std::atomic<std::uint64_t> state{0};
+    std::atomic<bool> in_use{true};
+    Record_ *next = nullptr;
+  };
+
+  // Limbo lists of one thread; on exit it frees what it can and leaves the
+  // rest, with its epochs, to later collections.
+  struct Local_ {
+    ~Local_() {
+      CollectFor_(*this);
+      Orphans_ &orphans = Orphans();
+      std::lock_guard<std::mutex> lock(orphans.mutex);
+      for (Bucket_ &bucket : limbo) {
+        for (const Retired_ &node : bucket.nodes) {
+          orphans.nodes.push_back(Orphan_{bucket.epoch, node});
+        }
+      }
+      if (tls_record_ != nullptr) {
+        tls_record_->state.store(0, std::memory_order_release);
+        tls_record_->in_use.store(false, std::memory_order_release);
+        tls_record_ = nullptr;
+      }
+    }
+
+    Bucket_ limbo[3];
+    unsigned since_collect = 0;
+  };
+
+  struct Orphans_ {
+    // Runs after every thread has exited, so no reader is left.
+    ~Orphans_() {
+      for (const Orphan_ &orphan : nodes) {
+        orphan.node.deleter(orphan.node.pointer);
+      }
+    }
+
+    std::mutex mutex;
+    s21::vector<Orphan_> nodes;
+  };
+
+  static constexpr std::uint64_t kActive_ = 1;
+  static constexpr unsigned kCollectEvery_ = 64;
+
+  static Local_ &Local() {
+    thread_local Local_ local;
+    return local;
+  }
+
+  static Orphans_ &Orphans() {
+    static Orphans_ orphans;
+    return orphans;
+  }
+
+  static bool Membarrier_() {
+    static const bool available = [] {
+#if defined(__linux__) && defined(SYS_membarrier) && \
+    !defined(S21_THREAD_SANITIZER)
+      long commands = syscall(SYS_membarrier, MEMBARRIER_CMD_QUERY, 0);
+      return commands >= 0 &&
+             (commands & MEMBARRIER_CMD_PRIVATE_EXPEDITED) != 0 &&
+             syscall(SYS_membarrier,
+                     MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0) == 0;
+#else
+      return false;
+#endif
+    }();
+    return available;
+  }
+
+  // Pairs with the fence, or its absence, in Enter().
+  static void HeavyFence_() noexcept {
+#if defined(__linux__) && defined(SYS_membarrier)
+    if (Membarrier_()) {
+      syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0);
+      return;
+    }
+#endif
+    FullFence();
+  }
+
+  static Record_ *Register_() {
+    Orphans();  // constructed first, so destroyed after every Local_
+    Local();    // its destructor releases the record on thread exit
+    tls_asymmetric_ = Membarrier_();
+    Record_ *record = nullptr;
+    for (Record_ *r = head_.load(std::memory_order_acquire); r != nullptr;
+         r = r->next) {
+      bool idle = false;
+      if (!r->in_use.load(std::memory_order_relaxed) &&
+          r->in_use.compare_exchange_strong(idle, true,
+                                            std::memory_order_acquire)) {
+        record = r;
+        break;
+      }
+    }
+    if (record == nullptr) {
+      record = new Record_;
+      record->next = head_.load(std::memory_order_relaxed);
+      while (!head_.compare_exchange_weak(record->next, record,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+      }
+    }
+    tls_record_ = record;
+    return record;
+  }
+
+  static void TryAdvance_() {
+    std::uint64_t epoch = global_.load(std::memory_order_acquire);
+    HeavyFence_();
+    for (Record_ *r = head_.load(std::memory_order_acquire); r != nullptr;
+         r = r->next) {
+      std::uint64_t state = r->state.load(std::memory_order_acquire);
+      if ((state & kActive_) != 0 && state >> 1 != epoch) {
+        return;
+      }
+    }
+    global_.compare_exchange_strong(epoch, epoch + 1,
+                                    std::memory_order_acq_rel);
+  }
+
+  // Empties nodes before calling the deleters, which may retire more.
+  static void Free_(s21::vector<Retired_> &nodes) {
+    s21::vector<Retired_> doomed;
+    doomed.swap(nodes);
+    for (const Retired_ &node : doomed) {
+      node.deleter(node.pointer);
+    }
+  }
+
+  inline static std::atomic<std::uint64_t> global_{0};
+  inline static std::atomic<Record_ *> head_{nullptr};
+  inline static thread_local Record_ *tls_record_ = nullptr;
+  inline static thread_local unsigned tls_depth_ = 0;
+  inline static thread_local bool tls_asymmetric_ = false;
+};
+}  // namespace internal
+
+namespace epoch {
+// Marks the calling thread as reading shared nodes until destroyed.
+// Guards nest; only the outermost one touches the thread's slot. Keep
+// guards short: one long-lived guard holds back reclamation everywhere.
+class guard {
+ public:
+  guard() noexcept { internal::EpochDomain::Enter(); }
+  ~guard() { internal::EpochDomain::Leave(); }
+
+  guard(const guard &) = delete;
+  guard &operator=(const guard &) = delete;
+};
+
+// Frees p with deleter once no guard that might have seen it remains. p
+// must already be unreachable for readers that enter a guard later.
+inline void retire(void *p, void (*deleter)(void *)) {
+  internal::EpochDomain::Retire(p, deleter);
+}
+
+template <class T>
+void retire(T *p) {
+  retire(static_cast<void *>(p), [](void *q) { delete static_cast<T *>(q); });
+}
+
+// Forces a reclamation pass now instead of at the next 64th retire.
+inline void collect() { internal::EpochDomain::Collect(); }
+
+inline std::uint64_t current() noexcept {
+  return internal::EpochDomain::Current();
+}
+}  // namespace epoch
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_EPOCH_H_
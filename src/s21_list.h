@@ -2,12 +2,16 @@
 #ifndef CPP2_S21_CONTAINERS_SRC_S21_LIST_H_
 #define CPP2_S21_CONTAINERS_SRC_S21_LIST_H_
 
+#include <algorithm>
 #include <initializer_list>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
 
 namespace s21 {
-template <typename T>
+template <typename T, class Allocator = std::allocator<T>>
 class list {
  public:
   class ListIterator;
@@ -17,7 +21,7 @@ class list {
 
  public:
   class ListConstIterator {
-    friend class list<T>;
+    friend class list;
 
    public:
     using value_type = T;
@@ -125,38 +129,54 @@ class list {
   };
 
   using value_type = T;
+  using allocator_type = Allocator;
   using reference = T &;
   using const_reference = const T &;
   using iterator = ListIterator;
   using const_iterator = ListConstIterator;
   using size_type = std::size_t;
 
-  list() : size_(0) {
-    fantom_node_ = new Node(T());
-    fantom_node_->prev_ = fantom_node_;
-    fantom_node_->next_ = fantom_node_;
+  static_assert(
+      std::is_same_v<typename std::allocator_traits<Allocator>::value_type,
+                     T>,
+      "Allocator::value_type must be T");
+
+  list() : list(Allocator()) {}
+
+  explicit list(const Allocator &alloc) : size_(0), alloc_(alloc) {
+    fantom_node_ = CreateSentinel_();
   }
 
-  explicit list(size_type n) : list() {
+  explicit list(size_type n, const Allocator &alloc = Allocator())
+      : list(alloc) {
     for (size_type i = 0; i < n; ++i) {
-      push_back(T());
+      EmplaceBefore_(fantom_node_);
     }
   }
 
-  explicit list(std::initializer_list<value_type> const &items) noexcept
-      : list() {
+  explicit list(std::initializer_list<value_type> const &items,
+                const Allocator &alloc = Allocator())
+      : list(alloc) {
     for (const_reference value_ : items) {
       push_back(value_);
     }
   }
 
-  list(const list &other) : list() {
+  list(const list &other)
+      : list(AllocTraits_::select_on_container_copy_construction(
+            other.alloc_)) {
+    for (const_reference value_ : other) {
+      push_back(value_);
+    }
+  }
+
+  list(const list &other, const Allocator &alloc) : list(alloc) {
     for (const_reference value_ : other) {
       push_back(value_);
     }
   }
 
-  list(list &&other) noexcept {
+  list(list &&other) noexcept : alloc_(std::move(other.alloc_)) {
     size_ = std::move(other.size_);
     fantom_node_ = std::move(other.fantom_node_);
     other.size_ = 0;
@@ -170,11 +190,11 @@ class list {
         Node *new_tail = prev_tail->prev_;
         new_tail->next_ = fantom_node_;
         fantom_node_->prev_ = new_tail;
-        delete prev_tail;
+        DestroyNode_(prev_tail);
         --size_;
       }
     }
-    delete fantom_node_;
+    DestroySentinel_(fantom_node_);
   }
 
   list &operator=(const list &other) {
@@ -182,17 +202,50 @@ class list {
       return *this;
     }
     clear();
+    if constexpr (AllocTraits_::propagate_on_container_copy_assignment::
+                      value) {
+      if (alloc_ != other.alloc_) {
+        DestroySentinel_(fantom_node_);
+        fantom_node_ = nullptr;
+        alloc_ = other.alloc_;
+        fantom_node_ = CreateSentinel_();
+      } else {
+        alloc_ = other.alloc_;
+      }
+    }
     for (const T &value_ : other) {
       push_back(value_);
     }
     return *this;
   }
 
-  list &operator=(list &&other) noexcept {
+  list &operator=(list &&other) noexcept(
+      AllocTraits_::propagate_on_container_move_assignment::value ||
+      AllocTraits_::is_always_equal::value) {
+    if (this == &other) {
+      return *this;
+    }
     while (!empty()) {
       pop_back();
     }
-    delete fantom_node_;
+    if constexpr (!AllocTraits_::propagate_on_container_move_assignment::
+                      value &&
+                  !AllocTraits_::is_always_equal::value) {
+      if (alloc_ != other.alloc_) {
+        // Nodes from other's allocator cannot be adopted, so the values
+        // are moved into nodes of our own.
+        for (T &value_ : other) {
+          EmplaceBefore_(fantom_node_, std::move(value_));
+        }
+        other.clear();
+        return *this;
+      }
+    }
+    DestroySentinel_(fantom_node_);
+    if constexpr (AllocTraits_::propagate_on_container_move_assignment::
+                      value) {
+      alloc_ = std::move(other.alloc_);
+    }
     fantom_node_ = std::move(other.fantom_node_);
     size_ = other.size_;
     other.size_ = 0;
@@ -200,8 +253,14 @@ class list {
     return *this;
   }
 
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+  reference front() { return fantom_node_->next_->value_; }
+
   const_reference front() const { return fantom_node_->next_->value_; }
 
+  reference back() { return fantom_node_->prev_->value_; }
+
   const_reference back() const { return fantom_node_->prev_->value_; }
 
   iterator begin() { return iterator(fantom_node_->next_); }
@@ -217,7 +276,9 @@ class list {
   size_t size() const noexcept { return size_; }
 
   size_type max_size() const noexcept {
-    return std::numeric_limits<size_t>::max() / sizeof(Node) / 2;
+    return std::min<size_type>(
+        NodeTraits_::max_size(alloc_),
+        std::numeric_limits<size_t>::max() / sizeof(Node) / 2);
   }
 
   void clear() noexcept {
@@ -227,11 +288,16 @@ class list {
   }
 
   iterator insert(iterator pos, const_reference value_) {
-    Node *next_node = pos.node_;
-    Node *insert_node = new Node(value_);
-    next_node->prev_->InsertNode(insert_node, next_node);
-    ++size_;
-    return iterator(insert_node);
+    return iterator(EmplaceBefore_(pos.node_, value_));
+  }
+
+  iterator insert(iterator pos, value_type &&value_) {
+    return iterator(EmplaceBefore_(pos.node_, std::move(value_)));
+  }
+
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    return iterator(EmplaceBefore_(pos.node_, std::forward<Args>(args)...));
   }
 
   void erase(iterator pos) {
@@ -241,14 +307,21 @@ class list {
     }
     erase_node->prev_->next_ = erase_node->next_;
     erase_node->next_->prev_ = erase_node->prev_;
-    delete pos.node_;
+    DestroyNode_(erase_node);
     --size_;
   }
 
   void push_back(const_reference value_) {
-    Node *new_node = new Node(value_);
-    fantom_node_->prev_->InsertNode(new_node, fantom_node_);
-    ++size_;
+    EmplaceBefore_(fantom_node_, value_);
+  }
+
+  void push_back(value_type &&value_) {
+    EmplaceBefore_(fantom_node_, std::move(value_));
+  }
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    return EmplaceBefore_(fantom_node_, std::forward<Args>(args)...)->value_;
   }
 
   void pop_back() {
@@ -256,14 +329,22 @@ class list {
     Node *new_tail = prev_tail->prev_;
     new_tail->next_ = fantom_node_;
     fantom_node_->prev_ = new_tail;
-    delete prev_tail;
+    DestroyNode_(prev_tail);
     --size_;
   }
 
   void push_front(const_reference value_) {
-    Node *new_node = new Node(value_);
-    fantom_node_->InsertNode(new_node, fantom_node_->next_);
-    ++size_;
+    EmplaceBefore_(fantom_node_->next_, value_);
+  }
+
+  void push_front(value_type &&value_) {
+    EmplaceBefore_(fantom_node_->next_, std::move(value_));
+  }
+
+  template <typename... Args>
+  reference emplace_front(Args &&...args) {
+    return EmplaceBefore_(fantom_node_->next_, std::forward<Args>(args)...)
+        ->value_;
   }
 
   void pop_front() {
@@ -271,11 +352,14 @@ class list {
     Node *new_head = prev_head->next_;
     new_head->prev_ = fantom_node_;
     fantom_node_->next_ = new_head;
-    delete prev_head;
+    DestroyNode_(prev_head);
     --size_;
   }
 
-  void swap(list &other) {
+  void swap(list &other) noexcept {
+    if constexpr (AllocTraits_::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
     std::swap(fantom_node_, other.fantom_node_);
     std::swap(size_, other.size_);
   }
@@ -362,32 +446,36 @@ class list {
   template <typename... Args>
   iterator insert_many(const_iterator pos, Args &&...args) {
     Node *prev_node = pos.node_->prev_;
-    list<value_type> init_list{std::forward<Args>(args)...};
+    list init_list = MakeList_(std::forward<Args>(args)...);
     splice(pos, init_list);
-    size_ += init_list.size();
     return iterator(prev_node->next_);
   }
 
   template <typename... Args>
   void insert_many_back(Args &&...args) {
-    list init_list{std::forward<Args>(args)...};
+    list init_list = MakeList_(std::forward<Args>(args)...);
     splice(end(), init_list);
   }
 
   template <typename... Args>
   void insert_many_front(Args &&...args) {
-    list init_list{std::forward<Args>(args)...};
+    list init_list = MakeList_(std::forward<Args>(args)...);
     splice(begin(), init_list);
   }
 
  private:
+  // value_ lives in a union so that a node can be created without
+  // constructing it: the sentinel never holds a value, and real nodes get
+  // theirs built through the element allocator.
   struct Node {
     Node *prev_;
     Node *next_;
-    value_type value_;
+    union {
+      value_type value_;
+    };
 
-    explicit Node(const T &data)
-        : prev_(nullptr), next_(nullptr), value_(data) {}
+    Node() : prev_(nullptr), next_(nullptr) {}
+    ~Node() {}
 
     void InsertNode(Node *insert_node, Node *next_node) {
       next_node->prev_ = insert_node;
@@ -406,9 +494,74 @@ class list {
       std::inplace_merge(begin, middle, end, cmp);
     }
   }
+  using AllocTraits_ = std::allocator_traits<Allocator>;
+  using NodeAllocator_ = typename AllocTraits_::template rebind_alloc<Node>;
+  using NodeTraits_ = std::allocator_traits<NodeAllocator_>;
+
+  Node *CreateSentinel_() {
+    NodeAllocator_ node_alloc(alloc_);
+    Node *node = NodeTraits_::allocate(node_alloc, 1);
+    NodeTraits_::construct(node_alloc, node);
+    node->prev_ = node;
+    node->next_ = node;
+    return node;
+  }
+
+  void DestroySentinel_(Node *node) noexcept {
+    if (node == nullptr) {
+      return;
+    }
+    NodeAllocator_ node_alloc(alloc_);
+    NodeTraits_::destroy(node_alloc, node);
+    NodeTraits_::deallocate(node_alloc, node, 1);
+  }
+
+  template <typename... Args>
+  Node *CreateNode_(Args &&...args) {
+    Node *node = CreateSentinel_();
+    try {
+      AllocTraits_::construct(alloc_, std::addressof(node->value_),
+                              std::forward<Args>(args)...);
+    } catch (...) {
+      DestroySentinel_(node);
+      throw;
+    }
+    return node;
+  }
+
+  void DestroyNode_(Node *node) noexcept {
+    AllocTraits_::destroy(alloc_, std::addressof(node->value_));
+    DestroySentinel_(node);
+  }
+
+  template <typename... Args>
+  Node *EmplaceBefore_(Node *next_node, Args &&...args) {
+    Node *insert_node = CreateNode_(std::forward<Args>(args)...);
+    next_node->prev_->InsertNode(insert_node, next_node);
+    ++size_;
+    return insert_node;
+  }
+
+  // Builds the elements of insert_many* in a side list first, so a throwing
+  // constructor leaves *this untouched.
+  template <typename... Args>
+  list MakeList_(Args &&...args) {
+    list init_list(alloc_);
+    (init_list.EmplaceBefore_(init_list.fantom_node_,
+                              std::forward<Args>(args)),
+     ...);
+    return init_list;
+  }
+
   size_type size_;
   Node *fantom_node_;
+  allocator_type alloc_;
 };
+
+namespace pmr {
+template <class T>
+using list = s21::list<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // CPP2_S21_CONTAINERS_SRC_LIST_LIST_H_
\ No newline at end of file
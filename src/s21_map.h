@@ -5,12 +5,16 @@
 #include <functional>
 #include <initializer_list>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <tuple>
 #include <utility>
 
 #include "s21_set.h"
 namespace s21 {
 
-template <class Key, class T, class Compare = std::less<Key> >
+template <class Key, class T, class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T> > >
 class map {
  public:
   using key_type = Key;
@@ -19,29 +23,65 @@ class map {
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = size_t;
+  using allocator_type = Allocator;
 
  private:
   template <class First, class Second>
   class MyPair_ {
    public:
-    MyPair_<First, Second>(First first, Second second)
-        : first{first}, second{second} {}
-    MyPair_<First, Second>(const MyPair_<First, Second> &other)
+    template <class F, class S>
+    MyPair_(F &&first, S &&second)
+        : first(std::forward<F>(first)), second(std::forward<S>(second)) {}
+    template <class... FirstArgs, class... SecondArgs>
+    MyPair_(std::piecewise_construct_t, std::tuple<FirstArgs...> first_args,
+            std::tuple<SecondArgs...> second_args)
+        : MyPair_(first_args, second_args,
+                  std::index_sequence_for<FirstArgs...>(),
+                  std::index_sequence_for<SecondArgs...>()) {}
+    MyPair_(const std::pair<const First, Second> &other)
         : first(other.first), second(other.second) {}
+    MyPair_(std::pair<const First, Second> &&other)
+        : first(other.first), second(std::move(other.second)) {}
+    MyPair_(const MyPair_ &other) = default;
+    MyPair_(MyPair_ &&other) = default;
+    MyPair_ &operator=(const MyPair_ &other) = default;
+    MyPair_ &operator=(MyPair_ &&other) = default;
 
     First first;
     Second second;
+
+   private:
+    template <class FirstTuple, class SecondTuple, size_t... FirstI,
+              size_t... SecondI>
+    MyPair_(FirstTuple &first_args, SecondTuple &second_args,
+            std::index_sequence<FirstI...>, std::index_sequence<SecondI...>)
+        : first(std::get<FirstI>(std::move(first_args))...),
+          second(std::get<SecondI>(std::move(second_args))...) {}
   };
 
+  // Transparent, so the underlying set can be searched by a bare key
+  // without building a pair (and a default mapped_type) for every lookup.
   struct InMapCompare_ {
+    using is_transparent = void;
+
     bool operator()(const MyPair_<key_type, mapped_type> &lhs,
                     const MyPair_<key_type, mapped_type> &rhs) const {
       return Compare{}(lhs.first, rhs.first);
     }
+    bool operator()(const MyPair_<key_type, mapped_type> &lhs,
+                    const key_type &rhs) const {
+      return Compare{}(lhs.first, rhs);
+    }
+    bool operator()(const key_type &lhs,
+                    const MyPair_<key_type, mapped_type> &rhs) const {
+      return Compare{}(lhs, rhs.first);
+    }
   };
 
   using SetValueType_ = MyPair_<key_type, mapped_type>;
-  using SetTemplate_ = s21::set<SetValueType_, InMapCompare_>;
+  using SetAllocator_ = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<SetValueType_>;
+  using SetTemplate_ = s21::set<SetValueType_, InMapCompare_, SetAllocator_>;
 
  public:
   using iterator = typename SetTemplate_::iterator;
@@ -49,16 +89,23 @@ class map {
 
   map() : data_{} { ; }
 
-  map(std::initializer_list<value_type> const &items) {
+  explicit map(const Allocator &alloc) : data_(SetAllocator_(alloc)) { ; }
+
+  map(std::initializer_list<value_type> const &items,
+      const Allocator &alloc = Allocator())
+      : data_(SetAllocator_(alloc)) {
     for (const value_type &item : items) {
       insert(item.first, item.second);
     }
   }
 
   map(const map &other) : data_(other.data_) { ; }
+  map(const map &other, const Allocator &alloc)
+      : data_(other.data_, SetAllocator_(alloc)) {}
   map(map &&other) noexcept : data_(std::move(other.data_)) { ; }
 
-  map &operator=(map &&other) noexcept {
+  map &operator=(map &&other) noexcept(
+      noexcept(std::declval<SetTemplate_ &>() = std::declval<SetTemplate_>())) {
     data_ = std::move(other.data_);
     return *this;
   }
@@ -70,7 +117,11 @@ class map {
 
   ~map() { data_.clear(); }
 
-  void swap(map &other) { std::swap(*this, other); }
+  allocator_type get_allocator() const {
+    return allocator_type(data_.get_allocator());
+  }
+
+  void swap(map &other) noexcept { data_.swap(other.data_); }
   void merge(map &other) { data_.merge(other.data_); }
 
   bool empty() const { return data_.empty(); }
@@ -84,73 +135,104 @@ class map {
 
   std::pair<iterator, bool> insert(const key_type &key,
                                    const mapped_type &mapped) {
-    return data_.insert(SetValueType_(key, mapped));
+    return TryEmplace_(key, mapped);
   }
 
   std::pair<iterator, bool> insert(const_reference value) {
-    return data_.insert(SetValueType_(value.first, value.second));
+    return TryEmplace_(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return TryEmplace_(value.first, std::move(value.second));
   }
 
-  std::pair<iterator, bool> insert_or_assign(const key_type &key,
-                                             const mapped_type &obj) {
-    bool status = contains(key);
-    if (status) {
-      at(key) = obj;
-    } else {
-      insert(key, obj);
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj) {
+    auto result = TryEmplace_(key, std::forward<M>(obj));
+    if (!result.second) {
+      (*result.first).second = std::forward<M>(obj);
     }
-    auto it = (data_.insert(SetValueType_(key, obj))).first;
-    return std::make_pair(it, !status);
+    return result;
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return data_.emplace(std::forward<Args>(args)...);
+  }
+
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return data_.emplace_hint(hint, std::forward<Args>(args)...);
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    return TryEmplace_(key, std::forward<Args>(args)...);
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+    return TryEmplace_(std::move(key), std::forward<Args>(args)...);
   }
 
   void erase(iterator pos) { data_.erase(pos); }
 
   mapped_type &operator[](const key_type &key) {
-    auto it = data_.find(SetValueType_(key, mapped_type()));
+    return (*TryEmplace_(key).first).second;
+  }
 
-    if (it == data_.end()) {
-      it = (data_.insert(SetValueType_(key, mapped_type()))).first;
-    }
-    return (*it).second;
+  mapped_type &operator[](key_type &&key) {
+    return (*TryEmplace_(std::move(key)).first).second;
   }
 
   const mapped_type &at(const Key &key) const {
-    auto it = data_.find(SetValueType_(key, mapped_type()));
+    auto it = data_.find(key);
     if (it == data_.end()) throw std::out_of_range("Incorrect index");
     return (*it).second;
   }
 
   mapped_type &at(const Key &key) {
-    auto it = data_.find(SetValueType_(key, mapped_type()));
+    auto it = data_.find(key);
     if (it == data_.end()) throw std::out_of_range("Incorrect index");
     return (*it).second;
   }
 
-  bool contains(const key_type &key) const {
-    return data_.contains(SetValueType_(key, mapped_type()));
-  }
+  bool contains(const key_type &key) const { return data_.contains(key); }
 
-  iterator find(const Key &key) {
-    return data_.find(SetValueType_(key, mapped_type()));
-  }
+  iterator find(const Key &key) { return data_.find(key); }
 
-  const_iterator find(const Key &key) const {
-    return data_.find(SetValueType_(key, mapped_type()));
-  }
+  const_iterator find(const Key &key) const { return data_.find(key); }
 
   iterator upper_bound(const Key &key) const {
-    return data_.upper_bound(SetValueType_(key, mapped_type()));
+    return data_.upper_bound(key);
   }
 
   iterator lower_bound(const Key &key) const {
-    return data_.lower_bound(SetValueType_(key, mapped_type()));
+    return data_.lower_bound(key);
   }
 
   void clear() { data_.clear(); }
 
  private:
+  // One descent of the tree; a present key costs neither a node
+  // allocation nor a copy of the arguments.
+  template <class K, class... Args>
+  std::pair<iterator, bool> TryEmplace_(K &&key, Args &&...args) {
+    return data_.EmplaceKey_(
+        key, std::piecewise_construct,
+        std::forward_as_tuple(std::forward<K>(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
   SetTemplate_ data_;
 };
+
+namespace pmr {
+template <class Key, class T, class Compare = std::less<Key> >
+using map =
+    s21::map<Key, T, Compare,
+             std::pmr::polymorphic_allocator<std::pair<const Key, T> > >;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // CPP2_S21_CONTAINERS_SRC_S21_MAP_H_
@@ -0,0 +1,345 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_MEMORY_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_MEMORY_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace s21 {
+// A type is trivially relocatable when moving an object to a new address and
+// destroying the original is the same as copying its bytes. Containers use
+// memcpy/memmove for such types instead of per-element moves. Trivially
+// copyable types qualify automatically; other types may opt in by
+// specializing this trait, e.g. a struct holding a std::unique_ptr:
+//
+//   template <>
+//   struct s21::is_trivially_relocatable<MyRecord> : std::true_type {};
+template <class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <class T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+// Detects an allocator member reallocate(p, old_n, new_n) that may resize a
+// block in place; only meaningful for trivially relocatable elements.
+template <class Allocator, class = void>
+struct allocator_has_reallocate : std::false_type {};
+
+template <class Allocator>
+struct allocator_has_reallocate<
+    Allocator,
+    std::void_t<decltype(std::declval<Allocator &>().reallocate(
+        std::declval<typename Allocator::value_type *>(), std::size_t{},
+        std::size_t{}))>> : std::true_type {};
+
+// Allocator on top of malloc/realloc/free, so that containers of trivially
+// relocatable elements can grow without copying when the C runtime manages
+// to extend the block in place.
+template <class T>
+class malloc_allocator {
+ public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  static_assert(alignof(T) <= alignof(std::max_align_t),
+                "malloc_allocator does not support over-aligned types");
+
+  malloc_allocator() noexcept = default;
+  template <class U>
+  malloc_allocator(const malloc_allocator<U> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    void *p = std::malloc(n * sizeof(T));
+    if (p == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T *>(p);
+  }
+
+  void deallocate(T *p, std::size_t) noexcept { std::free(p); }
+
+  T *reallocate(T *p, std::size_t, std::size_t new_n) {
+    void *grown = std::realloc(p, new_n * sizeof(T));
+    if (grown == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T *>(grown);
+  }
+
+  template <class U>
+  bool operator==(const malloc_allocator<U> &) const noexcept {
+    return true;
+  }
+  template <class U>
+  bool operator!=(const malloc_allocator<U> &) const noexcept {
+    return false;
+  }
+};
+
+// Cache line size assumed when padding data that different threads write
+// onto separate lines. std::hardware_destructive_interference_size is not
+// used because GCC warns that its value may differ between compilations.
+inline constexpr std::size_t cache_line_size = 64;
+
+namespace internal {
+// Tells the CPU the caller is spinning, which frees resources for a
+// sibling hyperthread and avoids a memory-order flush on loop exit.
+inline void CpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+#if defined(__SANITIZE_THREAD__)
+#define S21_THREAD_SANITIZER 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define S21_THREAD_SANITIZER 1
+#endif
+#endif
+
+// A seq_cst fence, for the store-then-load handshakes where each of two
+// threads writes one atomic and then reads the other's. ThreadSanitizer
+// does not model fences and warns about them (-Wtsan), so under it every
+// caller instead does an acq_rel read-modify-write on one shared atomic.
+// Those RMWs are totally ordered, and the later one synchronizes with the
+// earlier, so whichever thread comes second sees the other's store, the
+// same guarantee the fences give.
+inline void FullFence() noexcept {
+#if defined(S21_THREAD_SANITIZER)
+  static std::atomic<int> order{0};
+  order.fetch_add(0, std::memory_order_acq_rel);
+#else
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+}
+}  // namespace internal
+
+// Allocator whose blocks start on an Align-byte boundary, e.g. 64 for a
+// cache line or AVX-512 register, or 4096 for a page. Containers keep the
+// allocator across growth, copy and move, so their storage stays aligned.
+template <class T, std::size_t Align>
+class aligned_allocator {
+ public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  static_assert((Align & (Align - 1)) == 0, "alignment must be a power of 2");
+  static_assert(Align >= alignof(T), "alignment is weaker than alignof(T)");
+
+  static constexpr std::size_t alignment = Align;
+
+  template <class U>
+  struct rebind {
+    using other = aligned_allocator<U, Align>;
+  };
+
+  aligned_allocator() noexcept = default;
+  template <class U>
+  aligned_allocator(const aligned_allocator<U, Align> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    if (n > std::size_t(-1) / sizeof(T)) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t{Align}));
+  }
+
+  void deallocate(T *p, std::size_t) noexcept {
+    ::operator delete(static_cast<void *>(p), std::align_val_t{Align});
+  }
+
+  template <class U>
+  bool operator==(const aligned_allocator<U, Align> &) const noexcept {
+    return true;
+  }
+  template <class U>
+  bool operator!=(const aligned_allocator<U, Align> &) const noexcept {
+    return false;
+  }
+};
+
+// Allocator for large append-only buffers of trivially relocatable elements.
+// Blocks of at least ThresholdBytes are anonymous memory mappings; on Linux
+// reallocate() grows them with mremap, which moves page table entries rather
+// than bytes, so the buffer is never copied. Smaller blocks use malloc and
+// realloc. The block kind is derived from the size the container passes back
+// to deallocate/reallocate.
+template <class T, std::size_t ThresholdBytes = std::size_t{1} << 20>
+class mmap_allocator {
+ public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  static_assert(alignof(T) <= alignof(std::max_align_t),
+                "mmap_allocator does not support over-aligned types");
+
+  template <class U>
+  struct rebind {
+    using other = mmap_allocator<U, ThresholdBytes>;
+  };
+
+  mmap_allocator() noexcept = default;
+  template <class U>
+  mmap_allocator(const mmap_allocator<U, ThresholdBytes> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    std::size_t bytes = n * sizeof(T);
+    void *p = IsMapped_(bytes) ? Map_(bytes) : std::malloc(bytes);
+    if (p == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T *>(p);
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept {
+    std::size_t bytes = n * sizeof(T);
+    if (IsMapped_(bytes)) {
+      Unmap_(p, bytes);
+    } else {
+      std::free(p);
+    }
+  }
+
+  T *reallocate(T *p, std::size_t old_n, std::size_t new_n) {
+    std::size_t old_bytes = old_n * sizeof(T);
+    std::size_t new_bytes = new_n * sizeof(T);
+    bool old_mapped = IsMapped_(old_bytes);
+    bool new_mapped = IsMapped_(new_bytes);
+    void *grown = nullptr;
+    if (!old_mapped && !new_mapped) {
+      grown = std::realloc(p, new_bytes);
+#if defined(__linux__)
+    } else if (old_mapped && new_mapped) {
+      grown = mremap(p, RoundToPage_(old_bytes), RoundToPage_(new_bytes),
+                     MREMAP_MAYMOVE);
+      if (grown == MAP_FAILED) {
+        grown = nullptr;
+      }
+#endif
+    } else {
+      grown = allocate(new_n);
+      std::memcpy(grown, static_cast<void *>(p),
+                  std::min(old_bytes, new_bytes));
+      deallocate(p, old_n);
+    }
+    if (grown == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T *>(grown);
+  }
+
+  template <class U>
+  bool operator==(const mmap_allocator<U, ThresholdBytes> &) const noexcept {
+    return true;
+  }
+  template <class U>
+  bool operator!=(const mmap_allocator<U, ThresholdBytes> &) const noexcept {
+    return false;
+  }
+
+ private:
+  static bool IsMapped_(std::size_t bytes) noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+    return bytes >= ThresholdBytes;
+#else
+    (void)bytes;
+    return false;
+#endif
+  }
+
+#if defined(__unix__) || defined(__APPLE__)
+  static std::size_t RoundToPage_(std::size_t bytes) noexcept {
+    static const std::size_t page = sysconf(_SC_PAGESIZE);
+    return (bytes + page - 1) / page * page;
+  }
+
+  static void *Map_(std::size_t bytes) noexcept {
+    void *p = mmap(nullptr, RoundToPage_(bytes), PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return p == MAP_FAILED ? nullptr : p;
+  }
+
+  static void Unmap_(T *p, std::size_t bytes) noexcept {
+    munmap(static_cast<void *>(p), RoundToPage_(bytes));
+  }
+#else
+  static void *Map_(std::size_t bytes) noexcept { return std::malloc(bytes); }
+  static void Unmap_(T *p, std::size_t) noexcept { std::free(p); }
+#endif
+};
+
+// Growth policies for s21::vector. next(capacity, required, element_size)
+// returns the capacity to grow to; it is never less than required.
+namespace growth {
+struct doubling {
+  static std::size_t next(std::size_t capacity, std::size_t required,
+                          std::size_t) noexcept {
+    return std::max(capacity == 0 ? 1 : capacity * 2, required);
+  }
+};
+
+// Reuses freed blocks sooner and peaks at 2.5x instead of 3x the payload
+// while the old buffer is still alive during a copy.
+struct one_and_half {
+  static std::size_t next(std::size_t capacity, std::size_t required,
+                          std::size_t) noexcept {
+    return std::max(capacity + capacity / 2 + 1, required);
+  }
+};
+
+// Doubles, then rounds the byte size up to a whole number of pages so no
+// part of the last page is wasted.
+template <std::size_t PageSize = 4096>
+struct page_rounded {
+  static_assert(PageSize != 0, "page size must be positive");
+
+  static std::size_t next(std::size_t capacity, std::size_t required,
+                          std::size_t element_size) noexcept {
+    std::size_t target = doubling::next(capacity, required, element_size);
+    std::size_t bytes =
+        (target * element_size + PageSize - 1) / PageSize * PageSize;
+    return std::max(bytes / element_size, target);
+  }
+};
+
+// Linear growth by a fixed number of elements, for buffers that must not
+// overshoot their memory budget.
+template <std::size_t Increment>
+struct fixed_increment {
+  static_assert(Increment != 0, "increment must be positive");
+
+  static std::size_t next(std::size_t capacity, std::size_t required,
+                          std::size_t) noexcept {
+    return std::max(capacity + Increment, required);
+  }
+};
+}  // namespace growth
+
+// Counters kept by growable containers so the effect of a growth policy or
+// allocator can be verified: how often storage was replaced, and how many
+// element bytes the container itself copied or moved while doing so. Growth
+// through an allocator's reallocate() is counted as a reallocation but not
+// as moved bytes, since the allocator may resize in place.
+struct growth_stats {
+  std::size_t reallocations = 0;
+  std::size_t bytes_moved = 0;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_MEMORY_H_
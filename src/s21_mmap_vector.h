@@ -0,0 +1,401 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_MMAP_VECTOR_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_MMAP_VECTOR_H_
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+// Vector of trivially copyable elements stored in a file through a shared
+// memory mapping. Opening maps the file without reading it, so the cost
+// does not depend on the file size; pages are read on first access.
+// Appending grows the file with ftruncate and the mapping with mremap
+// (munmap + mmap where mremap is missing). The file is kept at capacity()
+// elements while open and cut back to size() elements by flush(), close()
+// or the destructor, so a file that was flushed reopens with the size it
+// had then even if it was never closed. Changes reach the disk at the
+// kernel's pace, or when flush() is called.
+//
+// A vector opened with mode::read_only maps the file read-only: the
+// modifying members throw std::logic_error, and writing through data() or
+// operator[] faults.
+template <class T>
+class mmap_vector {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "mmap_vector stores elements as raw file bytes");
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = T *;
+  using const_iterator = const T *;
+  using size_type = std::size_t;
+
+  enum class mode { read_only, read_write };
+
+  // Expected access pattern, passed on to madvise.
+  enum class access { normal, sequential, random, will_need };
+
+  mmap_vector() noexcept = default;
+
+  // Opens path; with mode::read_write a missing file is created empty.
+  explicit mmap_vector(const std::string &path, mode m = mode::read_write) {
+    open(path, m);
+  }
+
+  mmap_vector(const mmap_vector &) = delete;
+  mmap_vector &operator=(const mmap_vector &) = delete;
+
+  mmap_vector(mmap_vector &&other) noexcept { StealFrom_(other); }
+
+  mmap_vector &operator=(mmap_vector &&other) {
+    if (this != &other) {
+      close();
+      StealFrom_(other);
+    }
+    return *this;
+  }
+
+  ~mmap_vector() { Close_(); }
+
+  void open(const std::string &path, mode m = mode::read_write) {
+    close();
+    int flags = m == mode::read_only ? O_RDONLY : O_RDWR | O_CREAT;
+    int fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      Fail_("mmap_vector: open");
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(),
+                              "mmap_vector: fstat");
+    }
+    size_type bytes = static_cast<size_type>(st.st_size);
+    if (bytes % sizeof(value_type) != 0) {
+      ::close(fd);
+      throw std::runtime_error(
+          "mmap_vector: file size is not a multiple of the element size");
+    }
+    fd_ = fd;
+    writable_ = m == mode::read_write;
+    if (bytes != 0) {
+      void *p = mmap(nullptr, bytes, Protection_(), MAP_SHARED, fd_, 0);
+      if (p == MAP_FAILED) {
+        int error = errno;
+        Close_();
+        throw std::system_error(error, std::generic_category(),
+                                "mmap_vector: mmap");
+      }
+      data_ = static_cast<T *>(p);
+    }
+    size_ = capacity_ = file_size_ = bytes / sizeof(value_type);
+  }
+
+  // Unmaps, truncates the file to size() elements and closes it.
+  void close() {
+    if (!Close_()) {
+      Fail_("mmap_vector: close");
+    }
+  }
+
+  bool is_open() const noexcept { return fd_ >= 0; }
+
+  bool is_writable() const noexcept { return writable_; }
+
+  reference at(size_type pos) {
+    if (pos >= size_) {
+      throw std::out_of_range("Out of bound exeption");
+    }
+    return data_[pos];
+  }
+
+  const_reference at(size_type pos) const {
+    return const_cast<mmap_vector *>(this)->at(pos);
+  }
+
+  reference operator[](size_type pos) { return data_[pos]; }
+
+  const_reference operator[](size_type pos) const { return data_[pos]; }
+
+  reference front() { return *data_; }
+
+  const_reference front() const { return *data_; }
+
+  reference back() { return data_[size_ - 1]; }
+
+  const_reference back() const { return data_[size_ - 1]; }
+
+  iterator data() noexcept { return data_; }
+
+  const_iterator data() const noexcept { return data_; }
+
+  iterator begin() noexcept { return data_; }
+
+  const_iterator begin() const noexcept { return data_; }
+
+  iterator end() noexcept { return data_ + size_; }
+
+  const_iterator end() const noexcept { return data_ + size_; }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type capacity() const noexcept { return capacity_; }
+
+  size_type max_size() const noexcept {
+    return std::numeric_limits<off_t>::max() / sizeof(value_type);
+  }
+
+  void reserve(size_type size) {
+    RequireWritable_();
+    if (size > capacity_) {
+      Remap_(PageRounded_(size));
+    }
+  }
+
+  void push_back(const_reference value) { emplace_back(value); }
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    RequireWritable_();
+    if (size_ == capacity_) {
+      // args may refer to an element, which the remap below can move.
+      value_type tmp(std::forward<Args>(args)...);
+      Remap_(GrowCapacity_(size_ + 1));
+      return *::new (static_cast<void *>(data_ + size_++)) T(tmp);
+    }
+    CoverInFile_(size_ + 1);
+    return *::new (static_cast<void *>(data_ + size_++))
+        T(std::forward<Args>(args)...);
+  }
+
+  void pop_back() {
+    RequireWritable_();
+    --size_;
+  }
+
+  void resize(size_type count, const_reference value = value_type()) {
+    RequireWritable_();
+    if (count > capacity_) {
+      value_type tmp(value);
+      Remap_(GrowCapacity_(count));
+      std::uninitialized_fill(data_ + size_, data_ + count, tmp);
+    } else if (count > size_) {
+      CoverInFile_(count);
+      std::uninitialized_fill(data_ + size_, data_ + count, value);
+    }
+    size_ = count;
+  }
+
+  void clear() {
+    RequireWritable_();
+    size_ = 0;
+  }
+
+  // Shrinks the mapping and the file to size() elements.
+  void shrink_to_fit() {
+    RequireWritable_();
+    if (size_ < capacity_) {
+      Remap_(size_);
+    }
+  }
+
+  // Cuts the file to size() elements and writes the dirty pages back to
+  // it; blocks until they are on disk unless async is set. The file grows
+  // back to capacity() on the next append past size().
+  void flush(bool async = false) {
+    RequireWritable_();
+    if (file_size_ != size_) {
+      if (ftruncate(fd_, size_ * sizeof(value_type)) != 0) {
+        Fail_("mmap_vector: ftruncate");
+      }
+      file_size_ = size_;
+    }
+    if (size_ != 0 && msync(data_, size_ * sizeof(value_type),
+                            async ? MS_ASYNC : MS_SYNC) != 0) {
+      Fail_("mmap_vector: msync");
+    }
+  }
+
+  // Tells the kernel how the data will be read, e.g. access::sequential
+  // for a full scan (aggressive read-ahead) or access::random for lookups
+  // (no read-ahead). The hint is kept across later growth.
+  void advise(access pattern) {
+    advice_ = pattern;
+    if (data_ != nullptr && !Advise_()) {
+      Fail_("mmap_vector: madvise");
+    }
+  }
+
+  void swap(mmap_vector &other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(file_size_, other.file_size_);
+    std::swap(fd_, other.fd_);
+    std::swap(writable_, other.writable_);
+    std::swap(advice_, other.advice_);
+  }
+
+ private:
+  [[noreturn]] static void Fail_(const char *what) {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+
+  static size_type PageSize_() noexcept {
+    static const size_type page = sysconf(_SC_PAGESIZE);
+    return page;
+  }
+
+  // Largest capacity whose byte size is the page-rounded size of count
+  // elements, so the last mapped page is not wasted.
+  static size_type PageRounded_(size_type count) noexcept {
+    size_type page = PageSize_();
+    size_type bytes = (count * sizeof(value_type) + page - 1) / page * page;
+    return bytes / sizeof(value_type);
+  }
+
+  size_type GrowCapacity_(size_type required) const {
+    if (required > max_size()) {
+      throw std::length_error("mmap_vector capacity exceeds max_size");
+    }
+    return PageRounded_(std::max(capacity_ * 2, required));
+  }
+
+  int Protection_() const noexcept {
+    return writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+  }
+
+  void RequireWritable_() const {
+    if (!writable_) {
+      throw std::logic_error("mmap_vector is read-only");
+    }
+  }
+
+  bool Advise_() noexcept {
+    static constexpr int kAdvice[] = {MADV_NORMAL, MADV_SEQUENTIAL,
+                                      MADV_RANDOM, MADV_WILLNEED};
+    return madvise(static_cast<void *>(data_),
+                   capacity_ * sizeof(value_type),
+                   kAdvice[static_cast<int>(advice_)]) == 0;
+  }
+
+  // Grows the file back to capacity() once elements up to count would
+  // lie past its end, which they can after flush() cut it to size().
+  void CoverInFile_(size_type count) {
+    if (count > file_size_) {
+      if (ftruncate(fd_, capacity_ * sizeof(value_type)) != 0) {
+        Fail_("mmap_vector: ftruncate");
+      }
+      file_size_ = capacity_;
+    }
+  }
+
+  // Resizes the file and the mapping to new_capacity elements. The file
+  // grows before the mapping and shrinks after it, so no mapped page
+  // that holds an element is ever past the end of the file.
+  void Remap_(size_type new_capacity) {
+    size_type old_bytes = capacity_ * sizeof(value_type);
+    size_type new_bytes = new_capacity * sizeof(value_type);
+    size_type file_bytes = file_size_ * sizeof(value_type);
+    if (new_bytes > file_bytes && ftruncate(fd_, new_bytes) != 0) {
+      Fail_("mmap_vector: ftruncate");
+    }
+    void *p = nullptr;
+    if (new_bytes == 0) {
+      munmap(static_cast<void *>(data_), old_bytes);
+    } else if (data_ == nullptr) {
+      p = mmap(nullptr, new_bytes, Protection_(), MAP_SHARED, fd_, 0);
+    } else {
+#if defined(__linux__)
+      p = mremap(static_cast<void *>(data_), old_bytes, new_bytes,
+                 MREMAP_MAYMOVE);
+#else
+      // The old mapping stays until the new one exists, so a failure
+      // leaves the vector as it was.
+      p = mmap(nullptr, new_bytes, Protection_(), MAP_SHARED, fd_, 0);
+      if (p != MAP_FAILED) {
+        munmap(static_cast<void *>(data_), old_bytes);
+      }
+#endif
+    }
+    if (p == MAP_FAILED) {
+      int error = errno;
+      if (new_bytes > file_bytes) {
+        (void)!ftruncate(fd_, file_bytes);
+      }
+      throw std::system_error(error, std::generic_category(),
+                              "mmap_vector: mremap");
+    }
+    data_ = static_cast<T *>(p);
+    capacity_ = new_capacity;
+    if (new_bytes < file_bytes && ftruncate(fd_, new_bytes) != 0) {
+      Fail_("mmap_vector: ftruncate");
+    }
+    file_size_ = new_capacity;
+    if (data_ != nullptr && advice_ != access::normal) {
+      Advise_();
+    }
+  }
+
+  bool Close_() noexcept {
+    bool ok = true;
+    if (data_ != nullptr) {
+      ok = munmap(static_cast<void *>(data_),
+                  capacity_ * sizeof(value_type)) == 0;
+    }
+    if (fd_ >= 0) {
+      if (writable_ && file_size_ != size_) {
+        ok = ftruncate(fd_, size_ * sizeof(value_type)) == 0 && ok;
+      }
+      ok = ::close(fd_) == 0 && ok;
+    }
+    data_ = nullptr;
+    size_ = capacity_ = file_size_ = 0;
+    fd_ = -1;
+    writable_ = false;
+    advice_ = access::normal;
+    return ok;
+  }
+
+  void StealFrom_(mmap_vector &other) noexcept {
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    capacity_ = std::exchange(other.capacity_, 0);
+    file_size_ = std::exchange(other.file_size_, 0);
+    fd_ = std::exchange(other.fd_, -1);
+    writable_ = std::exchange(other.writable_, false);
+    advice_ = std::exchange(other.advice_, access::normal);
+  }
+
+  T *data_ = nullptr;
+  size_type size_ = 0;
+  size_type capacity_ = 0;
+  // Elements the file has room for: capacity_, or size_ after flush().
+  size_type file_size_ = 0;
+  int fd_ = -1;
+  bool writable_ = false;
+  access advice_ = access::normal;
+};
+}  // namespace s21
+
+#endif  // defined(__unix__) || defined(__APPLE__)
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_MMAP_VECTOR_H_
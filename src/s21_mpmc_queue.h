@@ -0,0 +1,324 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_MPMC_QUEUE_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_MPMC_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "s21_memory.h"
+
+namespace s21 {
+// Bounded lock-free FIFO for any number of producer and consumer threads,
+// after Dmitry Vyukov's bounded MPMC queue. Every slot carries a sequence
+// number that says whose turn it is: a slot at position pos is free for
+// the producer of pos when its sequence is pos, and holds the element for
+// the consumer of pos when it is pos + 1. Producers and consumers claim
+// positions with one CAS on their own counter, so neither side takes a
+// lock, and each slot has a cache line to itself.
+//
+// try_push/try_pop never block. push/emplace/pop spin briefly, then park
+// on a condition variable until the other side makes room or data; the
+// mutex is touched only when some thread is parked. Element semantics
+// follow s21::queue: values are moved in and out, and pop(out) replaces
+// the front()/pop() pair, which cannot be made safe with several consumers.
+template <class T>
+class mpmc_queue {
+  // A claimed position cannot be given back, so nothing that runs between
+  // claiming it and publishing it may throw.
+  static_assert(std::is_nothrow_move_constructible_v<T> &&
+                    std::is_nothrow_move_assignable_v<T>,
+                "mpmc_queue elements must be nothrow movable");
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+
+  // Capacity is rounded up to a power of two, at least 2.
+  explicit mpmc_queue(size_type capacity) {
+    capacity_ = 2;
+    while (capacity_ < capacity) {
+      capacity_ *= 2;
+    }
+    slots_.reset(new Slot_[capacity_]);
+    for (size_type i = 0; i < capacity_; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  mpmc_queue(const mpmc_queue &) = delete;
+  mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+  ~mpmc_queue() {
+    size_type tail = tail_.value.load(std::memory_order_relaxed);
+    for (size_type pos = head_.value.load(std::memory_order_relaxed);
+         pos != tail; ++pos) {
+      Element_(slots_[pos & (capacity_ - 1)])->~T();
+    }
+  }
+
+  bool try_push(const_reference value) {
+    value_type copy(value);
+    return TryPush_(copy);
+  }
+
+  // Leaves value untouched when the queue is full.
+  bool try_push(value_type &&value) { return TryPush_(value); }
+
+  // Builds the element, then moves it in; returns false if the queue is
+  // full. A throwing constructor leaves the queue untouched.
+  template <typename... Args>
+  bool try_emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return TryPush_(value);
+  }
+
+  // Moves the oldest element into out; returns false if the queue is empty.
+  bool try_pop(reference out) {
+    size_type pos = head_.value.load(std::memory_order_relaxed);
+    Slot_ *slot;
+    while (true) {
+      slot = &slots_[pos & (capacity_ - 1)];
+      size_type sequence = slot->sequence.load(std::memory_order_acquire);
+      auto lag = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+      if (lag == 0) {
+        if (head_.value.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (lag < 0) {
+        return false;
+      } else {
+        pos = head_.value.load(std::memory_order_relaxed);
+      }
+    }
+    Release_(slot, pos, out);
+    WakeIfParked_(push_parked_, not_full_);
+    return true;
+  }
+
+  // Copies up to n elements from first into consecutive positions claimed
+  // with a single CAS; returns how many were pushed. A claimed position
+  // cannot be given back, so when T's copy constructor may throw, each
+  // element is copied first and pushed on its own; an exception then
+  // propagates with the earlier elements pushed and no slot claimed.
+  size_type try_push(const T *first, size_type n) {
+    if constexpr (!std::is_nothrow_copy_constructible_v<T>) {
+      size_type pushed = 0;
+      for (; pushed < n; ++pushed) {
+        value_type copy(first[pushed]);
+        if (!TryPush_(copy)) {
+          break;
+        }
+      }
+      return pushed;
+    }
+    size_type pos = tail_.value.load(std::memory_order_relaxed);
+    size_type claimed = 0;
+    while (true) {
+      claimed = 0;
+      while (claimed < n && Sequence_(pos + claimed) == pos + claimed) {
+        ++claimed;
+      }
+      if (claimed == 0) {
+        if (n == 0 || static_cast<std::ptrdiff_t>(Sequence_(pos) - pos) < 0) {
+          return 0;
+        }
+        pos = tail_.value.load(std::memory_order_relaxed);
+      } else if (tail_.value.compare_exchange_weak(
+                     pos, pos + claimed, std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    for (size_type i = 0; i < claimed; ++i) {
+      Slot_ &slot = slots_[(pos + i) & (capacity_ - 1)];
+      ::new (static_cast<void *>(slot.storage)) T(first[i]);
+      slot.sequence.store(pos + i + 1, std::memory_order_release);
+    }
+    WakeIfParked_(pop_parked_, not_empty_);
+    return claimed;
+  }
+
+  // Moves up to n of the oldest elements into out, claimed with a single
+  // CAS; returns how many were popped.
+  size_type try_pop(T *out, size_type n) {
+    size_type pos = head_.value.load(std::memory_order_relaxed);
+    size_type claimed = 0;
+    while (true) {
+      claimed = 0;
+      while (claimed < n && Sequence_(pos + claimed) == pos + claimed + 1) {
+        ++claimed;
+      }
+      if (claimed == 0) {
+        if (n == 0 ||
+            static_cast<std::ptrdiff_t>(Sequence_(pos) - (pos + 1)) < 0) {
+          return 0;
+        }
+        pos = head_.value.load(std::memory_order_relaxed);
+      } else if (head_.value.compare_exchange_weak(
+                     pos, pos + claimed, std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    for (size_type i = 0; i < claimed; ++i) {
+      Release_(&slots_[(pos + i) & (capacity_ - 1)], pos + i, out[i]);
+    }
+    WakeIfParked_(push_parked_, not_full_);
+    return claimed;
+  }
+
+  // Blocking forms: wait while the queue is full (push) or empty (pop).
+  void push(const_reference value) { emplace(value); }
+
+  void push(value_type &&value) { emplace(std::move(value)); }
+
+  template <typename... Args>
+  void emplace(Args &&...args) {
+    // The element is built once, so args are not consumed by a failed try.
+    value_type value(std::forward<Args>(args)...);
+    Wait_(
+        push_parked_, not_full_, [&] { return TryPush_(value); },
+        [this] { return CanPush_(); });
+  }
+
+  void pop(reference out) {
+    Wait_(
+        pop_parked_, not_empty_, [&] { return try_pop(out); },
+        [this] { return CanPop_(); });
+  }
+
+  // A snapshot; exact only while no other thread is pushing or popping.
+  size_type size() const noexcept {
+    size_type head = head_.value.load(std::memory_order_acquire);
+    size_type tail = tail_.value.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  size_type capacity() const noexcept { return capacity_; }
+
+ private:
+  static constexpr int kSpins_ = 64;
+
+  struct alignas(cache_line_size) Slot_ {
+    std::atomic<size_type> sequence;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  // Counter of one side with a cache line to itself.
+  struct alignas(cache_line_size) Position_ {
+    std::atomic<size_type> value{0};
+  };
+
+  // Claims the tail position and moves value into its slot; value is
+  // moved from only on success.
+  bool TryPush_(value_type &value) {
+    size_type pos = tail_.value.load(std::memory_order_relaxed);
+    Slot_ *slot;
+    while (true) {
+      slot = &slots_[pos & (capacity_ - 1)];
+      size_type sequence = slot->sequence.load(std::memory_order_acquire);
+      auto lag = static_cast<std::ptrdiff_t>(sequence - pos);
+      if (lag == 0) {
+        if (tail_.value.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (lag < 0) {
+        return false;
+      } else {
+        pos = tail_.value.load(std::memory_order_relaxed);
+      }
+    }
+    ::new (static_cast<void *>(slot->storage)) T(std::move(value));
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    WakeIfParked_(pop_parked_, not_empty_);
+    return true;
+  }
+
+  static T *Element_(Slot_ &slot) noexcept {
+    return std::launder(reinterpret_cast<T *>(slot.storage));
+  }
+
+  size_type Sequence_(size_type pos) const noexcept {
+    return slots_[pos & (capacity_ - 1)].sequence.load(
+        std::memory_order_acquire);
+  }
+
+  // Moves the element at claimed position pos out and hands the slot to
+  // the producer of pos + capacity.
+  void Release_(Slot_ *slot, size_type pos, reference out) {
+    T *value = Element_(*slot);
+    out = std::move(*value);
+    value->~T();
+    slot->sequence.store(pos + capacity_, std::memory_order_release);
+  }
+
+  // True when the slot at the head holds an element (or the head has
+  // moved on), so a try_pop is worth retrying; reads only.
+  bool CanPop_() const noexcept {
+    size_type pos = head_.value.load(std::memory_order_relaxed);
+    return static_cast<std::ptrdiff_t>(Sequence_(pos) - (pos + 1)) >= 0;
+  }
+
+  bool CanPush_() const noexcept {
+    size_type pos = tail_.value.load(std::memory_order_relaxed);
+    return static_cast<std::ptrdiff_t>(Sequence_(pos) - pos) >= 0;
+  }
+
+  // Spins on attempt, then parks on ready until probe says another attempt
+  // may succeed. The parked count is raised under the mutex before the
+  // probe, and the other side reads it after publishing (WakeIfParked_),
+  // with a full fence on both sides, so either the probe sees the change
+  // or the notify finds this thread waiting. attempt runs unlocked since a
+  // success wakes the other side through the same mutex.
+  template <class Attempt, class Probe>
+  void Wait_(std::atomic<int> &parked, std::condition_variable &ready,
+             Attempt &&attempt, Probe &&probe) {
+    int spins = 0;
+    while (!attempt()) {
+      if (spins < kSpins_) {
+        ++spins;
+        internal::CpuRelax();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex_);
+      parked.fetch_add(1, std::memory_order_relaxed);
+      internal::FullFence();
+      while (!probe()) {
+        ready.wait(lock);
+      }
+      parked.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  void WakeIfParked_(std::atomic<int> &parked,
+                     std::condition_variable &ready) {
+    internal::FullFence();
+    if (parked.load(std::memory_order_relaxed) != 0) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ready.notify_all();
+    }
+  }
+
+  Position_ tail_;
+  Position_ head_;
+  std::unique_ptr<Slot_[]> slots_;
+  size_type capacity_ = 0;
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::atomic<int> push_parked_{0};
+  std::atomic<int> pop_parked_{0};
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_MPMC_QUEUE_H_
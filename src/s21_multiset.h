@@ -2,21 +2,29 @@
 #ifndef CPP2_S21_CONTAINERS_SRC_S21_MULTISET_H_
 #define CPP2_S21_CONTAINERS_SRC_S21_MULTISET_H_
 
+#include <memory>
+#include <memory_resource>
 #include <utility>
 
 #include "s21_map.h"
 
 namespace s21 {
 
-template <typename Key>
+template <typename Key, typename Allocator = std::allocator<Key>>
 class multiset;
 
-template <typename T>
+template <typename Key, typename Allocator>
+using MultisetCounter = s21::map<
+    Key, size_t, std::less<Key>,
+    typename std::allocator_traits<Allocator>::template rebind_alloc<
+        std::pair<const Key, size_t>>>;
+
+template <typename T, typename Allocator = std::allocator<T>>
 class MultisetIterator {
-  friend class multiset<T>;
+  friend class multiset<T, Allocator>;
 
  public:
-  MultisetIterator<T>& operator++() {
+  MultisetIterator& operator++() {
     if ((*iter).second > current_count_) {
       current_count_++;
     } else {
@@ -26,7 +34,7 @@ class MultisetIterator {
     return *this;
   }
 
-  MultisetIterator<T>& operator--() {
+  MultisetIterator& operator--() {
     if (current_count_ > 1) {
       current_count_--;
     } else {
@@ -38,29 +46,31 @@ class MultisetIterator {
 
   T& operator*() { return (*iter).first; }
 
-  bool operator==(const MultisetIterator<T>& other) const {
+  bool operator==(const MultisetIterator& other) const {
     return ((iter == other.iter) && (current_count_ == other.current_count_));
   }
 
-  bool operator!=(const MultisetIterator<T>& other) const {
+  bool operator!=(const MultisetIterator& other) const {
     return ((iter != other.iter) || (current_count_ != other.current_count_));
   }
 
  private:
-  typename s21::map<T, size_t>::iterator iter;
+  typename MultisetCounter<T, Allocator>::iterator iter;
   size_t current_count_;
-  explicit MultisetIterator<T>(typename s21::map<T, size_t>::iterator it)
+  explicit MultisetIterator(
+      typename MultisetCounter<T, Allocator>::iterator it)
       : iter(it), current_count_(1ul) {}
-  MultisetIterator<T>(typename s21::map<T, size_t>::iterator it, size_t count)
+  MultisetIterator(typename MultisetCounter<T, Allocator>::iterator it,
+                   size_t count)
       : iter(it), current_count_(count) {}
 };
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class MultisetConstIterator {
-  friend class multiset<T>;
+  friend class multiset<T, Allocator>;
 
  public:
-  MultisetConstIterator<T>& operator++() {
+  MultisetConstIterator& operator++() {
     if ((*iter).second > current_count_) {
       current_count_++;
     } else {
@@ -70,7 +80,7 @@ class MultisetConstIterator {
     return *this;
   }
 
-  MultisetConstIterator<T>& operator--() {
+  MultisetConstIterator& operator--() {
     if (current_count_ > 1) {
       current_count_--;
     } else {
@@ -82,36 +92,42 @@ class MultisetConstIterator {
 
   T& operator*() { return (*iter).first; }
 
-  bool operator==(const MultisetConstIterator<T>& other) const {
+  bool operator==(const MultisetConstIterator& other) const {
     return ((iter == other.iter) && (current_count_ == other.current_count_));
   }
 
-  bool operator!=(const MultisetConstIterator<T>& other) const {
+  bool operator!=(const MultisetConstIterator& other) const {
     return ((iter != other.iter) || (current_count_ != other.current_count_));
   }
 
  private:
-  typename s21::map<T, size_t>::const_iterator iter;
+  typename MultisetCounter<T, Allocator>::const_iterator iter;
   size_t current_count_;
-  explicit MultisetConstIterator<T>(
-      typename s21::map<T, size_t>::const_iterator it)
+  explicit MultisetConstIterator(
+      typename MultisetCounter<T, Allocator>::const_iterator it)
       : iter(it), current_count_(1ul) {}
-  MultisetConstIterator<T>(typename s21::map<T, size_t>::const_iterator it,
-                           size_t count)
+  MultisetConstIterator(
+      typename MultisetCounter<T, Allocator>::const_iterator it, size_t count)
       : iter(it), current_count_(count) {}
 };
 
-template <typename Key>
+template <typename Key, typename Allocator>
 class multiset {
  public:
   using value_type = Key;
   using size_type = size_t;
-  using iterator = MultisetIterator<Key>;
-  using const_iterator = MultisetConstIterator<Key>;
+  using allocator_type = Allocator;
+  using iterator = MultisetIterator<Key, Allocator>;
+  using const_iterator = MultisetConstIterator<Key, Allocator>;
 
   multiset() : counter_(), size_() {}
 
-  multiset(std::initializer_list<value_type> const& items) : multiset() {
+  explicit multiset(const Allocator& alloc)
+      : counter_(typename Counter_::allocator_type(alloc)), size_() {}
+
+  multiset(std::initializer_list<value_type> const& items,
+           const Allocator& alloc = Allocator())
+      : multiset(alloc) {
     for (const auto& item : items) {
       insert(item);
     }
@@ -152,6 +168,10 @@ class multiset {
     return const_iterator(counter_.end(), 1lu);
   }
 
+  allocator_type get_allocator() const {
+    return allocator_type(counter_.get_allocator());
+  }
+
   bool empty() const { return counter_.empty(); }
 
   size_type size() const { return size_; }
@@ -163,15 +183,13 @@ class multiset {
     size_ = 0;
   }
 
-  iterator insert(const value_type& value) {
-    auto it = counter_.find(value);
-    if (it != counter_.end()) {
-      ++((*it).second);
-    } else {
-      it = (counter_.insert({value, 1})).first;
-    }
-    ++size_;
-    return iterator(it, (*it).second);
+  iterator insert(const value_type& value) { return Insert_(value); }
+
+  iterator insert(value_type&& value) { return Insert_(std::move(value)); }
+
+  template <class... Args>
+  iterator emplace(Args&&... args) {
+    return Insert_(value_type(std::forward<Args>(args)...));
   }
 
   void erase(iterator pos) {
@@ -230,10 +248,25 @@ class multiset {
   }
 
  private:
-  s21::map<Key, size_t> counter_;
+  using Counter_ = MultisetCounter<Key, Allocator>;
+
+  template <class V>
+  iterator Insert_(V&& value) {
+    auto it = counter_.try_emplace(std::forward<V>(value), 0).first;
+    ++((*it).second);
+    ++size_;
+    return iterator(it, (*it).second);
+  }
+
+  Counter_ counter_;
   size_type size_;
 };
 
+namespace pmr {
+template <typename Key>
+using multiset = s21::multiset<Key, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
+
 }  // namespace s21
 
 #endif  // CPP2_S21_CONTAINERS_SRC_S21_MULTISET_H_
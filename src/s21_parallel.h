@@ -0,0 +1,392 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_PARALLEL_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_PARALLEL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "s21_task_pool.h"
+#include "s21_vector.h"
+
+// Parallel versions of sort, stable_sort, transform, reduce,
+// inclusive_scan, for_each, fill, copy, uninitialized_fill and
+// uninitialized_copy over random access ranges such as s21::vector and
+// s21::array. Every call takes a policy naming the
+// s21::task_pool and the grain (elements per task); inputs of at most one
+// grain run serially on the calling thread.
+namespace s21 {
+namespace parallel {
+struct policy {
+  task_pool *pool = nullptr;  // nullptr selects default_task_pool()
+  std::size_t grain = 0;      // 0 picks a grain from the input size
+};
+
+inline constexpr policy par{};
+
+namespace internal {
+// Below this many elements per task, queueing costs more than it saves.
+inline constexpr std::size_t kMinGrain = 4096;
+
+inline task_pool &PoolOf(const policy &pol) {
+  return pol.pool != nullptr ? *pol.pool : default_task_pool();
+}
+
+inline std::size_t ChunkCount(const policy &pol, std::size_t n) {
+  if (n == 0) {
+    return 0;
+  }
+  std::size_t threads = PoolOf(pol).size() + 1;
+  std::size_t grain = pol.grain;
+  if (grain == 0) {
+    grain = std::max(kMinGrain, (n + 4 * threads - 1) / (4 * threads));
+  }
+  return (n + grain - 1) / grain;
+}
+
+// Start of chunk c when n elements are split into chunks of near-equal
+// size.
+inline std::size_t ChunkBegin(std::size_t n, std::size_t chunks,
+                              std::size_t c) {
+  return n * c / chunks;
+}
+
+// Runs fn(c) for every c in [0, chunks) as one task each, through
+// task_pool::parallel_for. The caller runs tasks while it waits, and the
+// first exception thrown by fn is rethrown once every chunk has finished.
+//
+// Which worker runs a chunk is up to the work stealing, so a chunk is not
+// tied to one thread from call to call. On a NUMA machine that matters
+// only where a page is first written: the kernel places it on the node of
+// the thread that touches it first. Output that already exists, such as
+// an s21::vector sized by its constructor, was touched serially, so fill,
+// copy and the rest leave its placement alone; uninitialized_fill and
+// uninitialized_copy into freshly allocated storage spread the pages over
+// the nodes of the workers that built them.
+template <class Fn>
+void RunChunks(task_pool &pool, std::size_t chunks, Fn &&fn) {
+  if (chunks <= 1) {
+    if (chunks == 1) {
+      fn(std::size_t{0});
+    }
+    return;
+  }
+  pool.parallel_for(0, chunks, 1, [&](std::size_t b, std::size_t e) {
+    for (std::size_t c = b; c < e; ++c) {
+      fn(c);
+    }
+  });
+}
+
+// Calls fn(begin, end) on index ranges that split [0, n) per the policy.
+template <class Fn>
+void ForEachChunk(const policy &pol, std::size_t n, Fn &&fn) {
+  std::size_t chunks = ChunkCount(pol, n);
+  RunChunks(PoolOf(pol), chunks, [&](std::size_t c) {
+    fn(ChunkBegin(n, chunks, c), ChunkBegin(n, chunks, c + 1));
+  });
+}
+
+// Runs build(begin, end) on the chunks of [0, n), each of which constructs
+// elements in raw storage. If any chunk throws, the chunks that finished
+// are torn down with destroy(begin, end) before the exception propagates.
+template <class Build, class Destroy>
+void ConstructChunks(const policy &pol, std::size_t n, Build &&build,
+                     Destroy &&destroy) {
+  std::size_t chunks = ChunkCount(pol, n);
+  s21::vector<char> built(chunks);
+  try {
+    RunChunks(PoolOf(pol), chunks, [&](std::size_t c) {
+      build(ChunkBegin(n, chunks, c), ChunkBegin(n, chunks, c + 1));
+      built[c] = 1;
+    });
+  } catch (...) {
+    for (std::size_t c = 0; c < chunks; ++c) {
+      if (built[c]) {
+        destroy(ChunkBegin(n, chunks, c), ChunkBegin(n, chunks, c + 1));
+      }
+    }
+    throw;
+  }
+}
+
+// Merges adjacent sorted runs of src (boundaries in bounds) pairwise into
+// dst. Each pair is cut into several independent merges at split points
+// found by binary search, so the last rounds still use every thread.
+template <class Src, class Dst, class Compare>
+void MergeRound(task_pool &pool, Src src, Dst dst,
+                const s21::vector<std::size_t> &bounds, Compare comp) {
+  struct Piece {
+    std::size_t a_begin, a_end, b_begin, b_end, out;
+  };
+  std::size_t runs = bounds.size() - 1;
+  std::size_t pairs = runs / 2;
+  std::size_t parts = std::max<std::size_t>(1, (pool.size() + 1) / pairs);
+  s21::vector<Piece> pieces;
+  for (std::size_t r = 0; r + 1 < runs; r += 2) {
+    std::size_t a0 = bounds[r], a1 = bounds[r + 1], b1 = bounds[r + 2];
+    std::size_t prev_a = a0, prev_b = a1;
+    for (std::size_t p = 1; p <= parts; ++p) {
+      std::size_t a = p == parts ? a1 : a0 + (a1 - a0) * p / parts;
+      std::size_t b = a == a1 ? b1
+                              : std::lower_bound(src + a1, src + b1,
+                                                 src[a], comp) -
+                                    src;
+      pieces.push_back({prev_a, a, prev_b, b, prev_a + prev_b - a1});
+      prev_a = a;
+      prev_b = b;
+    }
+  }
+  if (runs % 2 != 0) {
+    pieces.push_back({bounds[runs - 1], bounds[runs], bounds[runs],
+                      bounds[runs], bounds[runs - 1]});
+  }
+  RunChunks(pool, pieces.size(), [&](std::size_t i) {
+    const Piece &piece = pieces[i];
+    std::merge(std::make_move_iterator(src + piece.a_begin),
+               std::make_move_iterator(src + piece.a_end),
+               std::make_move_iterator(src + piece.b_begin),
+               std::make_move_iterator(src + piece.b_end), dst + piece.out,
+               comp);
+  });
+}
+
+// Sorts runs of the input into a scratch buffer with sort_run, one run
+// per thread, then merges them pairwise. Types whose move constructor may
+// throw are sorted serially, since a half-moved buffer could not be
+// cleaned up.
+template <class RandomIt, class Compare, class SortRun>
+void MergeSort(const policy &pol, RandomIt first, RandomIt last,
+               Compare comp, SortRun sort_run) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  std::size_t n = last - first;
+  task_pool &pool = PoolOf(pol);
+  std::size_t runs = std::min(ChunkCount(pol, n), pool.size() + 1);
+  if (runs <= 1 || !std::is_nothrow_move_constructible_v<T>) {
+    sort_run(first, last, comp);
+    return;
+  }
+  std::allocator<T> alloc;
+  T *buffer = alloc.allocate(n);
+  s21::vector<std::size_t> bounds;
+  for (std::size_t r = 0; r <= runs; ++r) {
+    bounds.push_back(ChunkBegin(n, runs, r));
+  }
+  bool in_buffer = true;
+  try {
+    RunChunks(pool, runs, [&](std::size_t r) {
+      std::uninitialized_move(first + bounds[r], first + bounds[r + 1],
+                              buffer + bounds[r]);
+      sort_run(buffer + bounds[r], buffer + bounds[r + 1], comp);
+    });
+    while (bounds.size() > 2) {
+      if (in_buffer) {
+        MergeRound(pool, buffer, first, bounds, comp);
+      } else {
+        MergeRound(pool, first, buffer, bounds, comp);
+      }
+      in_buffer = !in_buffer;
+      s21::vector<std::size_t> merged;
+      for (std::size_t i = 0; i < bounds.size(); i += 2) {
+        merged.push_back(bounds[i]);
+      }
+      if (merged.back() != n) {
+        merged.push_back(n);
+      }
+      bounds.swap(merged);
+    }
+    if (in_buffer) {
+      ForEachChunk(pol, n, [&](std::size_t b, std::size_t e) {
+        std::move(buffer + b, buffer + e, first + b);
+      });
+    }
+  } catch (...) {
+    std::destroy(buffer, buffer + n);
+    alloc.deallocate(buffer, n);
+    throw;
+  }
+  std::destroy(buffer, buffer + n);
+  alloc.deallocate(buffer, n);
+}
+}  // namespace internal
+
+template <class RandomIt, class Fn>
+void for_each(const policy &pol, RandomIt first, RandomIt last, Fn fn) {
+  internal::ForEachChunk(pol, last - first,
+                         [&](std::size_t b, std::size_t e) {
+                           std::for_each(first + b, first + e, fn);
+                         });
+}
+
+template <class RandomIt, class OutIt, class UnaryOp>
+OutIt transform(const policy &pol, RandomIt first, RandomIt last,
+                OutIt d_first, UnaryOp op) {
+  std::size_t n = last - first;
+  internal::ForEachChunk(pol, n, [&](std::size_t b, std::size_t e) {
+    std::transform(first + b, first + e, d_first + b, op);
+  });
+  return d_first + n;
+}
+
+template <class RandomIt1, class RandomIt2, class OutIt, class BinaryOp>
+OutIt transform(const policy &pol, RandomIt1 first1, RandomIt1 last1,
+                RandomIt2 first2, OutIt d_first, BinaryOp op) {
+  std::size_t n = last1 - first1;
+  internal::ForEachChunk(pol, n, [&](std::size_t b, std::size_t e) {
+    std::transform(first1 + b, first1 + e, first2 + b, d_first + b, op);
+  });
+  return d_first + n;
+}
+
+template <class RandomIt, class T>
+void fill(const policy &pol, RandomIt first, RandomIt last, const T &value) {
+  internal::ForEachChunk(pol, last - first,
+                         [&](std::size_t b, std::size_t e) {
+                           std::fill(first + b, first + e, value);
+                         });
+}
+
+template <class RandomIt, class OutIt>
+OutIt copy(const policy &pol, RandomIt first, RandomIt last, OutIt d_first) {
+  std::size_t n = last - first;
+  internal::ForEachChunk(pol, n, [&](std::size_t b, std::size_t e) {
+    std::copy(first + b, first + e, d_first + b);
+  });
+  return d_first + n;
+}
+
+// Constructs copies of value in the raw storage [first, last). On a
+// throw, every element already built is destroyed.
+template <class RandomIt, class T>
+void uninitialized_fill(const policy &pol, RandomIt first, RandomIt last,
+                        const T &value) {
+  internal::ConstructChunks(
+      pol, last - first,
+      [&](std::size_t b, std::size_t e) {
+        std::uninitialized_fill(first + b, first + e, value);
+      },
+      [&](std::size_t b, std::size_t e) {
+        std::destroy(first + b, first + e);
+      });
+}
+
+// Copy-constructs [first, last) into the raw storage at d_first. On a
+// throw, every element already built is destroyed.
+template <class RandomIt, class OutIt>
+OutIt uninitialized_copy(const policy &pol, RandomIt first, RandomIt last,
+                         OutIt d_first) {
+  std::size_t n = last - first;
+  internal::ConstructChunks(
+      pol, n,
+      [&](std::size_t b, std::size_t e) {
+        std::uninitialized_copy(first + b, first + e, d_first + b);
+      },
+      [&](std::size_t b, std::size_t e) {
+        std::destroy(d_first + b, d_first + e);
+      });
+  return d_first + n;
+}
+
+// op must be associative; partial results are combined in input order, so
+// it need not be commutative.
+template <class RandomIt, class T, class BinaryOp>
+T reduce(const policy &pol, RandomIt first, RandomIt last, T init,
+         BinaryOp op) {
+  std::size_t n = last - first;
+  std::size_t chunks = internal::ChunkCount(pol, n);
+  s21::vector<std::optional<T>> partial(chunks);
+  internal::RunChunks(internal::PoolOf(pol), chunks, [&](std::size_t c) {
+    std::size_t b = internal::ChunkBegin(n, chunks, c);
+    std::size_t e = internal::ChunkBegin(n, chunks, c + 1);
+    partial[c].emplace(
+        std::accumulate(first + b + 1, first + e, T(first[b]), op));
+  });
+  for (std::optional<T> &value : partial) {
+    init = op(std::move(init), std::move(*value));
+  }
+  return init;
+}
+
+template <class RandomIt, class T>
+T reduce(const policy &pol, RandomIt first, RandomIt last, T init) {
+  return parallel::reduce(pol, first, last, std::move(init), std::plus<>());
+}
+
+template <class RandomIt>
+typename std::iterator_traits<RandomIt>::value_type reduce(
+    const policy &pol, RandomIt first, RandomIt last) {
+  return parallel::reduce(
+      pol, first, last, typename std::iterator_traits<RandomIt>::value_type{});
+}
+
+// Two passes: per-chunk totals, then each chunk is scanned starting from
+// the sum of the chunks before it. d_first may equal first.
+template <class RandomIt, class OutIt, class BinaryOp>
+OutIt inclusive_scan(const policy &pol, RandomIt first, RandomIt last,
+                     OutIt d_first, BinaryOp op) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  std::size_t n = last - first;
+  std::size_t chunks = internal::ChunkCount(pol, n);
+  task_pool &pool = internal::PoolOf(pol);
+  s21::vector<std::optional<T>> offset(chunks);
+  internal::RunChunks(pool, chunks > 0 ? chunks - 1 : 0, [&](std::size_t c) {
+    std::size_t b = internal::ChunkBegin(n, chunks, c);
+    std::size_t e = internal::ChunkBegin(n, chunks, c + 1);
+    offset[c + 1].emplace(
+        std::accumulate(first + b + 1, first + e, T(first[b]), op));
+  });
+  for (std::size_t c = 2; c < chunks; ++c) {
+    offset[c] = op(std::move(*offset[c - 1]), std::move(*offset[c]));
+  }
+  internal::RunChunks(pool, chunks, [&](std::size_t c) {
+    std::size_t b = internal::ChunkBegin(n, chunks, c);
+    std::size_t e = internal::ChunkBegin(n, chunks, c + 1);
+    if (c == 0) {
+      std::inclusive_scan(first + b, first + e, d_first + b, op);
+    } else {
+      std::inclusive_scan(first + b, first + e, d_first + b, op,
+                          *offset[c]);
+    }
+  });
+  return d_first + n;
+}
+
+template <class RandomIt, class OutIt>
+OutIt inclusive_scan(const policy &pol, RandomIt first, RandomIt last,
+                     OutIt d_first) {
+  return parallel::inclusive_scan(pol, first, last, d_first, std::plus<>());
+}
+
+template <class RandomIt, class Compare>
+void sort(const policy &pol, RandomIt first, RandomIt last, Compare comp) {
+  internal::MergeSort(pol, first, last, comp,
+                      [](auto b, auto e, Compare c) { std::sort(b, e, c); });
+}
+
+template <class RandomIt>
+void sort(const policy &pol, RandomIt first, RandomIt last) {
+  parallel::sort(pol, first, last, std::less<>());
+}
+
+template <class RandomIt, class Compare>
+void stable_sort(const policy &pol, RandomIt first, RandomIt last,
+                 Compare comp) {
+  internal::MergeSort(
+      pol, first, last, comp,
+      [](auto b, auto e, Compare c) { std::stable_sort(b, e, c); });
+}
+
+template <class RandomIt>
+void stable_sort(const policy &pol, RandomIt first, RandomIt last) {
+  parallel::stable_sort(pol, first, last, std::less<>());
+}
+}  // namespace parallel
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_PARALLEL_H_
@@ -0,0 +1,371 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_PRIORITY_QUEUE_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_PRIORITY_QUEUE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_vector.h"
+
+namespace s21 {
+namespace internal {
+// Implicit d-ary heap over [first, first + n): the children of i are
+// i * Arity + 1 ... i * Arity + Arity, and no child ranks above its parent
+// under comp. Both sifts move a hole rather than swapping, and call
+// placed(i) each time an element lands at index i, which lets an indexed
+// heap keep its handle table current.
+template <std::size_t Arity, class RandomIt, class Compare, class Placed>
+void HeapSiftUp(RandomIt first, std::size_t pos, Compare &&comp,
+                Placed &&placed) {
+  auto value = std::move(first[pos]);
+  while (pos > 0) {
+    std::size_t parent = (pos - 1) / Arity;
+    if (!comp(first[parent], value)) {
+      break;
+    }
+    first[pos] = std::move(first[parent]);
+    placed(pos);
+    pos = parent;
+  }
+  first[pos] = std::move(value);
+  placed(pos);
+}
+
+template <std::size_t Arity, class RandomIt, class Compare, class Placed>
+void HeapSiftDown(RandomIt first, std::size_t n, std::size_t pos,
+                  Compare &&comp, Placed &&placed) {
+  auto value = std::move(first[pos]);
+  while (true) {
+    std::size_t child = pos * Arity + 1;
+    if (child >= n) {
+      break;
+    }
+    std::size_t best = child;
+    std::size_t last = std::min(child + Arity, n);
+    for (++child; child < last; ++child) {
+      if (comp(first[best], first[child])) {
+        best = child;
+      }
+    }
+    if (!comp(value, first[best])) {
+      break;
+    }
+    first[pos] = std::move(first[best]);
+    placed(pos);
+    pos = best;
+  }
+  first[pos] = std::move(value);
+  placed(pos);
+}
+
+// Floyd's bottom-up construction: O(n) compares.
+template <std::size_t Arity, class RandomIt, class Compare, class Placed>
+void MakeHeap(RandomIt first, std::size_t n, Compare &&comp,
+              Placed &&placed) {
+  if (n < 2) {
+    return;
+  }
+  for (std::size_t pos = (n - 2) / Arity + 1; pos-- > 0;) {
+    HeapSiftDown<Arity>(first, n, pos, comp, placed);
+  }
+}
+
+struct NoPlacement {
+  void operator()(std::size_t) const noexcept {}
+};
+}  // namespace internal
+
+// Adapter keeping Container (random access, with push_back, emplace_back
+// and pop_back) as an implicit d-ary heap, so top() is the element that
+// ranks highest under Compare, as with std::priority_queue. Arity 2 is a
+// binary heap; 4 halves the depth, and its children share a cache line
+// for small T, which usually makes pop() cheaper at the price of more
+// compares per level.
+template <class T, class Container = s21::vector<T>,
+          class Compare = std::less<typename Container::value_type>,
+          std::size_t Arity = 2>
+class priority_queue {
+  static_assert(Arity >= 2, "priority_queue arity must be at least 2");
+
+ public:
+  using container_type = Container;
+  using value_compare = Compare;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+
+  static constexpr size_type arity = Arity;
+
+  priority_queue() : priority_queue(Compare()) {}
+
+  explicit priority_queue(const Compare &comp) : container_(), comp_(comp) {}
+
+  // Heapifies container in O(n).
+  priority_queue(const Compare &comp, const Container &container)
+      : container_(container), comp_(comp) {
+    MakeHeap_();
+  }
+
+  priority_queue(const Compare &comp, Container &&container)
+      : container_(std::move(container)), comp_(comp) {
+    MakeHeap_();
+  }
+
+  template <class InputIt>
+  priority_queue(InputIt first, InputIt last, const Compare &comp = Compare())
+      : container_(), comp_(comp) {
+    push_many(first, last);
+  }
+
+  explicit priority_queue(std::initializer_list<value_type> const &items,
+                          const Compare &comp = Compare())
+      : priority_queue(items.begin(), items.end(), comp) {}
+
+  const_reference top() const { return container_.front(); }
+
+  bool empty() const { return container_.empty(); }
+
+  size_type size() const { return container_.size(); }
+
+  // Available when Container has reserve().
+  template <class C = Container>
+  auto reserve(size_type n) -> decltype(std::declval<C &>().reserve(n)) {
+    return container_.reserve(n);
+  }
+
+  void push(const_reference value) { emplace(value); }
+
+  void push(value_type &&value) { emplace(std::move(value)); }
+
+  template <typename... Args>
+  void emplace(Args &&...args) {
+    container_.emplace_back(std::forward<Args>(args)...);
+    internal::HeapSiftUp<Arity>(container_.begin(), container_.size() - 1,
+                                comp_, internal::NoPlacement());
+  }
+
+  // Appends [first, last). When that at least doubles the heap it is
+  // rebuilt bottom-up in O(n); otherwise each new element is sifted up,
+  // O(k log n) for k elements.
+  template <class InputIt>
+  void push_many(InputIt first, InputIt last) {
+    size_type old_size = container_.size();
+    for (; first != last; ++first) {
+      container_.push_back(*first);
+    }
+    size_type added = container_.size() - old_size;
+    if (added >= old_size) {
+      MakeHeap_();
+    } else {
+      for (size_type pos = old_size; pos < container_.size(); ++pos) {
+        internal::HeapSiftUp<Arity>(container_.begin(), pos, comp_,
+                                    internal::NoPlacement());
+      }
+    }
+  }
+
+  void pop() {
+    if (container_.size() > 1) {
+      container_.front() = std::move(container_.back());
+      container_.pop_back();
+      internal::HeapSiftDown<Arity>(container_.begin(), container_.size(), 0,
+                                    comp_, internal::NoPlacement());
+    } else {
+      container_.pop_back();
+    }
+  }
+
+  void swap(priority_queue &other) {
+    container_.swap(other.container_);
+    std::swap(comp_, other.comp_);
+  }
+
+ private:
+  void MakeHeap_() {
+    internal::MakeHeap<Arity>(container_.begin(), container_.size(), comp_,
+                              internal::NoPlacement());
+  }
+
+  Container container_;
+  Compare comp_;
+};
+
+// d-ary heap whose elements are addressed by handles, so an element can be
+// re-ranked or removed in O(log n) without a search: push() returns a
+// handle, and a table maps each live handle to its element's slot in the
+// heap, kept current as sifts move elements. A handle stays valid until
+// its element is popped or erased; the number is then reused.
+//
+// As with priority_queue, top() ranks highest under Compare. Dijkstra-style
+// code wants the smallest distance on top, so it uses Compare =
+// std::greater<>, and decrease_key() then means what it says.
+template <class T, class Compare = std::less<T>, std::size_t Arity = 2>
+class indexed_heap {
+  static_assert(Arity >= 2, "indexed_heap arity must be at least 2");
+
+ public:
+  using value_type = T;
+  using value_compare = Compare;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+  using handle_type = std::size_t;
+
+  static constexpr size_type arity = Arity;
+
+  indexed_heap() : indexed_heap(Compare()) {}
+
+  explicit indexed_heap(const Compare &comp) : comp_(comp) {}
+
+  const_reference top() const { return nodes_.front().value; }
+
+  handle_type top_handle() const { return nodes_.front().handle; }
+
+  bool empty() const noexcept { return nodes_.empty(); }
+
+  size_type size() const noexcept { return nodes_.size(); }
+
+  void reserve(size_type n) {
+    nodes_.reserve(n);
+    positions_.reserve(n);
+  }
+
+  void clear() noexcept {
+    nodes_.clear();
+    positions_.clear();
+    free_.clear();
+  }
+
+  // True while handle names an element in the heap.
+  bool contains(handle_type handle) const noexcept {
+    return handle < positions_.size() && positions_[handle] != kNone_;
+  }
+
+  const_reference operator[](handle_type handle) const {
+    return nodes_[positions_[handle]].value;
+  }
+
+  const_reference at(handle_type handle) const {
+    CheckHandle_(handle);
+    return (*this)[handle];
+  }
+
+  handle_type push(const_reference value) { return emplace(value); }
+
+  handle_type push(value_type &&value) { return emplace(std::move(value)); }
+
+  // The element is stored before its handle is taken, so a throwing
+  // constructor leaves no handle behind.
+  template <typename... Args>
+  handle_type emplace(Args &&...args) {
+    bool reuse = !free_.empty();
+    handle_type handle = reuse ? free_.back() : positions_.size();
+    nodes_.push_back(Node_{T(std::forward<Args>(args)...), handle});
+    size_type pos = nodes_.size() - 1;
+    if (reuse) {
+      free_.pop_back();
+      positions_[handle] = pos;
+    } else {
+      try {
+        positions_.push_back(pos);
+      } catch (...) {
+        nodes_.pop_back();
+        throw;
+      }
+    }
+    SiftUp_(pos);
+    return handle;
+  }
+
+  void pop() { erase(top_handle()); }
+
+  // Gives handle a value that ranks no lower than its current one and
+  // moves it toward the top; throws std::invalid_argument otherwise.
+  void decrease_key(handle_type handle, value_type value) {
+    CheckHandle_(handle);
+    size_type pos = positions_[handle];
+    if (comp_(value, nodes_[pos].value)) {
+      throw std::invalid_argument("decrease_key would lower the priority");
+    }
+    nodes_[pos].value = std::move(value);
+    SiftUp_(pos);
+  }
+
+  // Gives handle any new value, sifting it whichever way it now belongs.
+  void update(handle_type handle, value_type value) {
+    CheckHandle_(handle);
+    size_type pos = positions_[handle];
+    nodes_[pos].value = std::move(value);
+    Fix_(pos);
+  }
+
+  void erase(handle_type handle) {
+    CheckHandle_(handle);
+    size_type pos = positions_[handle];
+    size_type last = nodes_.size() - 1;
+    if (pos != last) {
+      nodes_[pos] = std::move(nodes_[last]);
+      positions_[nodes_[pos].handle] = pos;
+    }
+    nodes_.pop_back();
+    positions_[handle] = kNone_;
+    free_.push_back(handle);
+    if (pos != last) {
+      Fix_(pos);
+    }
+  }
+
+ private:
+  struct Node_ {
+    T value;
+    handle_type handle;
+  };
+
+  static constexpr size_type kNone_ = std::numeric_limits<size_type>::max();
+
+  bool Less_(const Node_ &a, const Node_ &b) const {
+    return comp_(a.value, b.value);
+  }
+
+  void SiftUp_(size_type pos) {
+    internal::HeapSiftUp<Arity>(nodes_.begin(), pos, NodeCompare_(),
+                                Placement_());
+  }
+
+  // Restores the heap around pos after its value changed either way.
+  void Fix_(size_type pos) {
+    if (pos > 0 && Less_(nodes_[(pos - 1) / Arity], nodes_[pos])) {
+      SiftUp_(pos);
+    } else {
+      internal::HeapSiftDown<Arity>(nodes_.begin(), nodes_.size(), pos,
+                                    NodeCompare_(), Placement_());
+    }
+  }
+
+  auto NodeCompare_() const {
+    return [this](const Node_ &a, const Node_ &b) { return Less_(a, b); };
+  }
+
+  auto Placement_() {
+    return [this](size_type pos) { positions_[nodes_[pos].handle] = pos; };
+  }
+
+  void CheckHandle_(handle_type handle) const {
+    if (!contains(handle)) {
+      throw std::out_of_range("Out of bound exeption");
+    }
+  }
+
+  s21::vector<Node_> nodes_;
+  s21::vector<size_type> positions_;
+  s21::vector<handle_type> free_;
+  Compare comp_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_PRIORITY_QUEUE_H_
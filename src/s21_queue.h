@@ -2,56 +2,86 @@
 #ifndef CPP2_S21_CONTAINERS_SRC_S21_QUEUE_H_
 #define CPP2_S21_CONTAINERS_SRC_S21_QUEUE_H_
 
-#include "s21_list.h"
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+#include "s21_deque.h"
 
 namespace s21 {
-template <typename T>
+// FIFO adapter over any Container with front, back, push_back,
+// emplace_back and pop_front, such as s21::deque (the default) or
+// s21::list.
+template <typename T, class Container = s21::deque<T>>
 class queue {
  public:
+  using container_type = Container;
   using value_type = T;
   using reference = T &;
   using const_reference = const T &;
   using size_type = std::size_t;
 
-  queue() : head_() {}
+  queue() : container_() {}
+
+  explicit queue(const Container &container) : container_(container) {}
+
+  explicit queue(Container &&container) : container_(std::move(container)) {}
 
   explicit queue(std::initializer_list<value_type> const &items) {
-    for (value_type i : items) {
-      head_.push_back(i);
+    for (const value_type &item : items) {
+      container_.push_back(item);
     }
   }
 
-  queue(const queue &other) : head_(other.head_) {}
+  queue(const queue &other) : container_(other.container_) {}
 
-  queue(queue &&other) : head_(std::move(other.head_)) {}
+  queue(queue &&other) noexcept(
+      std::is_nothrow_move_constructible_v<Container>)
+      : container_(std::move(other.container_)) {}
 
   ~queue() {}
 
-  queue &operator=(queue &&other) noexcept {
-    head_ = std::move(other.head_);
+  queue &operator=(queue &&other) noexcept(
+      std::is_nothrow_move_assignable_v<Container>) {
+    container_ = std::move(other.container_);
     return *this;
   }
 
   queue &operator=(const queue &other) {
-    head_ = other.head_;
+    container_ = other.container_;
     return *this;
   }
 
-  const_reference front() { return head_.front(); }
-  const_reference back() { return head_.back(); }
+  reference front() { return container_.front(); }
+  const_reference front() const { return container_.front(); }
+  reference back() { return container_.back(); }
+  const_reference back() const { return container_.back(); }
+
+  bool empty() const { return container_.empty(); }
 
-  bool empty() { return head_.empty(); }
+  size_type size() const { return container_.size(); }
 
-  size_type size() { return head_.size(); }
+  // Available when Container has reserve().
+  template <class C = Container>
+  auto reserve(size_type n) -> decltype(std::declval<C &>().reserve(n)) {
+    return container_.reserve(n);
+  }
+
+  void push(const_reference value) { container_.push_back(value); }
 
-  void push(const_reference value) { head_.push_back(value); }
+  void push(value_type &&value) { container_.push_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace(Args &&...args) {
+    return container_.emplace_back(std::forward<Args>(args)...);
+  }
 
-  void pop() { head_.pop_front(); }
+  void pop() { container_.pop_front(); }
 
-  void swap(queue &other) { head_.swap(other.head_); }
+  void swap(queue &other) { container_.swap(other.container_); }
 
  private:
-  s21::list<T> head_;
+  Container container_;
 };
 }  // namespace s21
 #endif  // CPP2_S21_CONTAINERS_SRC_S21_QUEUE_H_
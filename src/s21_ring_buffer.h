@@ -0,0 +1,521 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_RING_BUFFER_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_RING_BUFFER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+// FIFO circular buffer over one contiguous power-of-two array; slot i of
+// the ring is data[(head + i) & (capacity - 1)].
+//
+// With mode::grow (the default) a push into a full buffer doubles the
+// array. With mode::overwrite the capacity is fixed and a push into a full
+// buffer replaces the oldest element, which suits telemetry that only needs
+// the latest samples. push(first, n) and pop(out, n) move whole runs with
+// at most two contiguous copies, one on each side of the wrap point.
+//
+// ring_buffer has the members s21::queue needs, so
+// s21::queue<T, s21::ring_buffer<T>> is a queue with no per-element
+// allocation.
+template <class T, class Allocator = std::allocator<T>>
+class ring_buffer {
+  using AllocTraits_ = std::allocator_traits<Allocator>;
+
+  template <bool kConst>
+  class Iterator_;
+
+ public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = Iterator_<false>;
+  using const_iterator = Iterator_<true>;
+  using size_type = std::size_t;
+
+  enum class mode { grow, overwrite };
+
+  static_assert(std::is_same_v<typename AllocTraits_::value_type, T>,
+                "Allocator::value_type must be T");
+
+  ring_buffer() noexcept(noexcept(Allocator())) : alloc_() {}
+
+  // Capacity is rounded up to a power of two.
+  explicit ring_buffer(size_type capacity, mode m = mode::grow,
+                       const Allocator &alloc = Allocator())
+      : mode_(m), alloc_(alloc) {
+    Reallocate_(RoundUp_(std::max<size_type>(capacity, 1)));
+  }
+
+  ring_buffer(std::initializer_list<value_type> const &items,
+              const Allocator &alloc = Allocator())
+      : alloc_(alloc) {
+    reserve(items.size());
+    push(items.begin(), items.size());
+  }
+
+  ring_buffer(const ring_buffer &other)
+      : mode_(other.mode_),
+        alloc_(AllocTraits_::select_on_container_copy_construction(
+            other.alloc_)) {
+    if (other.capacity_ != 0) {
+      Reallocate_(other.capacity_);
+    }
+    for (const value_type &item : other) {
+      push_back(item);
+    }
+  }
+
+  ring_buffer(ring_buffer &&other) noexcept
+      : mode_(other.mode_), alloc_(std::move(other.alloc_)) {
+    data_ = std::exchange(other.data_, nullptr);
+    capacity_ = std::exchange(other.capacity_, 0);
+    head_ = std::exchange(other.head_, 0);
+    size_ = std::exchange(other.size_, 0);
+  }
+
+  ~ring_buffer() {
+    clear();
+    Deallocate_();
+  }
+
+  ring_buffer &operator=(const ring_buffer &other) {
+    if (this == &other) {
+      return *this;
+    }
+    if constexpr (AllocTraits_::propagate_on_container_copy_assignment::
+                      value) {
+      if (alloc_ != other.alloc_) {
+        clear();
+        Deallocate_();
+      }
+      alloc_ = other.alloc_;
+    }
+    ClearTo_(other.capacity_);
+    mode_ = other.mode_;
+    for (const value_type &item : other) {
+      EmplaceBack_(item);
+    }
+    return *this;
+  }
+
+  ring_buffer &operator=(ring_buffer &&other) noexcept(
+      AllocTraits_::propagate_on_container_move_assignment::value ||
+      AllocTraits_::is_always_equal::value) {
+    if (this == &other) {
+      return *this;
+    }
+    if constexpr (!AllocTraits_::propagate_on_container_move_assignment::
+                      value &&
+                  !AllocTraits_::is_always_equal::value) {
+      if (alloc_ != other.alloc_) {
+        // The array from other's allocator cannot be adopted, so the
+        // elements are moved into an array of our own.
+        ClearTo_(other.capacity_);
+        mode_ = other.mode_;
+        for (value_type &item : other) {
+          EmplaceBack_(std::move(item));
+        }
+        other.clear();
+        return *this;
+      }
+    }
+    clear();
+    Deallocate_();
+    if constexpr (AllocTraits_::propagate_on_container_move_assignment::
+                      value) {
+      alloc_ = std::move(other.alloc_);
+    }
+    mode_ = other.mode_;
+    data_ = std::exchange(other.data_, nullptr);
+    capacity_ = std::exchange(other.capacity_, 0);
+    head_ = std::exchange(other.head_, 0);
+    size_ = std::exchange(other.size_, 0);
+    return *this;
+  }
+
+  allocator_type get_allocator() const noexcept { return alloc_; }
+
+  mode overflow_mode() const noexcept { return mode_; }
+
+  reference at(size_type pos) {
+    if (pos >= size_) {
+      throw std::out_of_range("Out of bound exeption");
+    }
+    return (*this)[pos];
+  }
+
+  const_reference at(size_type pos) const {
+    return const_cast<ring_buffer *>(this)->at(pos);
+  }
+
+  // pos-th element from the front.
+  reference operator[](size_type pos) { return data_[Wrap_(head_ + pos)]; }
+
+  const_reference operator[](size_type pos) const {
+    return data_[Wrap_(head_ + pos)];
+  }
+
+  reference front() { return data_[head_]; }
+
+  const_reference front() const { return data_[head_]; }
+
+  reference back() { return (*this)[size_ - 1]; }
+
+  const_reference back() const { return (*this)[size_ - 1]; }
+
+  iterator begin() noexcept { return iterator(this, 0); }
+
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+  iterator end() noexcept { return iterator(this, size_); }
+
+  const_iterator end() const noexcept { return const_iterator(this, size_); }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  bool full() const noexcept { return size_ == capacity_; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type capacity() const noexcept { return capacity_; }
+
+  size_type max_size() const noexcept {
+    size_type limit = std::min<size_type>(
+        AllocTraits_::max_size(alloc_),
+        std::numeric_limits<std::ptrdiff_t>::max() / sizeof(value_type));
+    return size_type{1} << (std::numeric_limits<size_type>::digits - 1 -
+                            __builtin_clzll(limit));
+  }
+
+  // Grows to at least n slots, rounded up to a power of two. In overwrite
+  // mode this is the only way the capacity changes.
+  void reserve(size_type n) {
+    if (n > max_size()) {
+      throw std::length_error("ring_buffer capacity exceeds max_size");
+    }
+    if (n > capacity_) {
+      Reallocate_(RoundUp_(n));
+    }
+  }
+
+  void clear() noexcept {
+    for (size_type i = 0; i < size_; ++i) {
+      AllocTraits_::destroy(alloc_, &(*this)[i]);
+    }
+    head_ = size_ = 0;
+  }
+
+  void push_back(const_reference value) { emplace_back(value); }
+
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    if (size_ == capacity_) {
+      if (mode_ == mode::overwrite && capacity_ != 0) {
+        // The new value is built before the oldest one is replaced, since
+        // args may refer to it.
+        reference oldest = data_[head_];
+        oldest = value_type(std::forward<Args>(args)...);
+        head_ = Wrap_(head_ + 1);
+        return oldest;
+      }
+      value_type tmp(std::forward<Args>(args)...);
+      Reallocate_(GrowCapacity_(size_ + 1));
+      return EmplaceBack_(std::move(tmp));
+    }
+    return EmplaceBack_(std::forward<Args>(args)...);
+  }
+
+  void pop_front() {
+    AllocTraits_::destroy(alloc_, data_ + head_);
+    head_ = Wrap_(head_ + 1);
+    --size_;
+  }
+
+  // Appends n elements copied from first. In overwrite mode only the
+  // newest capacity() elements are kept.
+  void push(const value_type *first, size_type n) {
+    if (mode_ == mode::overwrite && capacity_ != 0) {
+      if (n >= capacity_) {
+        clear();
+        first += n - capacity_;
+        n = capacity_;
+      }
+      while (size_ + n > capacity_) {
+        pop_front();
+      }
+    } else if (size_ + n > capacity_) {
+      reserve(std::max(size_ + n, GrowCapacity_(size_ + n)));
+    }
+    size_type tail = Wrap_(head_ + size_);
+    size_type chunk = std::min(n, capacity_ - tail);
+    CopyConstruct_(first, chunk, data_ + tail);
+    try {
+      CopyConstruct_(first + chunk, n - chunk, data_);
+    } catch (...) {
+      Destroy_(data_ + tail, chunk);
+      throw;
+    }
+    size_ += n;
+  }
+
+  // Whole-container form, for anything with data() and size().
+  template <class Contiguous>
+  auto push(const Contiguous &items)
+      -> decltype(items.data(), items.size(), void()) {
+    push(items.data(), items.size());
+  }
+
+  // Moves up to n elements from the front into out[0, n); returns how many
+  // were moved.
+  size_type pop(value_type *out, size_type n) {
+    n = std::min(n, size_);
+    size_type chunk = std::min(n, capacity_ - head_);
+    std::move(data_ + head_, data_ + head_ + chunk, out);
+    std::move(data_, data_ + (n - chunk), out + chunk);
+    Destroy_(data_ + head_, chunk);
+    Destroy_(data_, n - chunk);
+    head_ = Wrap_(head_ + n);
+    size_ -= n;
+    return n;
+  }
+
+  void swap(ring_buffer &other) noexcept {
+    if constexpr (AllocTraits_::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
+    std::swap(data_, other.data_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+    std::swap(mode_, other.mode_);
+  }
+
+ private:
+  template <bool kConst>
+  class Iterator_ {
+    using Owner_ =
+        std::conditional_t<kConst, const ring_buffer, ring_buffer>;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<kConst, const T &, T &>;
+    using pointer = std::conditional_t<kConst, const T *, T *>;
+
+    Iterator_() noexcept = default;
+
+    template <bool kOther, class = std::enable_if_t<kConst && !kOther>>
+    Iterator_(const Iterator_<kOther> &other) noexcept
+        : owner_(other.owner_), index_(other.index_) {}
+
+    reference operator*() const { return (*owner_)[index_]; }
+
+    pointer operator->() const { return &(*owner_)[index_]; }
+
+    reference operator[](difference_type n) const {
+      return (*owner_)[index_ + n];
+    }
+
+    Iterator_ &operator++() {
+      ++index_;
+      return *this;
+    }
+
+    Iterator_ operator++(int) {
+      Iterator_ old = *this;
+      ++index_;
+      return old;
+    }
+
+    Iterator_ &operator--() {
+      --index_;
+      return *this;
+    }
+
+    Iterator_ operator--(int) {
+      Iterator_ old = *this;
+      --index_;
+      return old;
+    }
+
+    Iterator_ &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+
+    Iterator_ &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+
+    Iterator_ operator+(difference_type n) const {
+      return Iterator_(owner_, index_ + n);
+    }
+
+    Iterator_ operator-(difference_type n) const {
+      return Iterator_(owner_, index_ - n);
+    }
+
+    difference_type operator-(const Iterator_ &other) const {
+      return static_cast<difference_type>(index_) -
+             static_cast<difference_type>(other.index_);
+    }
+
+    bool operator==(const Iterator_ &other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const Iterator_ &other) const {
+      return index_ != other.index_;
+    }
+    bool operator<(const Iterator_ &other) const {
+      return index_ < other.index_;
+    }
+    bool operator>(const Iterator_ &other) const {
+      return index_ > other.index_;
+    }
+    bool operator<=(const Iterator_ &other) const {
+      return index_ <= other.index_;
+    }
+    bool operator>=(const Iterator_ &other) const {
+      return index_ >= other.index_;
+    }
+
+   private:
+    friend class ring_buffer;
+    template <bool>
+    friend class Iterator_;
+
+    Iterator_(Owner_ *owner, size_type index) noexcept
+        : owner_(owner), index_(index) {}
+
+    Owner_ *owner_ = nullptr;
+    size_type index_ = 0;
+  };
+
+  static size_type RoundUp_(size_type n) noexcept {
+    size_type capacity = 1;
+    while (capacity < n) {
+      capacity *= 2;
+    }
+    return capacity;
+  }
+
+  size_type Wrap_(size_type pos) const noexcept {
+    return pos & (capacity_ - 1);
+  }
+
+  size_type GrowCapacity_(size_type required) const {
+    if (required > max_size()) {
+      throw std::length_error("ring_buffer capacity exceeds max_size");
+    }
+    return std::max<size_type>(RoundUp_(required), 16);
+  }
+
+  // Bulk copies bypass the allocator only where it could not tell.
+  static constexpr bool kBitwise_ =
+      std::is_trivially_copyable_v<T> &&
+      std::is_same_v<Allocator, std::allocator<T>>;
+
+  // Copy-constructs first[0, n) into dest through the allocator; on a
+  // throw the elements already built are destroyed.
+  void CopyConstruct_(const T *first, size_type n, T *dest) {
+    if constexpr (kBitwise_) {
+      if (n != 0) {
+        std::memcpy(static_cast<void *>(dest), first, n * sizeof(T));
+      }
+    } else {
+      size_type built = 0;
+      try {
+        for (; built < n; ++built) {
+          AllocTraits_::construct(alloc_, dest + built, first[built]);
+        }
+      } catch (...) {
+        Destroy_(dest, built);
+        throw;
+      }
+    }
+  }
+
+  void Destroy_(T *first, size_type n) noexcept {
+    if constexpr (!kBitwise_) {
+      for (size_type i = 0; i < n; ++i) {
+        AllocTraits_::destroy(alloc_, first + i);
+      }
+    }
+  }
+
+  template <typename... Args>
+  reference EmplaceBack_(Args &&...args) {
+    T *slot = data_ + Wrap_(head_ + size_);
+    AllocTraits_::construct(alloc_, slot, std::forward<Args>(args)...);
+    ++size_;
+    return *slot;
+  }
+
+  // Empties the buffer and gives it an array of exactly capacity slots,
+  // as a copy of a buffer with that capacity would have.
+  void ClearTo_(size_type capacity) {
+    clear();
+    if (capacity_ != capacity) {
+      Deallocate_();
+      if (capacity != 0) {
+        Reallocate_(capacity);
+      }
+    }
+  }
+
+  // Moves the elements, in order, to the front of a new array.
+  void Reallocate_(size_type new_capacity) {
+    T *data = AllocTraits_::allocate(alloc_, new_capacity);
+    size_type moved = 0;
+    try {
+      for (; moved < size_; ++moved) {
+        AllocTraits_::construct(alloc_, data + moved,
+                                std::move_if_noexcept((*this)[moved]));
+      }
+    } catch (...) {
+      for (size_type i = 0; i < moved; ++i) {
+        AllocTraits_::destroy(alloc_, data + i);
+      }
+      AllocTraits_::deallocate(alloc_, data, new_capacity);
+      throw;
+    }
+    size_type size = size_;
+    clear();
+    Deallocate_();
+    data_ = data;
+    capacity_ = new_capacity;
+    size_ = size;
+  }
+
+  void Deallocate_() noexcept {
+    if (data_ != nullptr) {
+      AllocTraits_::deallocate(alloc_, data_, capacity_);
+    }
+    data_ = nullptr;
+    capacity_ = 0;
+  }
+
+  T *data_ = nullptr;
+  size_type capacity_ = 0;
+  size_type head_ = 0;
+  size_type size_ = 0;
+  mode mode_ = mode::grow;
+  allocator_type alloc_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_RING_BUFFER_H_
@@ -4,10 +4,14 @@
 #include <functional>
 #include <initializer_list>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
 #include <utility>
 namespace s21 {
 
-template <class Key, class Compare = std::less<Key>>
+template <class Key, class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>>
 class set {
  public:
   template <class T>
@@ -20,10 +24,20 @@ class set {
   using reference = value_type&;
   using const_reference = const value_type&;
   using size_type = size_t;
+  using allocator_type = Allocator;
   using const_iterator = ConstAVLIterator<value_type>;
   using iterator = AVLIterator<value_type>;
 
+  static_assert(
+      std::is_same_v<typename std::allocator_traits<Allocator>::value_type,
+                     Key>,
+      "Allocator::value_type must be Key");
+
  private:
+  // s21::map inserts through EmplaceKey_ with a bare key.
+  template <class, class, class, class>
+  friend class map;
+
   struct AVLNode;
 
  public:
@@ -34,9 +48,9 @@ class set {
     using reference = value_type&;
     using iterator = AVLIterator<value_type>;
 
-    explicit AVLIterator<T>(AVLNode* node)
+    explicit AVLIterator(AVLNode* node)
         : current_(node), root_for_iterator_(nullptr) {}
-    AVLIterator<T>(AVLNode* node, AVLNode* root)
+    AVLIterator(AVLNode* node, AVLNode* root)
         : current_(node), root_for_iterator_(root) {}
 
     reference operator*() { return current_->value; }
@@ -104,10 +118,13 @@ class set {
     using const_reference = const value_type&;
     using const_iterator = ConstAVLIterator<value_type>;
 
-    explicit ConstAVLIterator<T>(const AVLNode* node)
+    explicit ConstAVLIterator(const AVLNode* node)
         : current_(node), root_for_iterator_(nullptr) {}
-    ConstAVLIterator<T>(const AVLNode* node, const AVLNode* root)
+    ConstAVLIterator(const AVLNode* node, const AVLNode* root)
         : current_(node), root_for_iterator_(root) {}
+    ConstAVLIterator(const AVLIterator<T>& other)
+        : current_(other.current_),
+          root_for_iterator_(other.root_for_iterator_) {}
 
     const_reference operator*() const { return current_->value; }
 
@@ -168,30 +185,62 @@ class set {
     }
   };
 
-  set() : root_(nullptr), size_(0) {}
+  set() : root_(nullptr), size_(0), alloc_() {}
+
+  explicit set(const Allocator& alloc)
+      : root_(nullptr), size_(0), alloc_(alloc) {}
 
-  set(std::initializer_list<value_type> const& items) : set() {
+  set(std::initializer_list<value_type> const& items,
+      const Allocator& alloc = Allocator())
+      : set(alloc) {
     for (const value_type& item : items) {
       insert(item);
     }
   }
 
-  set(const set& s) : set() {
+  set(const set& s)
+      : set(AllocTraits_::select_on_container_copy_construction(s.alloc_)) {
+    for (const value_type& item : s) {
+      insert(item);
+    }
+  }
+
+  set(const set& s, const Allocator& alloc) : set(alloc) {
     for (const value_type& item : s) {
       insert(item);
     }
   }
 
-  set(set&& s) noexcept : root_(s.root_), size_(s.size_) {
+  set(set&& s) noexcept
+      : root_(s.root_), size_(s.size_), alloc_(std::move(s.alloc_)) {
     s.root_ = nullptr;
     s.size_ = 0;
   }
 
   ~set() { RemoveTree_(root_); }
 
-  set& operator=(set&& s) noexcept {
+  set& operator=(set&& s) noexcept(
+      AllocTraits_::propagate_on_container_move_assignment::value ||
+      AllocTraits_::is_always_equal::value) {
     if (this != &s) {
       clear();
+      if constexpr (!AllocTraits_::propagate_on_container_move_assignment::
+                        value &&
+                    !AllocTraits_::is_always_equal::value) {
+        if (alloc_ != s.alloc_) {
+          // Nodes from s's allocator cannot be adopted, so the values are
+          // moved into nodes of our own.
+          for (iterator it = s.begin(); it != s.end(); ++it) {
+            EmplaceUnique_(std::move(*it));
+          }
+          s.clear();
+          return *this;
+        }
+      }
+      if constexpr (AllocTraits_::propagate_on_container_move_assignment::
+                        value) {
+        alloc_ = std::move(s.alloc_);
+      }
       root_ = s.root_;
       size_ = s.size_;
       s.root_ = nullptr;
@@ -203,6 +252,10 @@ class set {
   set& operator=(const set& s) {
     if (this != &s) {
       clear();
+      if constexpr (AllocTraits_::propagate_on_container_copy_assignment::
+                        value) {
+        alloc_ = s.alloc_;
+      }
       for (const value_type& item : s) {
         insert(item);
       }
@@ -210,6 +263,8 @@ class set {
     return *this;
   }
 
+  allocator_type get_allocator() const { return alloc_; }
+
   iterator begin() noexcept { return iterator(FindMin_(root_)); }
 
   iterator end() noexcept { return iterator(nullptr, root_); }
@@ -225,8 +280,11 @@ class set {
   size_type size() const { return size_; }
 
   size_type max_size() const {
-    return (std::numeric_limits<size_type>::max() - sizeof(set)) /
-           sizeof(AVLNode);
+    NodeAllocator_ node_alloc(alloc_);
+    return std::min<size_type>(
+        NodeTraits_::max_size(node_alloc),
+        (std::numeric_limits<size_type>::max() - sizeof(set)) /
+            sizeof(AVLNode));
   }
 
   void clear() {
@@ -236,18 +294,33 @@ class set {
   }
 
   std::pair<iterator, bool> insert(const_reference value) {
-    AVLNode* existing = FindNode_(value);
+    return EmplaceUnique_(value);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return EmplaceUnique_(std::move(value));
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    AVLNode* new_node = CreateNode_(std::forward<Args>(args)...);
+    AVLNode* existing = FindNode_(new_node->value);
     if (existing != nullptr) {
+      DestroyNode_(new_node);
       return std::make_pair(iterator(existing), false);
     }
-
-    auto new_node = new AVLNode(value);
     root_ = InsertNode_(root_, new_node);
     ++size_;
-
     return std::make_pair(iterator(new_node), true);
   }
 
+  // The recursive AVL insert always descends from the root, so the hint is
+  // accepted for interface compatibility only.
+  template <class... Args>
+  iterator emplace_hint(const_iterator, Args&&... args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+
   void erase(iterator pos) {
     AVLNode* node = pos.current_;
     if (node == nullptr) {
@@ -257,7 +330,10 @@ class set {
     --size_;
   }
 
-  void swap(set& other) {
+  void swap(set& other) noexcept {
+    if constexpr (AllocTraits_::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
     std::swap(root_, other.root_);
     std::swap(size_, other.size_);
   }
@@ -276,22 +352,38 @@ class set {
     return const_iterator(FindNode_(key));
   }
 
-  bool contains(const Key& key) const {
-    AVLNode* current = root_;
+  bool contains(const Key& key) const { return FindNode_(key) != nullptr; }
 
-    while (current != nullptr) {
-      if (Compare{}(key, current->value))
-        current = current->left;
-      else if (Compare{}(current->value, key))
-        current = current->right;
-      else
-        return true;
-    }
+  iterator lower_bound(const Key& key) const { return LowerBound_(key); }
+
+  iterator upper_bound(const Key& key) const { return UpperBound_(key); }
 
-    return false;
+  // Heterogeneous lookup for comparators that declare is_transparent, so a
+  // caller can search without building a temporary Key.
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator find(const K& key) {
+    return iterator(FindNode_(key));
+  }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator find(const K& key) const {
+    return const_iterator(FindNode_(key));
+  }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  bool contains(const K& key) const {
+    return FindNode_(key) != nullptr;
+  }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator lower_bound(const K& key) const {
+    return LowerBound_(key);
+  }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator upper_bound(const K& key) const {
+    return UpperBound_(key);
   }
 
-  iterator lower_bound(const Key& key) const {
+ private:
+  template <class K>
+  iterator LowerBound_(const K& key) const {
     AVLNode* current = root_;
     AVLNode* lower = nullptr;
 
@@ -307,7 +399,8 @@ class set {
     return iterator(lower);
   }
 
-  iterator upper_bound(const Key& key) const {
+  template <class K>
+  iterator UpperBound_(const K& key) const {
     AVLNode* current = root_;
     AVLNode* upper = nullptr;
 
@@ -322,25 +415,97 @@ class set {
 
     return iterator(upper);
   }
-
- private:
+  // value lives in a union so that the node and its value are built
+  // separately: the node through the rebound node allocator, the value
+  // through the element allocator (uses-allocator construction for pmr).
   struct AVLNode {
-    value_type value;
+    union {
+      value_type value;
+    };
     int height;
     AVLNode* left;
     AVLNode* right;
     AVLNode* parent;
 
-    explicit AVLNode(const value_type& val)
-        : value{val},
-          height{1},
-          left{nullptr},
-          right{nullptr},
-          parent{nullptr} {}
+    AVLNode() : height{1}, left{nullptr}, right{nullptr}, parent{nullptr} {}
+    ~AVLNode() {}
   };
 
+  using AllocTraits_ = std::allocator_traits<Allocator>;
+  using NodeAllocator_ =
+      typename AllocTraits_::template rebind_alloc<AVLNode>;
+  using NodeTraits_ = std::allocator_traits<NodeAllocator_>;
+
   AVLNode* root_;
   size_type size_;
+  allocator_type alloc_;
+
+  template <typename... Args>
+  AVLNode* CreateNode_(Args&&... args) {
+    NodeAllocator_ node_alloc(alloc_);
+    AVLNode* node = NodeTraits_::allocate(node_alloc, 1);
+    NodeTraits_::construct(node_alloc, node);
+    try {
+      AllocTraits_::construct(alloc_, std::addressof(node->value),
+                              std::forward<Args>(args)...);
+    } catch (...) {
+      NodeTraits_::destroy(node_alloc, node);
+      NodeTraits_::deallocate(node_alloc, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  void DestroyNode_(AVLNode* node) noexcept {
+    NodeAllocator_ node_alloc(alloc_);
+    AllocTraits_::destroy(alloc_, std::addressof(node->value));
+    NodeTraits_::destroy(node_alloc, node);
+    NodeTraits_::deallocate(node_alloc, node, 1);
+  }
+
+  template <typename V>
+  std::pair<iterator, bool> EmplaceUnique_(V&& value) {
+    return EmplaceKey_(value, std::forward<V>(value));
+  }
+
+  // Inserts a value built from args unless one equivalent to key is
+  // present. The tree is walked once, and the node is built only when the
+  // walk ends at an empty link; args may refer to key, since key is not
+  // compared again after the node is built.
+  template <class K, class... Args>
+  std::pair<iterator, bool> EmplaceKey_(const K& key, Args&&... args) {
+    AVLNode* found = nullptr;
+    bool inserted = false;
+    auto make = [&] { return CreateNode_(std::forward<Args>(args)...); };
+    root_ = InsertUnique_(root_, key, make, found, inserted);
+    if (inserted) {
+      ++size_;
+    }
+    return std::make_pair(iterator(found), inserted);
+  }
+
+  // Links are only rewritten on the way back up, so a throwing make leaves
+  // the tree untouched.
+  template <class K, class Make>
+  AVLNode* InsertUnique_(AVLNode* node, const K& key, Make& make,
+                         AVLNode*& found, bool& inserted) {
+    if (node == nullptr) {
+      found = make();
+      inserted = true;
+      return found;
+    }
+    if (Compare{}(key, node->value)) {
+      node->left = InsertUnique_(node->left, key, make, found, inserted);
+      node->left->parent = node;
+    } else if (Compare{}(node->value, key)) {
+      node->right = InsertUnique_(node->right, key, make, found, inserted);
+      node->right->parent = node;
+    } else {
+      found = node;
+      return node;
+    }
+    return inserted ? Balance_(node) : node;
+  }
 
   int GetHeight_(AVLNode* node) const {
     if (node == nullptr) {
@@ -432,14 +597,12 @@ class set {
       node->right = RemoveNode_(node->right, key);
     } else {
       if (node->left == nullptr || node->right == nullptr) {
-        AVLNode* temp = node->left ? node->left : node->right;
-        if (temp == nullptr) {
-          temp = node;
-          node = nullptr;
-        } else {
-          *node = *temp;
+        AVLNode* child = node->left ? node->left : node->right;
+        if (child != nullptr) {
+          child->parent = node->parent;
         }
-        delete temp;
+        DestroyNode_(node);
+        node = child;
       } else {
         AVLNode* temp = FindMin_(node->right);
         std::swap(node->value, temp->value);
@@ -465,11 +628,12 @@ class set {
     if (node != nullptr) {
       RemoveTree_(node->left);
       RemoveTree_(node->right);
-      delete node;
+      DestroyNode_(node);
     }
   }
 
-  AVLNode* FindNode_(const value_type& value) const {
+  template <class K>
+  AVLNode* FindNode_(const K& value) const {
     AVLNode* current = root_;
 
     while (current != nullptr) {
@@ -485,6 +649,11 @@ class set {
   }
 };
 
+namespace pmr {
+template <class Key, class Compare = std::less<Key>>
+using set = s21::set<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
+
 }  // namespace s21
 
 #endif  // CPP2_S21_CONTAINERS_SRC_S21_SET_H_
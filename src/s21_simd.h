@@ -0,0 +1,506 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_SIMD_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_SIMD_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && \
+    !defined(__clang__)
+#define S21_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define S21_SIMD_X86 0
+#endif
+
+// Vectorized find, count, min_element, max_element, equal and fill over
+// contiguous ranges of arithmetic values, e.g. s21::vector::data() or
+// s21::array::data(). The kernel is chosen at run time from what the CPU
+// supports (SSE2, AVX2 or AVX-512); std::int32_t and float ranges are
+// vectorized, every other arithmetic type and non-x86 targets use the
+// standard algorithms. Results are identical to the std:: counterparts,
+// including the first-occurrence rule for min/max and NaN handling.
+//
+// The same dispatch serves bit arrays of std::uint64_t words, as used by
+// s21::dynamic_bitset: popcount and in-place bit_and, bit_or, bit_xor and
+// bit_andnot.
+namespace s21 {
+namespace simd {
+enum class isa { scalar, sse2, avx2, avx512 };
+
+// Best instruction set supported by this CPU.
+inline isa detected_isa() noexcept {
+#if S21_SIMD_X86
+  static const isa detected = [] {
+    __builtin_cpu_init();
+    bool popcnt = __builtin_cpu_supports("popcnt");
+    if (popcnt && __builtin_cpu_supports("avx512f")) {
+      return isa::avx512;
+    }
+    if (popcnt && __builtin_cpu_supports("avx2")) {
+      return isa::avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+      return isa::sse2;
+    }
+    return isa::scalar;
+  }();
+  return detected;
+#else
+  return isa::scalar;
+#endif
+}
+
+namespace internal {
+inline std::atomic<isa> &ActiveIsa() noexcept {
+  static std::atomic<isa> active{detected_isa()};
+  return active;
+}
+
+template <class T>
+struct NonDeduced {
+  using type = T;
+};
+
+template <class T>
+inline constexpr bool kVectorized =
+    std::is_same_v<T, std::int32_t> || std::is_same_v<T, float>;
+
+enum class BitOp { kAnd, kOr, kXor, kAndNot };
+
+template <BitOp kOp>
+constexpr std::uint64_t ApplyBits(std::uint64_t a, std::uint64_t b) noexcept {
+  switch (kOp) {
+    case BitOp::kAnd:
+      return a & b;
+    case BitOp::kOr:
+      return a | b;
+    case BitOp::kXor:
+      return a ^ b;
+    case BitOp::kAndNot:
+      break;
+  }
+  return a & ~b;
+}
+
+// Without POPCNT __builtin_popcountll is a libgcc call, so the scalar and
+// SSE2 paths count bits arithmetically.
+constexpr int PopCount64(std::uint64_t x) noexcept {
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+}
+
+template <BitOp kOp>
+void BitwiseScalar(std::uint64_t *dest, const std::uint64_t *src,
+                   std::size_t n) noexcept {
+  for (std::size_t i = 0; i < n; ++i) {
+    dest[i] = ApplyBits<kOp>(dest[i], src[i]);
+  }
+}
+
+inline std::size_t PopCountScalar(const std::uint64_t *words,
+                                  std::size_t n) noexcept {
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    total += PopCount64(words[i]);
+  }
+  return total;
+}
+}  // namespace internal
+
+// Instruction set the algorithms below dispatch to.
+inline isa active_isa() noexcept {
+  return internal::ActiveIsa().load(std::memory_order_relaxed);
+}
+
+// Restricts dispatch to at most the requested instruction set, e.g. to
+// compare kernels against each other; returns the set actually in use.
+inline isa set_isa(isa requested) noexcept {
+  isa effective = std::min(requested, detected_isa());
+  internal::ActiveIsa().store(effective, std::memory_order_relaxed);
+  return effective;
+}
+
+#if S21_SIMD_X86
+#pragma GCC push_options
+#pragma GCC target("sse2")
+namespace sse2 {
+template <class T>
+struct Ops;
+
+template <>
+struct Ops<std::int32_t> {
+  using vec = __m128i;
+  static constexpr std::ptrdiff_t kLanes = 4;
+  static constexpr unsigned kAllLanes = 0xF;
+  // Without POPCNT (not implied by SSE2) __builtin_popcount is a libgcc
+  // call, so the four-bit lane masks are counted through a table.
+  static int CountBits(unsigned mask) {
+    static constexpr unsigned char kBits[16] = {0, 1, 1, 2, 1, 2, 2, 3,
+                                                1, 2, 2, 3, 2, 3, 3, 4};
+    return kBits[mask];
+  }
+  static vec Load(const std::int32_t *p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  }
+  static void Store(std::int32_t *p, vec v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+  }
+  static vec Broadcast(std::int32_t v) { return _mm_set1_epi32(v); }
+  static unsigned EqMask(vec a, vec b) {
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)));
+  }
+  // SSE2 has no pminsd/pmaxsd, so select through a comparison mask.
+  static vec Min(vec a, vec b) {
+    vec less = _mm_cmplt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(less, a), _mm_andnot_si128(less, b));
+  }
+  static vec Max(vec a, vec b) {
+    vec greater = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(greater, a),
+                        _mm_andnot_si128(greater, b));
+  }
+};
+
+template <>
+struct Ops<float> {
+  using vec = __m128;
+  static constexpr std::ptrdiff_t kLanes = 4;
+  static constexpr unsigned kAllLanes = 0xF;
+  static int CountBits(unsigned mask) {
+    return Ops<std::int32_t>::CountBits(mask);
+  }
+  static vec Load(const float *p) { return _mm_loadu_ps(p); }
+  static void Store(float *p, vec v) { _mm_storeu_ps(p, v); }
+  static vec Broadcast(float v) { return _mm_set1_ps(v); }
+  static unsigned EqMask(vec a, vec b) {
+    return _mm_movemask_ps(_mm_cmpeq_ps(a, b));
+  }
+  static vec Min(vec a, vec b) { return _mm_min_ps(a, b); }
+  static vec Max(vec a, vec b) { return _mm_max_ps(a, b); }
+};
+
+struct Bits {
+  using vec = __m128i;
+  static constexpr std::size_t kWords = 2;
+  static int PopCount(std::uint64_t x) { return internal::PopCount64(x); }
+  static vec Load(const std::uint64_t *p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  }
+  static void Store(std::uint64_t *p, vec v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+  }
+  static vec And(vec a, vec b) { return _mm_and_si128(a, b); }
+  static vec Or(vec a, vec b) { return _mm_or_si128(a, b); }
+  static vec Xor(vec a, vec b) { return _mm_xor_si128(a, b); }
+  static vec AndNot(vec a, vec b) { return _mm_andnot_si128(b, a); }
+};
+
+#include "s21_simd_kernels.h"
+}  // namespace sse2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,popcnt")
+namespace avx2 {
+template <class T>
+struct Ops;
+
+template <>
+struct Ops<std::int32_t> {
+  using vec = __m256i;
+  static constexpr std::ptrdiff_t kLanes = 8;
+  static constexpr unsigned kAllLanes = 0xFF;
+  static int CountBits(unsigned mask) { return __builtin_popcount(mask); }
+  static vec Load(const std::int32_t *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static void Store(std::int32_t *p, vec v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+  }
+  static vec Broadcast(std::int32_t v) { return _mm256_set1_epi32(v); }
+  static unsigned EqMask(vec a, vec b) {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+  }
+  static vec Min(vec a, vec b) { return _mm256_min_epi32(a, b); }
+  static vec Max(vec a, vec b) { return _mm256_max_epi32(a, b); }
+};
+
+template <>
+struct Ops<float> {
+  using vec = __m256;
+  static constexpr std::ptrdiff_t kLanes = 8;
+  static constexpr unsigned kAllLanes = 0xFF;
+  static int CountBits(unsigned mask) { return __builtin_popcount(mask); }
+  static vec Load(const float *p) { return _mm256_loadu_ps(p); }
+  static void Store(float *p, vec v) { _mm256_storeu_ps(p, v); }
+  static vec Broadcast(float v) { return _mm256_set1_ps(v); }
+  static unsigned EqMask(vec a, vec b) {
+    return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+  }
+  static vec Min(vec a, vec b) { return _mm256_min_ps(a, b); }
+  static vec Max(vec a, vec b) { return _mm256_max_ps(a, b); }
+};
+
+struct Bits {
+  using vec = __m256i;
+  static constexpr std::size_t kWords = 4;
+  static int PopCount(std::uint64_t x) { return __builtin_popcountll(x); }
+  static vec Load(const std::uint64_t *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static void Store(std::uint64_t *p, vec v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+  }
+  static vec And(vec a, vec b) { return _mm256_and_si256(a, b); }
+  static vec Or(vec a, vec b) { return _mm256_or_si256(a, b); }
+  static vec Xor(vec a, vec b) { return _mm256_xor_si256(a, b); }
+  static vec AndNot(vec a, vec b) { return _mm256_andnot_si256(b, a); }
+};
+
+#include "s21_simd_kernels.h"
+}  // namespace avx2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,popcnt")
+namespace avx512 {
+template <class T>
+struct Ops;
+
+template <>
+struct Ops<std::int32_t> {
+  using vec = __m512i;
+  static constexpr std::ptrdiff_t kLanes = 16;
+  static constexpr unsigned kAllLanes = 0xFFFF;
+  static int CountBits(unsigned mask) { return __builtin_popcount(mask); }
+  static vec Load(const std::int32_t *p) { return _mm512_loadu_si512(p); }
+  static void Store(std::int32_t *p, vec v) { _mm512_storeu_si512(p, v); }
+  static vec Broadcast(std::int32_t v) { return _mm512_set1_epi32(v); }
+  static unsigned EqMask(vec a, vec b) {
+    return _mm512_cmpeq_epi32_mask(a, b);
+  }
+  // The unmasked min/max forms start from an undefined register, which
+  // GCC 12 reports as maybe-uninitialized once inlined.
+  static vec Min(vec a, vec b) {
+    return _mm512_mask_min_epi32(b, 0xFFFF, a, b);
+  }
+  static vec Max(vec a, vec b) {
+    return _mm512_mask_max_epi32(b, 0xFFFF, a, b);
+  }
+};
+
+template <>
+struct Ops<float> {
+  using vec = __m512;
+  static constexpr std::ptrdiff_t kLanes = 16;
+  static constexpr unsigned kAllLanes = 0xFFFF;
+  static int CountBits(unsigned mask) { return __builtin_popcount(mask); }
+  static vec Load(const float *p) { return _mm512_loadu_ps(p); }
+  static void Store(float *p, vec v) { _mm512_storeu_ps(p, v); }
+  static vec Broadcast(float v) { return _mm512_set1_ps(v); }
+  static unsigned EqMask(vec a, vec b) {
+    return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+  }
+  static vec Min(vec a, vec b) {
+    return _mm512_mask_min_ps(b, 0xFFFF, a, b);
+  }
+  static vec Max(vec a, vec b) {
+    return _mm512_mask_max_ps(b, 0xFFFF, a, b);
+  }
+};
+
+struct Bits {
+  using vec = __m512i;
+  static constexpr std::size_t kWords = 8;
+  static int PopCount(std::uint64_t x) { return __builtin_popcountll(x); }
+  static vec Load(const std::uint64_t *p) { return _mm512_loadu_si512(p); }
+  static void Store(std::uint64_t *p, vec v) { _mm512_storeu_si512(p, v); }
+  static vec And(vec a, vec b) { return _mm512_and_si512(a, b); }
+  static vec Or(vec a, vec b) { return _mm512_or_si512(a, b); }
+  static vec Xor(vec a, vec b) { return _mm512_xor_si512(a, b); }
+  // Masked for the same reason as Ops<int>::Min: the unmasked form
+  // starts from an undefined register.
+  static vec AndNot(vec a, vec b) {
+    return _mm512_mask_andnot_epi64(a, 0xFF, b, a);
+  }
+};
+
+#include "s21_simd_kernels.h"
+}  // namespace avx512
+#pragma GCC pop_options
+
+// Expands to a switch over the active instruction set that returns
+// kernel<T>(args...) from the matching namespace, and falls through for
+// scalar dispatch or types without kernels.
+#define S21_SIMD_DISPATCH_(kernel, ...)                  \
+  if constexpr (internal::kVectorized<T>) {              \
+    switch (active_isa()) {                              \
+      case isa::avx512:                                  \
+        return avx512::kernel(__VA_ARGS__);              \
+      case isa::avx2:                                    \
+        return avx2::kernel(__VA_ARGS__);                \
+      case isa::sse2:                                    \
+        return sse2::kernel(__VA_ARGS__);                \
+      case isa::scalar:                                  \
+        break;                                           \
+    }                                                    \
+  }
+
+// Same for the bit-array kernels, which have no element type parameter.
+#define S21_SIMD_DISPATCH_BITS_(kernel, ...) \
+  switch (active_isa()) {                    \
+    case isa::avx512:                        \
+      return avx512::kernel(__VA_ARGS__);    \
+    case isa::avx2:                          \
+      return avx2::kernel(__VA_ARGS__);      \
+    case isa::sse2:                          \
+      return sse2::kernel(__VA_ARGS__);      \
+    case isa::scalar:                        \
+      break;                                 \
+  }
+#else
+#define S21_SIMD_DISPATCH_(kernel, ...)
+#define S21_SIMD_DISPATCH_BITS_(kernel, ...)
+#endif
+
+template <class T>
+const T *find(const T *first, const T *last,
+              const typename internal::NonDeduced<T>::type &value) {
+  static_assert(std::is_arithmetic_v<T>, "s21::simd needs arithmetic T");
+  S21_SIMD_DISPATCH_(Find<T>, first, last, value)
+  return std::find(first, last, value);
+}
+
+template <class T>
+std::size_t count(const T *first, const T *last,
+                  const typename internal::NonDeduced<T>::type &value) {
+  static_assert(std::is_arithmetic_v<T>, "s21::simd needs arithmetic T");
+  S21_SIMD_DISPATCH_(Count<T>, first, last, value)
+  return std::count(first, last, value);
+}
+
+template <class T>
+const T *min_element(const T *first, const T *last) {
+  static_assert(std::is_arithmetic_v<T>, "s21::simd needs arithmetic T");
+  S21_SIMD_DISPATCH_(MinElement<T>, first, last)
+  return std::min_element(first, last);
+}
+
+template <class T>
+const T *max_element(const T *first, const T *last) {
+  static_assert(std::is_arithmetic_v<T>, "s21::simd needs arithmetic T");
+  S21_SIMD_DISPATCH_(MaxElement<T>, first, last)
+  return std::max_element(first, last);
+}
+
+template <class T>
+bool equal(const T *first1, const T *last1, const T *first2) {
+  static_assert(std::is_arithmetic_v<T>, "s21::simd needs arithmetic T");
+  S21_SIMD_DISPATCH_(Equal<T>, first1, last1, first2)
+  return std::equal(first1, last1, first2);
+}
+
+template <class T>
+void fill(T *first, T *last,
+          const typename internal::NonDeduced<T>::type &value) {
+  static_assert(std::is_arithmetic_v<T>, "s21::simd needs arithmetic T");
+  S21_SIMD_DISPATCH_(Fill<T>, first, last, value)
+  std::fill(first, last, value);
+}
+
+// Number of set bits in words[0, n).
+inline std::size_t popcount(const std::uint64_t *words, std::size_t n) {
+  S21_SIMD_DISPATCH_BITS_(PopCount, words, n)
+  return internal::PopCountScalar(words, n);
+}
+
+// dest[i] &= src[i] for i in [0, n); src may equal dest.
+inline void bit_and(std::uint64_t *dest, const std::uint64_t *src,
+                    std::size_t n) {
+  S21_SIMD_DISPATCH_BITS_(Bitwise<internal::BitOp::kAnd>, dest, src, n)
+  internal::BitwiseScalar<internal::BitOp::kAnd>(dest, src, n);
+}
+
+// dest[i] |= src[i].
+inline void bit_or(std::uint64_t *dest, const std::uint64_t *src,
+                   std::size_t n) {
+  S21_SIMD_DISPATCH_BITS_(Bitwise<internal::BitOp::kOr>, dest, src, n)
+  internal::BitwiseScalar<internal::BitOp::kOr>(dest, src, n);
+}
+
+// dest[i] ^= src[i].
+inline void bit_xor(std::uint64_t *dest, const std::uint64_t *src,
+                    std::size_t n) {
+  S21_SIMD_DISPATCH_BITS_(Bitwise<internal::BitOp::kXor>, dest, src, n)
+  internal::BitwiseScalar<internal::BitOp::kXor>(dest, src, n);
+}
+
+// dest[i] &= ~src[i].
+inline void bit_andnot(std::uint64_t *dest, const std::uint64_t *src,
+                       std::size_t n) {
+  S21_SIMD_DISPATCH_BITS_(Bitwise<internal::BitOp::kAndNot>, dest, src, n)
+  internal::BitwiseScalar<internal::BitOp::kAndNot>(dest, src, n);
+}
+
+#undef S21_SIMD_DISPATCH_
+#undef S21_SIMD_DISPATCH_BITS_
+
+// Whole-container forms for anything with data() and size(), such as
+// s21::vector and s21::array. Positions are returned as pointers into
+// data().
+template <class Container>
+auto find(Container &c, const typename Container::value_type &value) {
+  auto *first = c.data();
+  return first + (simd::find<typename Container::value_type>(
+                      first, first + c.size(), value) -
+                  first);
+}
+
+template <class Container>
+std::size_t count(Container &c,
+                  const typename Container::value_type &value) {
+  auto *first = c.data();
+  return simd::count<typename Container::value_type>(first,
+                                                     first + c.size(), value);
+}
+
+template <class Container>
+auto min_element(Container &c) {
+  auto *first = c.data();
+  return first + (simd::min_element<typename Container::value_type>(
+                      first, first + c.size()) -
+                  first);
+}
+
+template <class Container>
+auto max_element(Container &c) {
+  auto *first = c.data();
+  return first + (simd::max_element<typename Container::value_type>(
+                      first, first + c.size()) -
+                  first);
+}
+
+template <class Container1, class Container2>
+bool equal(Container1 &a, Container2 &b) {
+  return a.size() == b.size() &&
+         simd::equal<typename Container1::value_type>(
+             a.data(), a.data() + a.size(), b.data());
+}
+
+template <class Container>
+void fill(Container &c, const typename Container::value_type &value) {
+  simd::fill<typename Container::value_type>(c.data(), c.data() + c.size(),
+                                             value);
+}
+}  // namespace simd
+}  // namespace s21
+
+#undef S21_SIMD_X86
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_SIMD_H_
@@ -0,0 +1,141 @@
+// Copyright 2023 School21 @tandraym
+// Kernel bodies shared by every instruction set in s21_simd.h. That header
+// includes this file once per instruction set, inside a namespace that
+// defines Ops<T> and inside a matching "#pragma GCC target" region, so this
+// file deliberately has no include guard and includes nothing itself.
+//
+// Ops<T> provides: vec, kLanes, kAllLanes, Load, Store, Broadcast,
+// EqMask (one bit per equal lane), CountBits (of such a mask), Min and Max
+// (which keep the second argument when the first is NaN or not strictly
+// better). Bits provides the same for arrays of 64-bit words: vec, kWords,
+// Load, Store, PopCount (of one word), And, Or, Xor and AndNot (a & ~b).
+
+template <class T>
+const T *Find(const T *first, const T *last, T value) {
+  using O = Ops<T>;
+  const typename O::vec needle = O::Broadcast(value);
+  for (; last - first >= O::kLanes; first += O::kLanes) {
+    unsigned mask = O::EqMask(O::Load(first), needle);
+    if (mask != 0) {
+      return first + __builtin_ctz(mask);
+    }
+  }
+  for (; first != last && !(*first == value); ++first) {
+  }
+  return first;
+}
+
+template <class T>
+std::size_t Count(const T *first, const T *last, T value) {
+  using O = Ops<T>;
+  const typename O::vec needle = O::Broadcast(value);
+  std::size_t n = 0;
+  for (; last - first >= O::kLanes; first += O::kLanes) {
+    n += O::CountBits(O::EqMask(O::Load(first), needle));
+  }
+  for (; first != last; ++first) {
+    n += *first == value;
+  }
+  return n;
+}
+
+// Reduces the range to its extreme value in one pass, then returns the
+// first element equal to it, which is what std::min_element and
+// std::max_element return for the same comparison.
+template <class T, bool kMax>
+const T *Extreme(const T *first, const T *last) {
+  using O = Ops<T>;
+  if (first == last || std::isnan(*first)) {
+    return kMax ? std::max_element(first, last)
+                : std::min_element(first, last);
+  }
+  typename O::vec acc = O::Broadcast(*first);
+  const T *cur = first;
+  for (; last - cur >= O::kLanes; cur += O::kLanes) {
+    acc = kMax ? O::Max(O::Load(cur), acc) : O::Min(O::Load(cur), acc);
+  }
+  T lanes[O::kLanes];
+  O::Store(lanes, acc);
+  T best = *first;
+  for (const T *p = lanes; p != lanes + O::kLanes; ++p) {
+    best = (kMax ? best < *p : *p < best) ? *p : best;
+  }
+  for (; cur != last; ++cur) {
+    best = (kMax ? best < *cur : *cur < best) ? *cur : best;
+  }
+  return Find<T>(first, last, best);
+}
+
+template <class T>
+const T *MinElement(const T *first, const T *last) {
+  return Extreme<T, false>(first, last);
+}
+
+template <class T>
+const T *MaxElement(const T *first, const T *last) {
+  return Extreme<T, true>(first, last);
+}
+
+template <class T>
+bool Equal(const T *first1, const T *last1, const T *first2) {
+  using O = Ops<T>;
+  for (; last1 - first1 >= O::kLanes;
+       first1 += O::kLanes, first2 += O::kLanes) {
+    if (O::EqMask(O::Load(first1), O::Load(first2)) != O::kAllLanes) {
+      return false;
+    }
+  }
+  for (; first1 != last1; ++first1, ++first2) {
+    if (!(*first1 == *first2)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class T>
+void Fill(T *first, T *last, T value) {
+  using O = Ops<T>;
+  const typename O::vec fill = O::Broadcast(value);
+  for (; last - first >= O::kLanes; first += O::kLanes) {
+    O::Store(first, fill);
+  }
+  for (; first != last; ++first) {
+    *first = value;
+  }
+}
+
+inline std::size_t PopCount(const std::uint64_t *words, std::size_t n) {
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    total += Bits::PopCount(words[i]);
+  }
+  return total;
+}
+
+template <internal::BitOp kOp>
+void Bitwise(std::uint64_t *dest, const std::uint64_t *src, std::size_t n) {
+  std::size_t i = 0;
+  for (; n - i >= Bits::kWords; i += Bits::kWords) {
+    Bits::vec a = Bits::Load(dest + i);
+    Bits::vec b = Bits::Load(src + i);
+    switch (kOp) {
+      case internal::BitOp::kAnd:
+        a = Bits::And(a, b);
+        break;
+      case internal::BitOp::kOr:
+        a = Bits::Or(a, b);
+        break;
+      case internal::BitOp::kXor:
+        a = Bits::Xor(a, b);
+        break;
+      case internal::BitOp::kAndNot:
+        a = Bits::AndNot(a, b);
+        break;
+    }
+    Bits::Store(dest + i, a);
+  }
+  for (; i < n; ++i) {
+    dest[i] = internal::ApplyBits<kOp>(dest[i], src[i]);
+  }
+}
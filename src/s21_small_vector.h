@@ -0,0 +1,421 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_SMALL_VECTOR_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_SMALL_VECTOR_H_
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_memory.h"
+
+namespace s21 {
+// Vector that keeps up to N elements inside the object and only allocates
+// once it grows past them. Offers the s21::vector interface; moving or
+// swapping a heap-backed small_vector just exchanges pointers, while inline
+// elements are relocated (one memcpy for trivially relocatable T).
+template <class T, std::size_t N>
+class small_vector {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = T *;
+  using pointer = T *;
+  using const_iterator = const T *;
+  using size_type = std::size_t;
+
+  static_assert(N > 0, "small_vector needs at least one inline slot");
+
+  small_vector() noexcept : size_(0), capacity_(N), array_(Inline_()) {}
+
+  explicit small_vector(size_type n) : small_vector() {
+    reserve(n);
+    std::uninitialized_value_construct_n(array_, n);
+    size_ = n;
+  }
+
+  explicit small_vector(std::initializer_list<value_type> const &items)
+      : small_vector() {
+    reserve(items.size());
+    std::uninitialized_copy(items.begin(), items.end(), array_);
+    size_ = items.size();
+  }
+
+  small_vector(const small_vector &other) : small_vector() {
+    reserve(other.size_);
+    std::uninitialized_copy(other.begin(), other.end(), array_);
+    size_ = other.size_;
+  }
+
+  small_vector(small_vector &&other) noexcept(kNothrowRelocate_)
+      : small_vector() {
+    StealFrom_(other);
+  }
+
+  small_vector &operator=(const small_vector &other) {
+    if (this != &other) {
+      clear();
+      reserve(other.size_);
+      std::uninitialized_copy(other.begin(), other.end(), array_);
+      size_ = other.size_;
+    }
+    return *this;
+  }
+
+  small_vector &operator=(small_vector &&other) noexcept(kNothrowRelocate_) {
+    if (this != &other) {
+      Release_();
+      size_ = 0;
+      capacity_ = N;
+      array_ = Inline_();
+      StealFrom_(other);
+    }
+    return *this;
+  }
+
+  ~small_vector() { Release_(); }
+
+  reference at(size_type pos) {
+    if (pos >= size_) {
+      throw std::out_of_range("Out of bound exeption");
+    }
+    return array_[pos];
+  }
+
+  reference operator[](size_type pos) { return array_[pos]; }
+  const_reference operator[](size_type pos) const { return array_[pos]; }
+
+  const_reference front() const { return *array_; }
+
+  const_reference back() const { return array_[size_ - 1]; }
+
+  iterator data() noexcept { return array_; }
+  const_iterator data() const noexcept { return array_; }
+
+  iterator begin() noexcept { return array_; }
+  const_iterator begin() const noexcept { return array_; }
+
+  iterator end() noexcept { return array_ + size_; }
+  const_iterator end() const noexcept { return array_ + size_; }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type) / 2;
+  }
+
+  size_type capacity() const noexcept { return capacity_; }
+
+  static constexpr size_type inline_capacity() noexcept { return N; }
+
+  // True while the elements live in the in-object buffer.
+  bool is_inline() const noexcept { return array_ == Inline_(); }
+
+  void reserve(size_type size) {
+    if (size <= capacity_) {
+      return;
+    }
+    if (size > max_size()) {
+      throw std::length_error("Vector capacity exceeds max_size");
+    }
+    MoveTo_(Allocate_(size), size);
+  }
+
+  void shrink_to_fit() {
+    if (is_inline() || size_ == capacity_) {
+      return;
+    }
+    if (size_ <= N) {
+      MoveTo_(Inline_(), N);
+    } else {
+      MoveTo_(Allocate_(size_), size_);
+    }
+  }
+
+  void clear() noexcept {
+    std::destroy(array_, array_ + size_);
+    size_ = 0;
+  }
+
+  void push_back(const_reference value) { emplace_back(value); }
+
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    if (size_ == capacity_) {
+      return *InsertWith_(size_, 1, [&](pointer dest) {
+        ::new (static_cast<void *>(dest))
+            value_type(std::forward<Args>(args)...);
+      });
+    }
+    ::new (static_cast<void *>(array_ + size_))
+        value_type(std::forward<Args>(args)...);
+    ++size_;
+    return array_[size_ - 1];
+  }
+
+  void pop_back() {
+    --size_;
+    std::destroy_at(array_ + size_);
+  }
+
+  iterator insert(iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+
+  iterator insert(iterator pos, value_type &&value) {
+    return emplace(pos, std::move(value));
+  }
+
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    size_type index = pos - array_;
+    if (index == size_ || size_ == capacity_) {
+      return InsertWith_(index, 1, [&](pointer dest) {
+        ::new (static_cast<void *>(dest))
+            value_type(std::forward<Args>(args)...);
+      });
+    }
+    // args may alias an element that the shift below moves from.
+    value_type tmp(std::forward<Args>(args)...);
+    return InsertWith_(index, 1, [&tmp](pointer dest) {
+      ::new (static_cast<void *>(dest)) value_type(std::move(tmp));
+    });
+  }
+
+  void erase(iterator pos) {
+    if constexpr (kRelocatable_) {
+      std::destroy_at(pos);
+      std::memmove(static_cast<void *>(pos), static_cast<void *>(pos + 1),
+                   (array_ + size_ - pos - 1) * sizeof(value_type));
+      --size_;
+    } else {
+      std::move(pos + 1, array_ + size_, pos);
+      pop_back();
+    }
+  }
+
+  void swap(small_vector &other) noexcept(kNothrowRelocate_) {
+    if (this == &other) {
+      return;
+    }
+    if (!is_inline() && !other.is_inline()) {
+      std::swap(array_, other.array_);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+    } else if (is_inline() && other.is_inline()) {
+      small_vector &longer = size_ >= other.size_ ? *this : other;
+      small_vector &shorter = size_ >= other.size_ ? other : *this;
+      size_type common = shorter.size_;
+      std::swap_ranges(shorter.array_, shorter.array_ + common,
+                       longer.array_);
+      Relocate_(longer.array_ + common, longer.array_ + longer.size_,
+                shorter.array_ + common);
+      std::swap(size_, other.size_);
+    } else {
+      small_vector &heap = is_inline() ? other : *this;
+      small_vector &local = is_inline() ? *this : other;
+      // Nothing is rewired until the relocation is done, so a throwing
+      // copy leaves both vectors as they were.
+      Relocate_(local.array_, local.array_ + local.size_, heap.Inline_());
+      local.array_ = std::exchange(heap.array_, heap.Inline_());
+      local.capacity_ = std::exchange(heap.capacity_, N);
+      std::swap(local.size_, heap.size_);
+    }
+  }
+
+  template <typename... Args>
+  iterator insert_many(const_iterator pos, Args &&...args) {
+    size_type index = pos - array_;
+    return InsertWith_(index, sizeof...(Args), [&](pointer dest) {
+      pointer cur = dest;
+      try {
+        ((::new (static_cast<void *>(cur))
+              value_type(std::forward<Args>(args)),
+          ++cur),
+         ...);
+      } catch (...) {
+        std::destroy(dest, cur);
+        throw;
+      }
+    });
+  }
+
+  template <typename... Args>
+  void insert_many_back(Args &&...args) {
+    insert_many(end(), std::forward<Args>(args)...);
+  }
+
+ private:
+  static constexpr bool kRelocatable_ =
+      is_trivially_relocatable_v<value_type>;
+  static constexpr bool kNothrowRelocate_ =
+      kRelocatable_ || std::is_nothrow_move_constructible_v<value_type>;
+
+  pointer Inline_() noexcept { return reinterpret_cast<pointer>(inline_); }
+  const value_type *Inline_() const noexcept {
+    return reinterpret_cast<const value_type *>(inline_);
+  }
+
+  static pointer Allocate_(size_type n) {
+    return std::allocator<value_type>().allocate(n);
+  }
+
+  void FreeHeap_() noexcept {
+    if (!is_inline()) {
+      std::allocator<value_type>().deallocate(array_, capacity_);
+    }
+  }
+
+  void Release_() noexcept {
+    std::destroy(array_, array_ + size_);
+    FreeHeap_();
+  }
+
+  // Moves [first, last) into raw storage at dest and ends the lifetime of
+  // the sources, copying instead when T's move constructor may throw.
+  static void Relocate_(pointer first, pointer last, pointer dest) {
+    if constexpr (kRelocatable_) {
+      if (first != last) {
+        std::memcpy(static_cast<void *>(dest), static_cast<void *>(first),
+                    (last - first) * sizeof(value_type));
+      }
+    } else {
+      if constexpr (std::is_nothrow_move_constructible_v<value_type> ||
+                    !std::is_copy_constructible_v<value_type>) {
+        std::uninitialized_move(first, last, dest);
+      } else {
+        std::uninitialized_copy(first, last, dest);
+      }
+      std::destroy(first, last);
+    }
+  }
+
+  void StealFrom_(small_vector &other) {
+    if (other.is_inline()) {
+      Relocate_(other.array_, other.array_ + other.size_, array_);
+      size_ = other.size_;
+    } else {
+      array_ = other.array_;
+      size_ = other.size_;
+      capacity_ = other.capacity_;
+      other.array_ = other.Inline_();
+      other.capacity_ = N;
+    }
+    other.size_ = 0;
+  }
+
+  void MoveTo_(pointer new_array, size_type new_capacity) {
+    try {
+      Relocate_(array_, array_ + size_, new_array);
+    } catch (...) {
+      if (new_array != Inline_()) {
+        std::allocator<value_type>().deallocate(new_array, new_capacity);
+      }
+      throw;
+    }
+    FreeHeap_();
+    array_ = new_array;
+    capacity_ = new_capacity;
+  }
+
+  // Same contract as s21::vector: construct(dest) builds count elements in
+  // raw storage at index; on growth they are built before anything moves.
+  template <typename Construct>
+  iterator InsertWith_(size_type index, size_type count,
+                       Construct &&construct) {
+    if (size_ + count > capacity_) {
+      size_type new_capacity = std::max(capacity_ * 2, size_ + count);
+      pointer new_array = Allocate_(new_capacity);
+      try {
+        construct(new_array + index);
+      } catch (...) {
+        std::allocator<value_type>().deallocate(new_array, new_capacity);
+        throw;
+      }
+      if constexpr (kRelocatable_) {
+        Relocate_(array_, array_ + index, new_array);
+        Relocate_(array_ + index, array_ + size_, new_array + index + count);
+      } else {
+        try {
+          if constexpr (std::is_nothrow_move_constructible_v<value_type> ||
+                        !std::is_copy_constructible_v<value_type>) {
+            std::uninitialized_move(array_, array_ + index, new_array);
+            std::uninitialized_move(array_ + index, array_ + size_,
+                                    new_array + index + count);
+          } else {
+            std::uninitialized_copy(array_, array_ + index, new_array);
+            try {
+              std::uninitialized_copy(array_ + index, array_ + size_,
+                                      new_array + index + count);
+            } catch (...) {
+              std::destroy(new_array, new_array + index);
+              throw;
+            }
+          }
+        } catch (...) {
+          std::destroy(new_array + index, new_array + index + count);
+          std::allocator<value_type>().deallocate(new_array, new_capacity);
+          throw;
+        }
+        std::destroy(array_, array_ + size_);
+      }
+      FreeHeap_();
+      array_ = new_array;
+      capacity_ = new_capacity;
+    } else if (index == size_) {
+      construct(array_ + size_);
+    } else {
+      OpenGap_(index, count);
+      try {
+        construct(array_ + index);
+      } catch (...) {
+        if constexpr (kRelocatable_) {
+          std::memmove(static_cast<void *>(array_ + index),
+                       static_cast<void *>(array_ + index + count),
+                       (size_ - index) * sizeof(value_type));
+        } else {
+          std::destroy(array_ + index + count, array_ + size_ + count);
+          size_ = index;
+        }
+        throw;
+      }
+    }
+    size_ += count;
+    return array_ + index;
+  }
+
+  void OpenGap_(size_type index, size_type count) {
+    pointer src = array_ + index;
+    if constexpr (kRelocatable_) {
+      std::memmove(static_cast<void *>(src + count), static_cast<void *>(src),
+                   (size_ - index) * sizeof(value_type));
+    } else {
+      pointer old_end = array_ + size_;
+      if (count < size_ - index) {
+        std::uninitialized_move(old_end - count, old_end, old_end);
+        std::move_backward(src, old_end - count, old_end);
+        std::destroy(src, src + count);
+      } else {
+        std::uninitialized_move(src, old_end, src + count);
+        std::destroy(src, old_end);
+      }
+    }
+  }
+
+  size_type size_;
+  size_type capacity_;
+  pointer array_;
+  alignas(value_type) unsigned char inline_[N * sizeof(value_type)];
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_SMALL_VECTOR_H_
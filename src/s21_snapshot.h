@@ -0,0 +1,566 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_SNAPSHOT_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_SNAPSHOT_H_
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "s21_vector.h"
+
+// Versioned binary snapshots of containers. A file is a snapshot_header
+// followed, at header.payload_offset, by the elements:
+//
+// * trivially copyable T: the raw bytes of all elements back to back, so
+//   save/load are single bulk copies for contiguous containers, and
+//   snapshot_view<T> maps the file and reads the elements in place;
+// * any other T: each element as written by s21::codec<T>::encode.
+//
+// The header records the element count and the writer's byte order, and
+// for raw payloads the element size and alignment; load and snapshot_view
+// reject files whose header does not match the element type they are
+// given. An encoded payload does not depend on the in-memory layout of T,
+// so its header stores element_size 0 and, in element_align, the codec
+// version: codec<T>::version if the codec declares one, else 1. Types
+// with the same size, alignment and encoding are not told apart.
+namespace s21 {
+struct snapshot_header {
+  static constexpr char kMagic[8] = {'S', '2', '1', 'S', 'N', 'A', 'P', 0};
+  static constexpr std::uint32_t kVersion = 1;
+  static constexpr std::uint32_t kByteOrder = 0x01020304;
+  static constexpr std::uint32_t kRawPayload = 1;
+
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint32_t flags;
+  std::uint32_t element_align;
+  std::uint64_t element_size;
+  std::uint64_t count;
+  std::uint64_t payload_offset;
+};
+
+static_assert(sizeof(snapshot_header) == 48,
+              "snapshot_header layout is part of the file format");
+
+// Buffered writer over a file descriptor, handed to codec<T>::encode.
+class snapshot_writer {
+ public:
+  explicit snapshot_writer(int fd) : fd_(fd), buffer_(new char[kCapacity_]) {}
+
+  void write(const void *src, std::size_t n) {
+    if (used_ + n > kCapacity_) {
+      flush();
+      if (n >= kCapacity_) {
+        WriteAll_(src, n);
+        return;
+      }
+    }
+    std::memcpy(buffer_.get() + used_, src, n);
+    used_ += n;
+  }
+
+  template <class T>
+  void write_value(const T &value) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "write_value copies raw bytes");
+    write(&value, sizeof(T));
+  }
+
+  void flush() {
+    WriteAll_(buffer_.get(), used_);
+    used_ = 0;
+  }
+
+ private:
+  static constexpr std::size_t kCapacity_ = std::size_t{1} << 16;
+
+  void WriteAll_(const void *src, std::size_t n) {
+    const char *p = static_cast<const char *>(src);
+    while (n != 0) {
+      ssize_t done = ::write(fd_, p, n);
+      if (done < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::system_error(errno, std::generic_category(),
+                                "snapshot: write");
+      }
+      p += done;
+      n -= static_cast<std::size_t>(done);
+    }
+  }
+
+  int fd_;
+  std::unique_ptr<char[]> buffer_;
+  std::size_t used_ = 0;
+};
+
+// Buffered reader over a file descriptor, handed to codec<T>::decode.
+// Running out of input throws std::runtime_error.
+class snapshot_reader {
+ public:
+  explicit snapshot_reader(int fd) : fd_(fd), buffer_(new char[kCapacity_]) {}
+
+  void read(void *dest, std::size_t n) {
+    char *out = static_cast<char *>(dest);
+    std::size_t buffered = std::min(n, end_ - pos_);
+    std::memcpy(out, buffer_.get() + pos_, buffered);
+    pos_ += buffered;
+    out += buffered;
+    n -= buffered;
+    if (n >= kCapacity_) {
+      ReadAll_(out, n);
+      return;
+    }
+    while (n != 0) {
+      Refill_();
+      std::size_t chunk = std::min(n, end_ - pos_);
+      std::memcpy(out, buffer_.get() + pos_, chunk);
+      pos_ += chunk;
+      out += chunk;
+      n -= chunk;
+    }
+  }
+
+  template <class T>
+  T read_value() {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "read_value copies raw bytes");
+    T value;
+    read(&value, sizeof(T));
+    return value;
+  }
+
+  void skip(std::size_t n) {
+    char scratch[64];
+    while (n != 0) {
+      std::size_t chunk = std::min(n, sizeof(scratch));
+      read(scratch, chunk);
+      n -= chunk;
+    }
+  }
+
+ private:
+  static constexpr std::size_t kCapacity_ = std::size_t{1} << 16;
+
+  // Reads up to n bytes; returns how many, 0 at end of file.
+  std::size_t ReadSome_(char *dest, std::size_t n) {
+    while (true) {
+      ssize_t done = ::read(fd_, dest, n);
+      if (done >= 0) {
+        return static_cast<std::size_t>(done);
+      }
+      if (errno != EINTR) {
+        throw std::system_error(errno, std::generic_category(),
+                                "snapshot: read");
+      }
+    }
+  }
+
+  void ReadAll_(char *dest, std::size_t n) {
+    while (n != 0) {
+      std::size_t done = ReadSome_(dest, n);
+      if (done == 0) {
+        throw std::runtime_error("snapshot: unexpected end of file");
+      }
+      dest += done;
+      n -= done;
+    }
+  }
+
+  void Refill_() {
+    pos_ = 0;
+    end_ = ReadSome_(buffer_.get(), kCapacity_);
+    if (end_ == 0) {
+      throw std::runtime_error("snapshot: unexpected end of file");
+    }
+  }
+
+  int fd_;
+  std::unique_ptr<char[]> buffer_;
+  std::size_t pos_ = 0;
+  std::size_t end_ = 0;
+};
+
+// Element encoding for types that are not trivially copyable. Specialize
+// it for your own types; decode must consume exactly what encode wrote.
+// A codec may declare a version, which the header records, so that files
+// written by an older encoding are rejected once the encoding changes:
+//
+//   template <>
+//   struct s21::codec<Person> {
+//     static constexpr std::uint32_t version = 2;
+//     static void encode(snapshot_writer &out, const Person &p) {
+//       codec<std::string>::encode(out, p.name);
+//       out.write_value(p.age);
+//     }
+//     static Person decode(snapshot_reader &in) {
+//       std::string name = codec<std::string>::decode(in);
+//       return Person{std::move(name), in.read_value<int>()};
+//     }
+//   };
+//
+// The primary template handles trivially copyable types as raw bytes.
+template <class T, class = void>
+struct codec {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "specialize s21::codec<T> to snapshot this type");
+
+  static void encode(snapshot_writer &out, const T &value) {
+    out.write_value(value);
+  }
+  static T decode(snapshot_reader &in) { return in.read_value<T>(); }
+};
+
+// Length-prefixed bytes.
+template <>
+struct codec<std::string> {
+  static void encode(snapshot_writer &out, const std::string &value) {
+    out.write_value<std::uint64_t>(value.size());
+    out.write(value.data(), value.size());
+  }
+  static std::string decode(snapshot_reader &in) {
+    std::string value(in.read_value<std::uint64_t>(), '\0');
+    in.read(value.data(), value.size());
+    return value;
+  }
+};
+
+// Count-prefixed elements, so vectors nest inside other codecs.
+template <class U, class Allocator, class GrowthPolicy>
+struct codec<s21::vector<U, Allocator, GrowthPolicy>> {
+  using Vector = s21::vector<U, Allocator, GrowthPolicy>;
+
+  static void encode(snapshot_writer &out, const Vector &value) {
+    out.write_value<std::uint64_t>(value.size());
+    if constexpr (std::is_trivially_copyable_v<U>) {
+      out.write(value.data(), value.size() * sizeof(U));
+    } else {
+      for (const U &item : value) {
+        codec<U>::encode(out, item);
+      }
+    }
+  }
+  static Vector decode(snapshot_reader &in) {
+    Vector value;
+    std::uint64_t count = in.read_value<std::uint64_t>();
+    if constexpr (std::is_trivially_copyable_v<U>) {
+      value.resize(count);
+      in.read(value.data(), count * sizeof(U));
+    } else {
+      value.reserve(count);
+      for (std::uint64_t i = 0; i < count; ++i) {
+        value.push_back(codec<U>::decode(in));
+      }
+    }
+    return value;
+  }
+};
+
+namespace internal {
+template <class T, class = void>
+struct CodecVersion : std::integral_constant<std::uint32_t, 1> {};
+
+template <class T>
+struct CodecVersion<T, std::void_t<decltype(codec<T>::version)>>
+    : std::integral_constant<std::uint32_t, codec<T>::version> {};
+
+template <class Container, class = void>
+struct HasResize : std::false_type {};
+
+template <class Container>
+struct HasResize<Container, std::void_t<decltype(std::declval<Container &>()
+                                                     .resize(0))>>
+    : std::true_type {};
+
+// Payload starts on a cache line, or on the element alignment if larger,
+// so a mapped payload is aligned for T.
+template <class T>
+snapshot_header MakeHeader(std::uint64_t count) {
+  snapshot_header header{};
+  std::memcpy(header.magic, snapshot_header::kMagic, sizeof(header.magic));
+  header.version = snapshot_header::kVersion;
+  header.byte_order = snapshot_header::kByteOrder;
+  header.flags =
+      std::is_trivially_copyable_v<T> ? snapshot_header::kRawPayload : 0;
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    header.element_align = alignof(T);
+    header.element_size = sizeof(T);
+  } else {
+    header.element_align = CodecVersion<T>::value;
+    header.element_size = 0;
+  }
+  header.count = count;
+  std::uint64_t align = std::max<std::uint64_t>(64, alignof(T));
+  header.payload_offset = (sizeof(header) + align - 1) / align * align;
+  return header;
+}
+
+template <class T>
+void CheckHeader(const snapshot_header &header) {
+  if (std::memcmp(header.magic, snapshot_header::kMagic,
+                  sizeof(header.magic)) != 0) {
+    throw std::runtime_error("snapshot: not a snapshot file");
+  }
+  if (header.version != snapshot_header::kVersion) {
+    throw std::runtime_error("snapshot: unsupported format version");
+  }
+  if (header.byte_order != snapshot_header::kByteOrder) {
+    throw std::runtime_error("snapshot: written with another byte order");
+  }
+  snapshot_header expected = MakeHeader<T>(header.count);
+  if (header.element_size != expected.element_size ||
+      header.element_align != expected.element_align ||
+      header.flags != expected.flags) {
+    throw std::runtime_error("snapshot: element type does not match");
+  }
+  if (header.payload_offset < sizeof(header) ||
+      header.payload_offset % alignof(T) != 0) {
+    throw std::runtime_error("snapshot: bad payload offset");
+  }
+}
+
+inline int OpenOrThrow(const std::string &path, int flags) {
+  int fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(),
+                            "snapshot: open " + path);
+  }
+  return fd;
+}
+
+// Closes fd when it goes out of scope.
+class FdGuard {
+ public:
+  explicit FdGuard(int fd) noexcept : fd_(fd) {}
+  FdGuard(const FdGuard &) = delete;
+  FdGuard &operator=(const FdGuard &) = delete;
+  ~FdGuard() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+  int get() const noexcept { return fd_; }
+
+ private:
+  int fd_;
+};
+}  // namespace internal
+
+// Writes c to fd at its current position. Contiguous containers of
+// trivially copyable elements are written with one bulk copy.
+template <class Container>
+void save(int fd, const Container &c) {
+  using T = typename Container::value_type;
+  snapshot_header header = internal::MakeHeader<T>(c.size());
+  snapshot_writer out(fd);
+  out.write(&header, sizeof(header));
+  // The pad grows with alignof(T), so it is written in zero-filled pieces.
+  static constexpr char kZeros[64] = {};
+  for (std::uint64_t pad = header.payload_offset - sizeof(header); pad > 0;) {
+    std::size_t n =
+        static_cast<std::size_t>(std::min<std::uint64_t>(pad, sizeof(kZeros)));
+    out.write(kZeros, n);
+    pad -= n;
+  }
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    out.write(c.data(), c.size() * sizeof(T));
+  } else {
+    for (const T &value : c) {
+      codec<T>::encode(out, value);
+    }
+  }
+  out.flush();
+}
+
+// Writes c to path + ".tmp", syncs it and renames it over path, so path
+// always holds either the previous snapshot or the complete new one.
+template <class Container>
+void save(const std::string &path, const Container &c) {
+  std::string tmp = path + ".tmp";
+  internal::FdGuard fd(
+      internal::OpenOrThrow(tmp, O_WRONLY | O_CREAT | O_TRUNC));
+  try {
+    save(fd.get(), c);
+    if (fsync(fd.get()) != 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "snapshot: fsync");
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "snapshot: rename " + path);
+    }
+  } catch (...) {
+    ::unlink(tmp.c_str());
+    throw;
+  }
+}
+
+// Reads a snapshot from fd at its current position into out. Containers
+// with resize() are resized to the stored count; others, like s21::array,
+// must already have exactly that many elements.
+template <class Container>
+void load(int fd, Container &out) {
+  using T = typename Container::value_type;
+  snapshot_reader in(fd);
+  snapshot_header header;
+  in.read(&header, sizeof(header));
+  internal::CheckHeader<T>(header);
+  in.skip(header.payload_offset - sizeof(header));
+  if constexpr (internal::HasResize<Container>::value) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      out.resize(header.count);
+    } else {
+      out.clear();
+      out.reserve(header.count);
+    }
+  } else if (out.size() != header.count) {
+    throw std::runtime_error("snapshot: element count does not match");
+  }
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    in.read(out.data(), header.count * sizeof(T));
+  } else if constexpr (internal::HasResize<Container>::value) {
+    for (std::uint64_t i = 0; i < header.count; ++i) {
+      out.push_back(codec<T>::decode(in));
+    }
+  } else {
+    for (T &slot : out) {
+      slot = codec<T>::decode(in);
+    }
+  }
+}
+
+template <class Container>
+void load(const std::string &path, Container &out) {
+  internal::FdGuard fd(internal::OpenOrThrow(path, O_RDONLY));
+  load(fd.get(), out);
+}
+
+// Read-only view of a snapshot of trivially copyable T, mapped straight
+// from the file: construction validates the header and maps the file, and
+// elements are read in place with no per-element work.
+template <class T>
+class snapshot_view {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "only raw snapshots can be viewed in place");
+
+ public:
+  using value_type = T;
+  using const_reference = const T &;
+  using const_iterator = const T *;
+  using size_type = std::size_t;
+
+  explicit snapshot_view(const std::string &path) {
+    internal::FdGuard fd(internal::OpenOrThrow(path, O_RDONLY));
+    struct stat st;
+    if (fstat(fd.get(), &st) != 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "snapshot: fstat");
+    }
+    std::size_t bytes = static_cast<std::size_t>(st.st_size);
+    if (bytes < sizeof(snapshot_header)) {
+      throw std::runtime_error("snapshot: not a snapshot file");
+    }
+    void *p = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd.get(), 0);
+    if (p == MAP_FAILED) {
+      throw std::system_error(errno, std::generic_category(),
+                              "snapshot: mmap");
+    }
+    map_ = p;
+    map_bytes_ = bytes;
+    snapshot_header header;
+    std::memcpy(&header, map_, sizeof(header));
+    try {
+      internal::CheckHeader<T>(header);
+      if (header.payload_offset > bytes ||
+          header.count > (bytes - header.payload_offset) / sizeof(T)) {
+        throw std::runtime_error("snapshot: file is truncated");
+      }
+    } catch (...) {
+      Unmap_();
+      throw;
+    }
+    data_ = reinterpret_cast<const T *>(static_cast<const char *>(map_) +
+                                        header.payload_offset);
+    size_ = header.count;
+  }
+
+  snapshot_view(const snapshot_view &) = delete;
+  snapshot_view &operator=(const snapshot_view &) = delete;
+
+  snapshot_view(snapshot_view &&other) noexcept
+      : map_(std::exchange(other.map_, nullptr)),
+        map_bytes_(std::exchange(other.map_bytes_, 0)),
+        data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)) {}
+
+  snapshot_view &operator=(snapshot_view &&other) noexcept {
+    if (this != &other) {
+      Unmap_();
+      map_ = std::exchange(other.map_, nullptr);
+      map_bytes_ = std::exchange(other.map_bytes_, 0);
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  ~snapshot_view() { Unmap_(); }
+
+  const_reference at(size_type pos) const {
+    if (pos >= size_) {
+      throw std::out_of_range("Out of bound exeption");
+    }
+    return data_[pos];
+  }
+
+  const_reference operator[](size_type pos) const { return data_[pos]; }
+
+  const_reference front() const { return *data_; }
+
+  const_reference back() const { return data_[size_ - 1]; }
+
+  const T *data() const noexcept { return data_; }
+
+  const_iterator begin() const noexcept { return data_; }
+
+  const_iterator end() const noexcept { return data_ + size_; }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+ private:
+  void Unmap_() noexcept {
+    if (map_ != nullptr) {
+      munmap(map_, map_bytes_);
+      map_ = nullptr;
+    }
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  void *map_ = nullptr;
+  std::size_t map_bytes_ = 0;
+  const T *data_ = nullptr;
+  size_type size_ = 0;
+};
+}  // namespace s21
+
+#endif  // defined(__unix__) || defined(__APPLE__)
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_SNAPSHOT_H_
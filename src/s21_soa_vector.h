@@ -0,0 +1,616 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_SOA_VECTOR_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_SOA_VECTOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "s21_memory.h"
+
+namespace s21 {
+// Contiguous run of one soa_vector column. Stays valid until the vector
+// reallocates, like a pointer into s21::vector.
+template <class T>
+class column_span {
+ public:
+  using value_type = std::remove_const_t<T>;
+  using reference = T &;
+  using iterator = T *;
+  using size_type = std::size_t;
+
+  constexpr column_span() noexcept = default;
+  constexpr column_span(T *data, size_type size) noexcept
+      : data_(data), size_(size) {}
+
+  constexpr reference operator[](size_type pos) const { return data_[pos]; }
+
+  constexpr reference front() const { return *data_; }
+
+  constexpr reference back() const { return data_[size_ - 1]; }
+
+  constexpr T *data() const noexcept { return data_; }
+
+  constexpr iterator begin() const noexcept { return data_; }
+
+  constexpr iterator end() const noexcept { return data_ + size_; }
+
+  constexpr bool empty() const noexcept { return size_ == 0; }
+
+  constexpr size_type size() const noexcept { return size_; }
+
+ private:
+  T *data_ = nullptr;
+  size_type size_ = 0;
+};
+
+// Vector of rows (Ts...) stored column by column: column I is a contiguous
+// array of the I-th fields, so a loop over get<I>() reads only that field.
+// All columns share one allocation, each starting on a 64-byte boundary,
+// and grow together. Rows are accessed through proxy references, tuples of
+// references to the row's fields:
+//
+//   s21::soa_vector<float, float, int> particles;
+//   particles.emplace_back(1.0f, 2.0f, 7);
+//   for (float &x : particles.get<0>()) x += 1.0f;
+//   auto [x, y, id] = particles[0];  // float &, float &, int &
+//
+// Iterators and references are invalidated as for s21::vector.
+template <class... Ts>
+class soa_vector {
+  static_assert(sizeof...(Ts) != 0, "soa_vector needs at least one column");
+
+  template <std::size_t I>
+  using Column_ = std::tuple_element_t<I, std::tuple<Ts...>>;
+  using Columns_ = std::tuple<Ts *...>;
+  static constexpr std::size_t kColumns_ = sizeof...(Ts);
+  static constexpr std::size_t kAlign_ =
+      std::max({std::size_t{64}, alignof(Ts)...});
+  using Allocator_ = aligned_allocator<unsigned char, kAlign_>;
+
+  template <bool kConst>
+  class Iterator_;
+
+ public:
+  using value_type = std::tuple<Ts...>;
+  using reference = std::tuple<Ts &...>;
+  using const_reference = std::tuple<const Ts &...>;
+  using iterator = Iterator_<false>;
+  using const_iterator = Iterator_<true>;
+  using size_type = std::size_t;
+
+  soa_vector() noexcept = default;
+
+  explicit soa_vector(size_type n) { resize(n); }
+
+  soa_vector(std::initializer_list<value_type> const &items) {
+    reserve(items.size());
+    for (const value_type &item : items) {
+      push_back(item);
+    }
+  }
+
+  soa_vector(const soa_vector &other) {
+    Adopt_(Allocate_(other.size_), other.size_);
+    CopyRows_(other.columns_, other.size_);
+    size_ = other.size_;
+  }
+
+  soa_vector(soa_vector &&other) noexcept { swap(other); }
+
+  ~soa_vector() {
+    DestroyRows_(columns_, 0, size_);
+    Deallocate_(block_, capacity_);
+  }
+
+  soa_vector &operator=(const soa_vector &other) {
+    if (this != &other) {
+      soa_vector copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  soa_vector &operator=(soa_vector &&other) noexcept {
+    if (this != &other) {
+      soa_vector moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+
+  reference at(size_type pos) {
+    if (pos >= size_) {
+      throw std::out_of_range("Out of bound exeption");
+    }
+    return (*this)[pos];
+  }
+
+  const_reference at(size_type pos) const {
+    if (pos >= size_) {
+      throw std::out_of_range("Out of bound exeption");
+    }
+    return (*this)[pos];
+  }
+
+  reference operator[](size_type pos) {
+    return Row_<reference>(pos, std::index_sequence_for<Ts...>());
+  }
+
+  const_reference operator[](size_type pos) const {
+    return Row_<const_reference>(pos, std::index_sequence_for<Ts...>());
+  }
+
+  reference front() { return (*this)[0]; }
+
+  const_reference front() const { return (*this)[0]; }
+
+  reference back() { return (*this)[size_ - 1]; }
+
+  const_reference back() const { return (*this)[size_ - 1]; }
+
+  // Column I as a contiguous span of size() elements.
+  template <std::size_t I>
+  column_span<Column_<I>> get() noexcept {
+    return {std::get<I>(columns_), size_};
+  }
+
+  template <std::size_t I>
+  column_span<const Column_<I>> get() const noexcept {
+    return {std::get<I>(columns_), size_};
+  }
+
+  template <std::size_t I>
+  Column_<I> *data() noexcept {
+    return std::get<I>(columns_);
+  }
+
+  template <std::size_t I>
+  const Column_<I> *data() const noexcept {
+    return std::get<I>(columns_);
+  }
+
+  iterator begin() noexcept { return iterator(this, 0); }
+
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+  iterator end() noexcept { return iterator(this, size_); }
+
+  const_iterator end() const noexcept { return const_iterator(this, size_); }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type capacity() const noexcept { return capacity_; }
+
+  size_type max_size() const noexcept {
+    constexpr size_type kMaxBytes = std::numeric_limits<std::ptrdiff_t>::max();
+    return (kMaxBytes - kColumns_ * kAlign_) / (sizeof(Ts) + ...);
+  }
+
+  void reserve(size_type size) {
+    if (size > max_size()) {
+      throw std::length_error("soa_vector capacity exceeds max_size");
+    }
+    if (size > capacity_) {
+      Reallocate_(size);
+    }
+  }
+
+  void shrink_to_fit() {
+    if (size_ < capacity_) {
+      Reallocate_(size_);
+    }
+  }
+
+  void clear() noexcept {
+    DestroyRows_(columns_, 0, size_);
+    size_ = 0;
+  }
+
+  iterator insert(const_iterator pos, const value_type &value) {
+    return InsertRow_(pos.index_, value);
+  }
+
+  iterator insert(const_iterator pos, value_type &&value) {
+    return InsertRow_(pos.index_, std::move(value));
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type from = first.index_;
+    size_type to = last.index_;
+    if (from != to) {
+      ForEachColumn_([&](auto column) {
+        auto *data = std::get<column>(columns_);
+        std::move(data + to, data + size_, data + from);
+      });
+      DestroyRows_(columns_, size_ - (to - from), size_);
+      size_ -= to - from;
+    }
+    return iterator(this, from);
+  }
+
+  void push_back(const value_type &value) { EmplaceRow_(value); }
+
+  void push_back(value_type &&value) { EmplaceRow_(std::move(value)); }
+
+  // Appends a row built from one constructor argument per column.
+  template <class... Args>
+  reference emplace_back(Args &&...args) {
+    static_assert(sizeof...(Args) == kColumns_,
+                  "emplace_back takes one argument per column");
+    EmplaceRow_(std::forward_as_tuple(std::forward<Args>(args)...));
+    return back();
+  }
+
+  void pop_back() {
+    DestroyRows_(columns_, size_ - 1, size_);
+    --size_;
+  }
+
+  void resize(size_type count) { ResizeWith_(count, nullptr); }
+
+  void resize(size_type count, const value_type &value) {
+    ResizeWith_(count, &value);
+  }
+
+  void swap(soa_vector &other) noexcept {
+    std::swap(block_, other.block_);
+    std::swap(columns_, other.columns_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+ private:
+  template <bool kConst>
+  class Iterator_ {
+    using Owner_ = std::conditional_t<kConst, const soa_vector, soa_vector>;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = soa_vector::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<kConst, soa_vector::const_reference,
+                                         soa_vector::reference>;
+    using pointer = void;
+
+    Iterator_() noexcept = default;
+
+    template <bool kOther, class = std::enable_if_t<kConst && !kOther>>
+    Iterator_(const Iterator_<kOther> &other) noexcept
+        : owner_(other.owner_), index_(other.index_) {}
+
+    reference operator*() const { return (*owner_)[index_]; }
+
+    reference operator[](difference_type n) const {
+      return (*owner_)[index_ + n];
+    }
+
+    Iterator_ &operator++() {
+      ++index_;
+      return *this;
+    }
+
+    Iterator_ operator++(int) {
+      Iterator_ old = *this;
+      ++index_;
+      return old;
+    }
+
+    Iterator_ &operator--() {
+      --index_;
+      return *this;
+    }
+
+    Iterator_ operator--(int) {
+      Iterator_ old = *this;
+      --index_;
+      return old;
+    }
+
+    Iterator_ &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+
+    Iterator_ &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+
+    Iterator_ operator+(difference_type n) const {
+      return Iterator_(owner_, index_ + n);
+    }
+
+    Iterator_ operator-(difference_type n) const {
+      return Iterator_(owner_, index_ - n);
+    }
+
+    difference_type operator-(const Iterator_ &other) const {
+      return static_cast<difference_type>(index_) -
+             static_cast<difference_type>(other.index_);
+    }
+
+    bool operator==(const Iterator_ &other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const Iterator_ &other) const {
+      return index_ != other.index_;
+    }
+    bool operator<(const Iterator_ &other) const {
+      return index_ < other.index_;
+    }
+    bool operator>(const Iterator_ &other) const {
+      return index_ > other.index_;
+    }
+    bool operator<=(const Iterator_ &other) const {
+      return index_ <= other.index_;
+    }
+    bool operator>=(const Iterator_ &other) const {
+      return index_ >= other.index_;
+    }
+
+   private:
+    friend class soa_vector;
+    template <bool>
+    friend class Iterator_;
+
+    Iterator_(Owner_ *owner, size_type index) noexcept
+        : owner_(owner), index_(index) {}
+
+    Owner_ *owner_ = nullptr;
+    size_type index_ = 0;
+  };
+
+  // Calls fn(std::integral_constant<std::size_t, I>()) for every column.
+  template <class Fn>
+  static void ForEachColumn_(Fn &&fn) {
+    ForEachColumn_(fn, std::index_sequence_for<Ts...>());
+  }
+
+  template <class Fn, std::size_t... Is>
+  static void ForEachColumn_(Fn &fn, std::index_sequence<Is...>) {
+    (fn(std::integral_constant<std::size_t, Is>()), ...);
+  }
+
+  // Runs step for every column; if one throws, runs undo for the columns
+  // whose step completed, so a failed row or range operation leaves no
+  // column half-built.
+  template <class Step, class Undo>
+  static void ForEachColumnOrUndo_(Step &&step, Undo &&undo) {
+    std::size_t done = 0;
+    try {
+      ForEachColumn_([&](auto column) {
+        step(column);
+        ++done;
+      });
+    } catch (...) {
+      ForEachColumn_([&](auto column) {
+        if (column < done) {
+          undo(column);
+        }
+      });
+      throw;
+    }
+  }
+
+  template <class Row, std::size_t... Is>
+  Row Row_(size_type pos, std::index_sequence<Is...>) const {
+    return Row(std::get<Is>(columns_)[pos]...);
+  }
+
+  static size_type ColumnBytes_(size_type bytes) noexcept {
+    return (bytes + kAlign_ - 1) / kAlign_ * kAlign_;
+  }
+
+  static size_type BlockBytes_(size_type capacity) noexcept {
+    return (ColumnBytes_(capacity * sizeof(Ts)) + ...);
+  }
+
+  static unsigned char *Allocate_(size_type capacity) {
+    return capacity == 0 ? nullptr
+                         : Allocator_().allocate(BlockBytes_(capacity));
+  }
+
+  static void Deallocate_(unsigned char *block, size_type capacity) noexcept {
+    if (block != nullptr) {
+      Allocator_().deallocate(block, BlockBytes_(capacity));
+    }
+  }
+
+  // Column start addresses inside a block of the given capacity.
+  static Columns_ Carve_(unsigned char *block, size_type capacity) noexcept {
+    Columns_ columns{};
+    if (block != nullptr) {
+      size_type offset = 0;
+      ForEachColumn_([&](auto column) {
+        using T = Column_<column>;
+        std::get<column>(columns) = reinterpret_cast<T *>(block + offset);
+        offset += ColumnBytes_(capacity * sizeof(T));
+      });
+    }
+    return columns;
+  }
+
+  void Adopt_(unsigned char *block, size_type capacity) noexcept {
+    block_ = block;
+    columns_ = Carve_(block, capacity);
+    capacity_ = capacity;
+  }
+
+  size_type GrowCapacity_(size_type required) const {
+    if (required > max_size()) {
+      throw std::length_error("soa_vector capacity exceeds max_size");
+    }
+    return std::min(growth::doubling::next(capacity_, required, 0),
+                    max_size());
+  }
+
+  static void DestroyRows_(const Columns_ &columns, size_type first,
+                           size_type last) noexcept {
+    ForEachColumn_([&](auto column) {
+      auto *data = std::get<column>(columns);
+      std::destroy(data + first, data + last);
+    });
+  }
+
+  // Builds row pos of columns from get<I>(source) for every column I.
+  template <class Tuple>
+  static void ConstructRow_(const Columns_ &columns, size_type pos,
+                            Tuple &&source) {
+    ForEachColumnOrUndo_(
+        [&](auto column) {
+          ::new (static_cast<void *>(std::get<column>(columns) + pos))
+              Column_<column>(std::get<column>(std::forward<Tuple>(source)));
+        },
+        [&](auto column) { std::destroy_at(std::get<column>(columns) + pos); });
+  }
+
+  // Moves the first count rows into the empty columns of to, copying
+  // columns whose move constructor may throw.
+  void RelocateRows_(const Columns_ &to, size_type count) {
+    ForEachColumnOrUndo_(
+        [&](auto column) {
+          using T = Column_<column>;
+          T *from = std::get<column>(columns_);
+          if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                        !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move(from, from + count, std::get<column>(to));
+          } else {
+            std::uninitialized_copy(from, from + count, std::get<column>(to));
+          }
+        },
+        [&](auto column) {
+          auto *data = std::get<column>(to);
+          std::destroy(data, data + count);
+        });
+  }
+
+  // Copies count rows of from into this vector's empty columns.
+  void CopyRows_(const Columns_ &from, size_type count) {
+    try {
+      ForEachColumnOrUndo_(
+          [&](auto column) {
+            auto *source = std::get<column>(from);
+            std::uninitialized_copy(source, source + count,
+                                    std::get<column>(columns_));
+          },
+          [&](auto column) {
+            auto *data = std::get<column>(columns_);
+            std::destroy(data, data + count);
+          });
+    } catch (...) {
+      Deallocate_(block_, capacity_);
+      throw;
+    }
+  }
+
+  void Reallocate_(size_type new_capacity) {
+    unsigned char *block = Allocate_(new_capacity);
+    Columns_ columns = Carve_(block, new_capacity);
+    try {
+      RelocateRows_(columns, size_);
+    } catch (...) {
+      Deallocate_(block, new_capacity);
+      throw;
+    }
+    DestroyRows_(columns_, 0, size_);
+    Deallocate_(block_, capacity_);
+    Adopt_(block, new_capacity);
+  }
+
+  // Appends a row. On growth the row is built in the new block before the
+  // old rows move, so source may refer to an element of this vector.
+  template <class Tuple>
+  void EmplaceRow_(Tuple &&source) {
+    if (size_ < capacity_) {
+      ConstructRow_(columns_, size_, std::forward<Tuple>(source));
+      ++size_;
+      return;
+    }
+    size_type new_capacity = GrowCapacity_(size_ + 1);
+    unsigned char *block = Allocate_(new_capacity);
+    Columns_ columns = Carve_(block, new_capacity);
+    try {
+      ConstructRow_(columns, size_, std::forward<Tuple>(source));
+      try {
+        RelocateRows_(columns, size_);
+      } catch (...) {
+        DestroyRows_(columns, size_, size_ + 1);
+        throw;
+      }
+    } catch (...) {
+      Deallocate_(block, new_capacity);
+      throw;
+    }
+    DestroyRows_(columns_, 0, size_);
+    Deallocate_(block_, capacity_);
+    Adopt_(block, new_capacity);
+    ++size_;
+  }
+
+  template <class Tuple>
+  iterator InsertRow_(size_type pos, Tuple &&source) {
+    EmplaceRow_(std::forward<Tuple>(source));
+    if (pos + 1 != size_) {
+      ForEachColumn_([&](auto column) {
+        auto *data = std::get<column>(columns_);
+        std::rotate(data + pos, data + size_ - 1, data + size_);
+      });
+    }
+    return iterator(this, pos);
+  }
+
+  // Shrinks to count rows, or grows with rows copied from *value, or
+  // value-initialized when value is null.
+  void ResizeWith_(size_type count, const value_type *value) {
+    if (count <= size_) {
+      DestroyRows_(columns_, count, size_);
+      size_ = count;
+      return;
+    }
+    if (count > capacity_) {
+      if (value != nullptr) {
+        // value may be a row of this vector, which the reallocation moves.
+        value_type copy(*value);
+        Reallocate_(GrowCapacity_(count));
+        return ResizeWith_(count, &copy);
+      }
+      Reallocate_(GrowCapacity_(count));
+    }
+    ForEachColumnOrUndo_(
+        [&](auto column) {
+          auto *data = std::get<column>(columns_);
+          if (value == nullptr) {
+            std::uninitialized_value_construct(data + size_, data + count);
+          } else {
+            std::uninitialized_fill(data + size_, data + count,
+                                    std::get<column>(*value));
+          }
+        },
+        [&](auto column) {
+          auto *data = std::get<column>(columns_);
+          std::destroy(data + size_, data + count);
+        });
+    size_ = count;
+  }
+
+  unsigned char *block_ = nullptr;
+  Columns_ columns_{};
+  size_type size_ = 0;
+  size_type capacity_ = 0;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_SOA_VECTOR_H_
@@ -0,0 +1,188 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_SPSC_QUEUE_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_SPSC_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "s21_memory.h"
+
+namespace s21 {
+// Bounded wait-free FIFO between exactly one producer thread and one
+// consumer thread. Only the producer may call the push functions and only
+// the consumer the pop functions; empty(), size() and capacity() may be
+// called from either.
+//
+// The ring has a power-of-two number of slots. head (next slot to pop) and
+// tail (next slot to push) sit on separate cache lines and each side keeps
+// a private copy of the other side's index, so the shared line is read
+// only when the cached copy says the queue is full (producer) or empty
+// (consumer). Elements are moved in and out, as with s21::queue.
+template <class T, class Allocator = std::allocator<T>>
+class spsc_queue {
+  using AllocTraits_ = std::allocator_traits<Allocator>;
+
+ public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+
+  static_assert(std::is_same_v<typename AllocTraits_::value_type, T>,
+                "Allocator::value_type must be T");
+
+  // Capacity is rounded up to a power of two.
+  explicit spsc_queue(size_type capacity,
+                      const Allocator &alloc = Allocator())
+      : alloc_(alloc) {
+    capacity_ = 1;
+    while (capacity_ < capacity) {
+      capacity_ *= 2;
+    }
+    slots_ = AllocTraits_::allocate(alloc_, capacity_);
+  }
+
+  spsc_queue(const spsc_queue &) = delete;
+  spsc_queue &operator=(const spsc_queue &) = delete;
+
+  ~spsc_queue() {
+    size_type head = consumer_.index.load(std::memory_order_relaxed);
+    size_type tail = producer_.index.load(std::memory_order_relaxed);
+    for (; head != tail; ++head) {
+      AllocTraits_::destroy(alloc_, Slot_(head));
+    }
+    AllocTraits_::deallocate(alloc_, slots_, capacity_);
+  }
+
+  // Producer side. Each returns false, leaving the argument untouched,
+  // when the queue is full.
+  bool try_push(const T &value) { return try_emplace(value); }
+
+  bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+  template <typename... Args>
+  bool try_emplace(Args &&...args) {
+    size_type tail = producer_.index.load(std::memory_order_relaxed);
+    if (tail - producer_.cached_other == capacity_) {
+      producer_.cached_other = consumer_.index.load(std::memory_order_acquire);
+      if (tail - producer_.cached_other == capacity_) {
+        return false;
+      }
+    }
+    AllocTraits_::construct(alloc_, Slot_(tail), std::forward<Args>(args)...);
+    producer_.index.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Copies up to n elements from first; returns how many fit. All of them
+  // are published with one release store.
+  size_type try_push(const T *first, size_type n) {
+    size_type tail = producer_.index.load(std::memory_order_relaxed);
+    if (capacity_ - (tail - producer_.cached_other) < n) {
+      producer_.cached_other = consumer_.index.load(std::memory_order_acquire);
+    }
+    n = std::min(n, capacity_ - (tail - producer_.cached_other));
+    size_type done = 0;
+    try {
+      for (; done < n; ++done) {
+        AllocTraits_::construct(alloc_, Slot_(tail + done), first[done]);
+      }
+    } catch (...) {
+      producer_.index.store(tail + done, std::memory_order_release);
+      throw;
+    }
+    producer_.index.store(tail + n, std::memory_order_release);
+    return n;
+  }
+
+  // Consumer side. try_pop returns false when the queue is empty.
+  bool try_pop(T &out) {
+    T *slot = front();
+    if (slot == nullptr) {
+      return false;
+    }
+    out = std::move(*slot);
+    pop();
+    return true;
+  }
+
+  // Moves up to n elements into out[0, n); returns how many. The slots are
+  // released to the producer with one release store. If a move throws,
+  // the elements already moved out are released and the rest stay queued.
+  size_type try_pop(T *out, size_type n) {
+    size_type head = consumer_.index.load(std::memory_order_relaxed);
+    if (consumer_.cached_other - head < n) {
+      consumer_.cached_other = producer_.index.load(std::memory_order_acquire);
+    }
+    n = std::min(n, consumer_.cached_other - head);
+    size_type done = 0;
+    try {
+      for (; done < n; ++done) {
+        T *slot = Slot_(head + done);
+        out[done] = std::move(*slot);
+        AllocTraits_::destroy(alloc_, slot);
+      }
+    } catch (...) {
+      consumer_.index.store(head + done, std::memory_order_release);
+      throw;
+    }
+    consumer_.index.store(head + n, std::memory_order_release);
+    return n;
+  }
+
+  // Oldest element, or nullptr when empty; it stays in place until pop().
+  T *front() {
+    size_type head = consumer_.index.load(std::memory_order_relaxed);
+    if (head == consumer_.cached_other) {
+      consumer_.cached_other = producer_.index.load(std::memory_order_acquire);
+      if (head == consumer_.cached_other) {
+        return nullptr;
+      }
+    }
+    return Slot_(head);
+  }
+
+  // Removes the element front() returned; the queue must not be empty.
+  void pop() {
+    size_type head = consumer_.index.load(std::memory_order_relaxed);
+    AllocTraits_::destroy(alloc_, Slot_(head));
+    consumer_.index.store(head + 1, std::memory_order_release);
+  }
+
+  // Exact on the producer or consumer thread when the other is idle,
+  // otherwise a snapshot.
+  size_type size() const noexcept {
+    size_type head = consumer_.index.load(std::memory_order_acquire);
+    size_type tail = producer_.index.load(std::memory_order_acquire);
+    return tail - head;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  size_type capacity() const noexcept { return capacity_; }
+
+ private:
+  // One side's own index, which only that side writes, next to its cached
+  // copy of the other side's index, on a cache line of its own.
+  struct alignas(cache_line_size) Side_ {
+    std::atomic<size_type> index{0};
+    size_type cached_other = 0;
+  };
+
+  T *Slot_(size_type index) const noexcept {
+    return slots_ + (index & (capacity_ - 1));
+  }
+
+  Side_ producer_;
+  Side_ consumer_;
+  alignas(cache_line_size) T *slots_ = nullptr;
+  size_type capacity_ = 0;
+  allocator_type alloc_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_SPSC_QUEUE_H_
@@ -2,55 +2,84 @@
 #ifndef CPP2_S21_CONTAINERS_SRC_S21_STACK_H_
 #define CPP2_S21_CONTAINERS_SRC_S21_STACK_H_
 
-#include "s21_list.h"
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+#include "s21_vector.h"
 
 namespace s21 {
-template <typename T>
+// LIFO adapter over any Container with back, push_back, emplace_back and
+// pop_back, such as s21::vector (the default), s21::deque or s21::list.
+template <typename T, class Container = s21::vector<T>>
 class stack {
  public:
+  using container_type = Container;
   using value_type = T;
   using reference = T &;
   using const_reference = const T &;
   using size_type = std::size_t;
 
-  stack() : head_() {}
+  stack() : container_() {}
+
+  explicit stack(const Container &container) : container_(container) {}
+
+  explicit stack(Container &&container) : container_(std::move(container)) {}
 
   explicit stack(std::initializer_list<value_type> const &items) {
-    for (value_type i : items) {
-      head_.push_back(i);
+    for (const value_type &item : items) {
+      container_.push_back(item);
     }
   }
 
-  stack(const stack &other) : head_(other.head_) {}
+  stack(const stack &other) : container_(other.container_) {}
 
-  stack(stack &&other) : head_(std::move(other.head_)) {}
+  stack(stack &&other) noexcept(
+      std::is_nothrow_move_constructible_v<Container>)
+      : container_(std::move(other.container_)) {}
 
   ~stack() {}
 
-  stack &operator=(stack &&other) {
-    head_ = std::move(other.head_);
+  stack &operator=(stack &&other) noexcept(
+      std::is_nothrow_move_assignable_v<Container>) {
+    container_ = std::move(other.container_);
     return *this;
   }
 
   stack &operator=(const stack &other) {
-    head_ = other.head_;
+    container_ = other.container_;
     return *this;
   }
 
-  const_reference top() { return head_.back(); }
+  reference top() { return container_.back(); }
 
-  bool empty() { return head_.empty(); }
+  const_reference top() const { return container_.back(); }
 
-  size_type size() { return head_.size(); }
+  bool empty() const { return container_.empty(); }
 
-  void push(const_reference value) { head_.push_back(value); }
+  size_type size() const { return container_.size(); }
+
+  // Available when Container has reserve(), e.g. s21::vector.
+  template <class C = Container>
+  auto reserve(size_type n) -> decltype(std::declval<C &>().reserve(n)) {
+    return container_.reserve(n);
+  }
+
+  void push(const_reference value) { container_.push_back(value); }
+
+  void push(value_type &&value) { container_.push_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace(Args &&...args) {
+    return container_.emplace_back(std::forward<Args>(args)...);
+  }
 
-  void pop() { head_.pop_back(); }
+  void pop() { container_.pop_back(); }
 
-  void swap(stack &other) { head_.swap(other.head_); }
+  void swap(stack &other) { container_.swap(other.container_); }
 
  private:
-  s21::list<T> head_;
+  Container container_;
 };
 }  // namespace s21
 #endif  // CPP2_S21_CONTAINERS_SRC_S21_STACK_H_
@@ -0,0 +1,286 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_TASK_POOL_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_TASK_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "s21_concurrent_queue.h"
+#include "s21_memory.h"
+#include "s21_vector.h"
+#include "s21_ws_deque.h"
+
+namespace s21 {
+// Fork-join scheduler: a fixed set of workers, each owning an s21::ws_deque
+// of tasks. A task spawned on a worker goes to the bottom of that worker's
+// deque, where the worker picks it up again LIFO while it is still in
+// cache; idle workers steal from the top of a randomly chosen victim.
+// Tasks spawned from other threads enter through a shared injection queue.
+// Workers with nothing to run or steal sleep until a spawn wakes them.
+//
+// Tasks are counted in a task_pool::group, and wait(group) returns once
+// every task spawned into it, including tasks those tasks spawned, has
+// finished. The waiting thread runs queued tasks meanwhile, so waiting
+// inside a task never blocks a worker. The first exception thrown by a
+// task of a group is rethrown by wait().
+class task_pool {
+ public:
+  using size_type = std::size_t;
+
+  class group {
+   public:
+    group() = default;
+    group(const group &) = delete;
+    group &operator=(const group &) = delete;
+
+   private:
+    friend class task_pool;
+
+    std::atomic<size_type> pending_{0};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+  };
+
+  explicit task_pool(size_type threads = DefaultThreads_()) {
+    threads = std::max<size_type>(threads, 1);
+    workers_.reserve(threads);
+    for (size_type i = 0; i < threads; ++i) {
+      workers_.push_back(std::make_unique<Worker_>(i));
+    }
+    threads_.reserve(threads);
+    for (size_type i = 0; i < threads; ++i) {
+      threads_.push_back(std::thread([this, i] { WorkerLoop_(i); }));
+    }
+  }
+
+  task_pool(const task_pool &) = delete;
+  task_pool &operator=(const task_pool &) = delete;
+
+  // Runs what is still queued, then joins the workers. An exception from
+  // a root task that nobody waited for is dropped; a destructor cannot
+  // rethrow it.
+  ~task_pool() {
+    Drain_(root_);
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &thread : threads_) {
+      thread.join();
+    }
+  }
+
+  size_type size() const noexcept { return workers_.size(); }
+
+  template <class Fn>
+  void spawn(group &g, Fn &&fn) {
+    auto task = std::make_unique<Task_>(
+        Task_{std::function<void()>(std::forward<Fn>(fn)), &g});
+    g.pending_.fetch_add(1, std::memory_order_relaxed);
+    queued_.fetch_add(1, std::memory_order_seq_cst);
+    try {
+      if (tls_pool_ == this) {
+        workers_[tls_index_]->deque.push(task.get());
+      } else {
+        injected_.push(task.get());
+      }
+    } catch (...) {
+      queued_.fetch_sub(1, std::memory_order_relaxed);
+      g.pending_.fetch_sub(1, std::memory_order_relaxed);
+      throw;
+    }
+    task.release();
+    if (sleepers_.load(std::memory_order_seq_cst) != 0) {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      wake_.notify_one();
+    }
+  }
+
+  // Spawns into the pool's own group, which wait() drains. Meant for code
+  // outside the pool; tasks that fork should use a group of their own.
+  template <class Fn>
+  void spawn(Fn &&fn) {
+    spawn(root_, std::forward<Fn>(fn));
+  }
+
+  void wait(group &g) {
+    if (std::exception_ptr error = Drain_(g)) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  void wait() { wait(root_); }
+
+  // Calls fn(b, e) over subranges of [begin, end) of at most grain indices.
+  // The range is halved recursively: each half that is split off is
+  // spawned, so idle workers steal the largest pieces first, and the
+  // calling thread keeps working on the other half.
+  template <class Fn>
+  void parallel_for(size_type begin, size_type end, size_type grain,
+                    Fn &&fn) {
+    group g;
+    try {
+      SplitFor_(g, begin, end, std::max<size_type>(grain, 1), fn);
+    } catch (...) {
+      Fail_(g);
+    }
+    wait(g);
+  }
+
+ private:
+  struct Task_ {
+    std::function<void()> fn;
+    group *owner;
+  };
+
+  struct alignas(cache_line_size) Worker_ {
+    explicit Worker_(size_type index)
+        : rng(0x9E3779B97F4A7C15ULL * (index + 1)) {}
+
+    ws_deque<Task_ *> deque;
+    std::uint64_t rng;
+  };
+
+  static size_type DefaultThreads_() {
+    return std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  template <class Fn>
+  void SplitFor_(group &g, size_type begin, size_type end, size_type grain,
+                 Fn &fn) {
+    while (end - begin > grain) {
+      size_type mid = begin + (end - begin) / 2;
+      spawn(g, [this, &g, mid, end, grain, &fn] {
+        SplitFor_(g, mid, end, grain, fn);
+      });
+      end = mid;
+    }
+    if (begin < end) {
+      fn(begin, end);
+    }
+  }
+
+  // Helps until every task of g has finished and takes g's first error.
+  std::exception_ptr Drain_(group &g) {
+    while (g.pending_.load(std::memory_order_acquire) != 0) {
+      if (!RunOne_()) {
+        std::this_thread::yield();
+      }
+    }
+    std::lock_guard<std::mutex> lock(g.error_mutex_);
+    return std::exchange(g.error_, nullptr);
+  }
+
+  static void Fail_(group &g) {
+    std::lock_guard<std::mutex> lock(g.error_mutex_);
+    if (!g.error_) {
+      g.error_ = std::current_exception();
+    }
+  }
+
+  // Runs one task: the caller's own newest if it is a worker, else one
+  // from the injection queue, else one stolen from a random worker.
+  bool RunOne_() {
+    Task_ *task = nullptr;
+    bool own = tls_pool_ == this;
+    if (!(own && workers_[tls_index_]->deque.pop(task)) &&
+        !injected_.try_pop(task) && !Steal_(own, task)) {
+      return false;
+    }
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    group &owner = *task->owner;
+    std::unique_ptr<Task_> holder(task);
+    try {
+      holder->fn();
+    } catch (...) {
+      Fail_(owner);
+    }
+    // The task goes before the count drops: once it reaches zero the
+    // waiter may return and destroy what the task captured by reference.
+    holder.reset();
+    owner.pending_.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+  }
+
+  // One pass over the workers from a random start.
+  bool Steal_(bool own, Task_ *&task) {
+    size_type n = size();
+    size_type start;
+    if (own) {
+      std::uint64_t &x = workers_[tls_index_]->rng;
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+      start = static_cast<size_type>(x % n);
+    } else {
+      start = next_victim_.fetch_add(1, std::memory_order_relaxed) % n;
+    }
+    for (size_type k = 0; k < n; ++k) {
+      size_type victim = (start + k) % n;
+      if (own && victim == tls_index_) {
+        continue;
+      }
+      if (workers_[victim]->deque.steal(task)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void WorkerLoop_(size_type index) {
+    tls_pool_ = this;
+    tls_index_ = index;
+    while (true) {
+      if (RunOne_()) {
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      // Registering as a sleeper before reading queued_ pairs with spawn(),
+      // which bumps queued_ before reading sleepers_: one of them sees the
+      // other, so a spawn cannot slip by unnoticed.
+      sleepers_.fetch_add(1, std::memory_order_seq_cst);
+      wake_.wait(lock, [this] {
+        return stop_ || queued_.load(std::memory_order_seq_cst) != 0;
+      });
+      sleepers_.fetch_sub(1, std::memory_order_relaxed);
+      if (stop_ && queued_.load(std::memory_order_relaxed) == 0) {
+        return;
+      }
+    }
+  }
+
+  inline static thread_local const task_pool *tls_pool_ = nullptr;
+  inline static thread_local size_type tls_index_ = 0;
+
+  s21::vector<std::unique_ptr<Worker_>> workers_;
+  s21::vector<std::thread> threads_;
+  concurrent_queue<Task_ *> injected_;
+  group root_;
+  std::atomic<size_type> queued_{0};
+  std::atomic<size_type> sleepers_{0};
+  std::atomic<size_type> next_victim_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stop_ = false;
+};
+
+// Pool shared by code that does not own one, the s21::parallel algorithms
+// included, so that independent parallel operations share one set of
+// workers; one worker per hardware thread.
+inline task_pool &default_task_pool() {
+  static task_pool pool;
+  return pool;
+}
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_TASK_POOL_H_
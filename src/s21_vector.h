@@ -3,14 +3,35 @@
 #define CPP2_S21_CONTAINERS_SRC_S21_VECTOR_H_
 
 #include <algorithm>
+#include <cstring>
 #include <initializer_list>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_memory.h"
 
 namespace s21 {
-template <class T>
+// Constrains iterator-range overloads, so that calls such as
+// insert(pos, 3, 7) do not resolve to them.
+template <class It>
+using RequireInputIterator = std::enable_if_t<std::is_convertible_v<
+    typename std::iterator_traits<It>::iterator_category,
+    std::input_iterator_tag>>;
+
+template <class T, class Allocator = std::allocator<T>,
+          class GrowthPolicy = growth::doubling>
 class vector {
+  using AllocTraits_ = std::allocator_traits<Allocator>;
+
  public:
   using value_type = T;
+  using allocator_type = Allocator;
+  using growth_policy = GrowthPolicy;
   using reference = T &;
   using const_reference = const T &;
   using iterator = T *;
@@ -18,29 +39,55 @@ class vector {
   using const_iterator = const T *;
   using size_type = std::size_t;
 
-  vector() : size_(0), capacity_(0), array_(nullptr) {}
-
-  explicit vector(size_type n)
-      : size_(n), capacity_(n), array_(new value_type[n]) {
-    std::fill(array_, array_ + n, T());
+  static_assert(std::is_same_v<typename AllocTraits_::value_type, T>,
+                "Allocator::value_type must be T");
+  static_assert(std::is_same_v<typename AllocTraits_::pointer, T *>,
+                "fancy allocator pointers are not supported");
+
+  vector() noexcept(noexcept(Allocator()))
+      : size_(0), capacity_(0), array_(nullptr), alloc_() {}
+
+  explicit vector(const Allocator &alloc) noexcept
+      : size_(0), capacity_(0), array_(nullptr), alloc_(alloc) {}
+
+  explicit vector(size_type n, const Allocator &alloc = Allocator())
+      : size_(0), capacity_(0), array_(nullptr), alloc_(alloc) {
+    array_ = Allocate_(n);
+    capacity_ = n;
+    try {
+      UninitializedFill_(array_, n);
+    } catch (...) {
+      Deallocate_(array_, capacity_);
+      throw;
+    }
+    size_ = n;
   }
 
-  explicit vector(std::initializer_list<value_type> const &items)
-      : size_(items.size()),
-        capacity_(items.size()),
-        array_(new value_type[items.size()]) {
-    std::copy(items.begin(), items.end(), array_);
+  explicit vector(std::initializer_list<value_type> const &items,
+                  const Allocator &alloc = Allocator())
+      : size_(0), capacity_(0), array_(nullptr), alloc_(alloc) {
+    InitCopy_(items.begin(), items.end(), items.size());
   }
 
   vector(const vector &other)
-      : size_(other.size_),
-        capacity_(other.capacity_),
-        array_(new value_type[capacity_]) {
-    std::copy(other.array_, other.array_ + other.size_, array_);
+      : size_(0),
+        capacity_(0),
+        array_(nullptr),
+        alloc_(AllocTraits_::select_on_container_copy_construction(
+            other.alloc_)) {
+    InitCopy_(other.array_, other.array_ + other.size_, other.capacity_);
+  }
+
+  vector(const vector &other, const Allocator &alloc)
+      : size_(0), capacity_(0), array_(nullptr), alloc_(alloc) {
+    InitCopy_(other.array_, other.array_ + other.size_, other.capacity_);
   }
 
   vector(vector &&other) noexcept
-      : size_(other.size_), capacity_(other.capacity_), array_(other.array_) {
+      : size_(other.size_),
+        capacity_(other.capacity_),
+        array_(other.array_),
+        alloc_(std::move(other.alloc_)) {
     other.size_ = 0;
     other.capacity_ = 0;
     other.array_ = nullptr;
@@ -50,19 +97,54 @@ class vector {
     if (this == &other) {
       return *this;
     }
-    delete[] array_;
-
+    if constexpr (AllocTraits_::propagate_on_container_copy_assignment::
+                      value) {
+      if (alloc_ != other.alloc_) {
+        Release_();
+        size_ = 0;
+        capacity_ = 0;
+        array_ = nullptr;
+      }
+      alloc_ = other.alloc_;
+    }
+    clear();
+    if (capacity_ < other.size_) {
+      Deallocate_(array_, capacity_);
+      array_ = nullptr;
+      capacity_ = 0;
+      array_ = Allocate_(other.capacity_);
+      capacity_ = other.capacity_;
+    }
+    UninitializedCopy_(other.array_, other.array_ + other.size_, array_);
     size_ = other.size_;
-    capacity_ = other.capacity_;
-    array_ = new value_type[capacity_];
-
-    std::copy(other.array_, other.array_ + other.size_, array_);
-
     return *this;
   }
 
-  vector &operator=(vector &&other) noexcept {
-    delete[] array_;
+  vector &operator=(vector &&other) noexcept(
+      AllocTraits_::propagate_on_container_move_assignment::value ||
+      AllocTraits_::is_always_equal::value) {
+    if (this == &other) {
+      return *this;
+    }
+    if constexpr (!AllocTraits_::propagate_on_container_move_assignment::
+                      value &&
+                  !AllocTraits_::is_always_equal::value) {
+      if (alloc_ != other.alloc_) {
+        // Storage from other's allocator cannot be adopted here, so the
+        // elements are moved one by one into our own buffer.
+        clear();
+        reserve(other.size_);
+        UninitializedMove_(other.array_, other.array_ + other.size_, array_);
+        size_ = other.size_;
+        other.clear();
+        return *this;
+      }
+    }
+    Release_();
+    if constexpr (AllocTraits_::propagate_on_container_move_assignment::
+                      value) {
+      alloc_ = std::move(other.alloc_);
+    }
     size_ = other.size_;
     capacity_ = other.capacity_;
     array_ = other.array_;
@@ -73,7 +155,9 @@ class vector {
     return *this;
   }
 
-  ~vector() { delete[] array_; }
+  ~vector() { Release_(); }
+
+  allocator_type get_allocator() const noexcept { return alloc_; }
 
   reference at(size_type pos) {
     if (pos >= size_ || size_ == 0) {
@@ -82,10 +166,20 @@ class vector {
     return *(array_ + pos);
   }
 
+  const_reference at(size_type pos) const {
+    return const_cast<vector *>(this)->at(pos);
+  }
+
   reference operator[](size_type pos) { return *(array_ + pos); }
 
+  const_reference operator[](size_type pos) const { return *(array_ + pos); }
+
+  reference front() { return *array_; }
+
   const_reference front() const { return *array_; }
 
+  reference back() { return *(array_ + size_ - 1); }
+
   const_reference back() const { return *(array_ + size_ - 1); }
 
   iterator data() noexcept { return array_; }
@@ -109,64 +203,231 @@ class vector {
   size_type size() const noexcept { return size_; }
 
   size_type max_size() const noexcept {
-    return std::numeric_limits<size_type>::max() / sizeof(value_type) / 2;
+    return std::min<size_type>(
+        AllocTraits_::max_size(alloc_),
+        std::numeric_limits<size_type>::max() / sizeof(value_type) / 2);
   }
 
   void reserve(size_type size) {
-    T *new_array = new value_type[size];
-    std::move(array_, array_ + size_, new_array);
-    delete[] array_;
-    array_ = new_array;
-    capacity_ = size;
+    if (size <= capacity_) {
+      return;
+    }
+    if (size > max_size()) {
+      throw std::length_error("Vector capacity exceeds max_size");
+    }
+    Reallocate_(size);
   }
 
-  void push_back(const_reference value) {
+  void push_back(const_reference value) { emplace_back(value); }
+
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    if constexpr (kCanReallocate_) {
+      if (size_ >= capacity_) {
+        // realloc frees the old block, so args must not point into it.
+        value_type tmp(std::forward<Args>(args)...);
+        Reallocate_(GrowCapacity_(size_ + 1));
+        Construct_(array_ + size_, std::move(tmp));
+        ++size_;
+        return array_[size_ - 1];
+      }
+    }
     if (size_ >= capacity_) {
-      reserve(capacity_ == 0 ? 1 : capacity_ * 2);
+      return *InsertWith_(size_, 1, [&](pointer dest) {
+        Construct_(dest, std::forward<Args>(args)...);
+      });
     }
-    array_[size_] = value;
+    Construct_(array_ + size_, std::forward<Args>(args)...);
     ++size_;
+    return array_[size_ - 1];
   }
 
-  void pop_back() { --size_; }
+  void pop_back() {
+    --size_;
+    AllocTraits_::destroy(alloc_, array_ + size_);
+  }
+
+  size_type capacity() const noexcept { return capacity_; }
+
+  const growth_stats &stats() const noexcept { return stats_; }
 
-  size_type capacity() { return capacity_; }
+  void resize(size_type count) { ResizeWith_(count); }
+
+  void resize(size_type count, const_reference value) {
+    ResizeWith_(count, value);
+  }
 
   void shrink_to_fit() {
     if (size_ < capacity_) {
-      T *new_array = new value_type[size_];
-      std::move(array_, array_ + size_, new_array);
-      delete[] array_;
-      array_ = new_array;
-      capacity_ = size_;
+      Reallocate_(size_);
+    }
+  }
+
+  void clear() noexcept {
+    Destroy_(array_, array_ + size_);
+    size_ = 0;
+  }
+
+  // Replaces the contents with count copies of value, allocating at most
+  // once and only when count exceeds the capacity.
+  void assign(size_type count, const_reference value) {
+    if (count > capacity_) {
+      pointer new_array = AllocateExact_(count);
+      try {
+        UninitializedFill_(new_array, count, value);
+      } catch (...) {
+        Deallocate_(new_array, count);
+        throw;
+      }
+      Adopt_(new_array, count, count);
+      return;
+    }
+    size_type common = std::min(count, size_);
+    std::fill_n(array_, common, value);
+    if (count > size_) {
+      UninitializedFill_(array_ + size_, count - size_, value);
+    } else {
+      Destroy_(array_ + count, array_ + size_);
+    }
+    size_ = count;
+  }
+
+  // Replaces the contents with [first, last), which must not point into
+  // this vector. Forward ranges are measured first, so storage is
+  // allocated at most once.
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  void assign(InputIt first, InputIt last) {
+    if constexpr (kIsForward_<InputIt>) {
+      size_type count = std::distance(first, last);
+      if (count > capacity_) {
+        pointer new_array = AllocateExact_(count);
+        try {
+          UninitializedCopy_(first, last, new_array);
+        } catch (...) {
+          Deallocate_(new_array, count);
+          throw;
+        }
+        Adopt_(new_array, count, count);
+        return;
+      }
+      InputIt mid = first;
+      std::advance(mid, std::min(count, size_));
+      std::copy(first, mid, array_);
+      if (count > size_) {
+        UninitializedCopy_(mid, last, array_ + size_);
+      } else {
+        Destroy_(array_ + count, array_ + size_);
+      }
+      size_ = count;
+    } else {
+      clear();
+      for (; first != last; ++first) {
+        emplace_back(*first);
+      }
     }
   }
 
-  void clear() noexcept { size_ = 0; }
+  void assign(std::initializer_list<value_type> items) {
+    assign(items.begin(), items.end());
+  }
 
   iterator insert(iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+
+  iterator insert(iterator pos, value_type &&value) {
+    return emplace(pos, std::move(value));
+  }
+
+  iterator insert(const_iterator pos, size_type count,
+                  const_reference value) {
     size_type index = pos - array_;
-    if (size_ >= capacity_) {
-      reserve(capacity_ == 0 ? 1 : capacity_ * 2);
+    if (count == 0) {
+      return array_ + index;
+    }
+    if (index == size_ || size_ + count > capacity_) {
+      return InsertWith_(index, count, [&](pointer dest) {
+        UninitializedFill_(dest, count, value);
+      });
     }
+    // value may alias an element that the shift below moves from.
+    value_type tmp(value);
+    return InsertWith_(index, count, [&](pointer dest) {
+      UninitializedFill_(dest, count, tmp);
+    });
+  }
 
-    for (size_type i = size_; i > index; --i) {
-      array_[i] = std::move(array_[i - 1]);
+  // Inserts [first, last), which must not point into this vector. A forward
+  // range is measured first, so there is at most one reallocation and the
+  // tail is shifted once. A single-pass range is appended and rotated into
+  // place instead.
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    size_type index = pos - array_;
+    if constexpr (kIsForward_<InputIt>) {
+      size_type count = std::distance(first, last);
+      if (count == 0) {
+        return array_ + index;
+      }
+      return InsertWith_(index, count, [&](pointer dest) {
+        UninitializedCopy_(first, last, dest);
+      });
+    } else {
+      size_type old_size = size_;
+      for (; first != last; ++first) {
+        emplace_back(*first);
+      }
+      std::rotate(array_ + index, array_ + old_size, array_ + size_);
+      return array_ + index;
     }
-    array_[index] = value;
-    ++size_;
-    return pos;
   }
 
-  void erase(iterator pos) {
-    size_type del = pos - begin();
-    for (; del < size_ - 1; ++del) {
-      array_[del] = std::move(array_[del + 1]);
+  iterator insert(const_iterator pos, std::initializer_list<value_type> items) {
+    return insert(pos, items.begin(), items.end());
+  }
+
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    size_type index = pos - array_;
+    if (index == size_ || size_ >= capacity_) {
+      return InsertWith_(index, 1, [&](pointer dest) {
+        Construct_(dest, std::forward<Args>(args)...);
+      });
     }
-    --size_;
+    // args may alias an element that the shift below moves from.
+    value_type tmp(std::forward<Args>(args)...);
+    return InsertWith_(index, 1, [this, &tmp](pointer dest) {
+      Construct_(dest, std::move(tmp));
+    });
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  // Removes [first, last) and shifts the tail left once.
+  iterator erase(const_iterator first, const_iterator last) {
+    pointer dest = array_ + (first - array_);
+    pointer src = array_ + (last - array_);
+    if (dest == src) {
+      return dest;
+    }
+    if constexpr (kRelocatable_) {
+      Destroy_(dest, src);
+      MoveBytes_(dest, src, array_ + size_ - src);
+    } else {
+      pointer new_end = std::move(src, array_ + size_, dest);
+      Destroy_(new_end, array_ + size_);
+    }
+    size_ -= src - dest;
+    return dest;
   }
 
-  void swap(vector &other) {
+  void swap(vector &other) noexcept {
+    if constexpr (AllocTraits_::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
+    std::swap(stats_, other.stats_);
     std::swap(array_, other.array_);
     std::swap(size_, other.size_);
     std::swap(capacity_, other.capacity_);
@@ -176,27 +437,303 @@ class vector {
   iterator insert_many(const_iterator pos, Args &&...args) {
     size_type num_elems = sizeof...(Args);
     size_type insert_pos = pos - array_;
-    if (size_ + num_elems >= capacity_) {
-      reserve(size_ + num_elems);
+    return InsertWith_(insert_pos, num_elems, [&](pointer dest) {
+      pointer cur = dest;
+      try {
+        ((Construct_(cur, std::forward<Args>(args)), ++cur), ...);
+      } catch (...) {
+        Destroy_(dest, cur);
+        throw;
+      }
+    });
+  }
+
+  template <typename... Args>
+  void insert_many_back(Args &&...args) {
+    insert_many(end(), std::forward<Args>(args)...);
+  }
+
+ private:
+  static constexpr bool kRelocatable_ =
+      is_trivially_relocatable_v<value_type>;
+  static constexpr bool kCanReallocate_ =
+      kRelocatable_ && allocator_has_reallocate<Allocator>::value;
+
+  template <typename InputIt>
+  static constexpr bool kIsForward_ = std::is_convertible_v<
+      typename std::iterator_traits<InputIt>::iterator_category,
+      std::forward_iterator_tag>;
+
+  static void CopyBytes_(pointer dest, const value_type *src,
+                         size_type n) noexcept {
+    if (n != 0) {
+      std::memcpy(static_cast<void *>(dest), static_cast<const void *>(src),
+                  n * sizeof(value_type));
+    }
+  }
+
+  static void MoveBytes_(pointer dest, const value_type *src,
+                         size_type n) noexcept {
+    if (n != 0) {
+      std::memmove(static_cast<void *>(dest), static_cast<const void *>(src),
+                   n * sizeof(value_type));
     }
-    for (size_type i = size_ - 1; i >= insert_pos; --i) {
-      array_[i + num_elems] = std::move(array_[i]);
+  }
+
+  pointer Allocate_(size_type n) {
+    if (n == 0) {
+      return nullptr;
     }
-    ((array_[insert_pos++] = std::forward<Args>(args)), ...);
-    size_ += num_elems;
+    return AllocTraits_::allocate(alloc_, n);
+  }
 
-    return array_ + insert_pos;
+  void Deallocate_(pointer p, size_type n) noexcept {
+    if (p != nullptr) {
+      AllocTraits_::deallocate(alloc_, p, n);
+    }
   }
 
   template <typename... Args>
-  void insert_many_back(Args &&...args) {
-    insert_many(end(), args...);
+  void Construct_(pointer p, Args &&...args) {
+    AllocTraits_::construct(alloc_, p, std::forward<Args>(args)...);
+  }
+
+  void Destroy_(pointer first, pointer last) noexcept {
+    for (; first != last; ++first) {
+      AllocTraits_::destroy(alloc_, first);
+    }
+  }
+
+  void Release_() noexcept {
+    Destroy_(array_, array_ + size_);
+    Deallocate_(array_, capacity_);
+  }
+
+  pointer AllocateExact_(size_type n) {
+    if (n > max_size()) {
+      throw std::length_error("Vector capacity exceeds max_size");
+    }
+    ++stats_.reallocations;
+    return Allocate_(n);
+  }
+
+  // Replaces the current buffer with new_array, which already holds size
+  // constructed elements.
+  void Adopt_(pointer new_array, size_type size, size_type capacity) noexcept {
+    Release_();
+    array_ = new_array;
+    size_ = size;
+    capacity_ = capacity;
+  }
+
+  // Constructs count elements from args in raw storage at dest; on failure
+  // destroys what was built and rethrows.
+  template <typename... Args>
+  void UninitializedFill_(pointer dest, size_type count, const Args &...args) {
+    pointer cur = dest;
+    try {
+      for (; count != 0; --count, ++cur) {
+        Construct_(cur, args...);
+      }
+    } catch (...) {
+      Destroy_(dest, cur);
+      throw;
+    }
+  }
+
+  template <typename... Args>
+  void ResizeWith_(size_type count, const Args &...args) {
+    if (count <= size_) {
+      Destroy_(array_ + count, array_ + size_);
+      size_ = count;
+      return;
+    }
+    size_type extra = count - size_;
+    InsertWith_(size_, extra, [&](pointer dest) {
+      UninitializedFill_(dest, extra, args...);
+    });
+  }
+
+  template <typename InputIt>
+  void InitCopy_(InputIt first, InputIt last, size_type capacity) {
+    array_ = Allocate_(capacity);
+    capacity_ = capacity;
+    try {
+      UninitializedCopy_(first, last, array_);
+    } catch (...) {
+      Deallocate_(array_, capacity_);
+      throw;
+    }
+    size_ = std::distance(first, last);
+  }
+
+  // Constructs copies of [first, last) in raw storage at dest through the
+  // allocator; on failure destroys what was built and rethrows.
+  template <typename InputIt>
+  pointer UninitializedCopy_(InputIt first, InputIt last, pointer dest) {
+    pointer cur = dest;
+    try {
+      for (; first != last; ++first, ++cur) {
+        Construct_(cur, *first);
+      }
+    } catch (...) {
+      Destroy_(dest, cur);
+      throw;
+    }
+    return cur;
+  }
+
+  pointer UninitializedMove_(pointer first, pointer last, pointer dest) {
+    return UninitializedCopy_(std::make_move_iterator(first),
+                              std::make_move_iterator(last), dest);
+  }
+
+  // Moves [first, last) into raw storage at dest, falling back to copies
+  // when T's move constructor may throw, like std::move_if_noexcept.
+  pointer Relocate_(pointer first, pointer last, pointer dest) {
+    if constexpr (std::is_nothrow_move_constructible_v<value_type> ||
+                  !std::is_copy_constructible_v<value_type>) {
+      return UninitializedMove_(first, last, dest);
+    } else {
+      return UninitializedCopy_(first, last, dest);
+    }
+  }
+
+  void Reallocate_(size_type new_capacity) {
+    ++stats_.reallocations;
+    if constexpr (kCanReallocate_) {
+      if (array_ != nullptr && new_capacity != 0) {
+        array_ = alloc_.reallocate(array_, capacity_, new_capacity);
+        capacity_ = new_capacity;
+        return;
+      }
+    }
+    stats_.bytes_moved += size_ * sizeof(value_type);
+    pointer new_array = Allocate_(new_capacity);
+    if constexpr (kRelocatable_) {
+      CopyBytes_(new_array, array_, size_);
+      Deallocate_(array_, capacity_);
+    } else {
+      try {
+        Relocate_(array_, array_ + size_, new_array);
+      } catch (...) {
+        Deallocate_(new_array, new_capacity);
+        throw;
+      }
+      Release_();
+    }
+    array_ = new_array;
+    capacity_ = new_capacity;
+  }
+
+  size_type GrowCapacity_(size_type required) const {
+    size_type grown =
+        GrowthPolicy::next(capacity_, required, sizeof(value_type));
+    return std::min(std::max(grown, required),
+                    std::max(max_size(), required));
+  }
+
+  // Makes room for count elements at index and lets construct(dest) build
+  // them in uninitialized storage. When the buffer has to grow, the new
+  // elements are built first, so construct may still read from the old one.
+  template <typename Construct>
+  iterator InsertWith_(size_type index, size_type count,
+                       Construct &&construct) {
+    if (size_ + count > capacity_) {
+      if (count > max_size() - size_) {
+        throw std::length_error("Vector capacity exceeds max_size");
+      }
+      size_type new_capacity = GrowCapacity_(size_ + count);
+      pointer new_array = Allocate_(new_capacity);
+      ++stats_.reallocations;
+      stats_.bytes_moved += size_ * sizeof(value_type);
+      size_type built = 0;
+      try {
+        construct(new_array + index);
+        built = count;
+        if constexpr (!kRelocatable_) {
+          Relocate_(array_, array_ + index, new_array);
+          built += index;
+          Relocate_(array_ + index, array_ + size_,
+                    new_array + index + count);
+        }
+      } catch (...) {
+        if (built != 0) {
+          Destroy_(new_array + index, new_array + index + count);
+        }
+        if (built > count) {
+          Destroy_(new_array, new_array + index);
+        }
+        Deallocate_(new_array, new_capacity);
+        throw;
+      }
+      if constexpr (kRelocatable_) {
+        CopyBytes_(new_array, array_, index);
+        CopyBytes_(new_array + index + count, array_ + index, size_ - index);
+        Deallocate_(array_, capacity_);
+      } else {
+        Release_();
+      }
+      array_ = new_array;
+      capacity_ = new_capacity;
+    } else if (index == size_) {
+      construct(array_ + size_);
+    } else {
+      OpenGap_(index, count);
+      try {
+        construct(array_ + index);
+      } catch (...) {
+        if constexpr (kRelocatable_) {
+          MoveBytes_(array_ + index, array_ + index + count, size_ - index);
+        } else {
+          // The tail past the gap cannot be closed back without more moves
+          // that may throw too, so it is dropped (basic guarantee).
+          Destroy_(array_ + index + count, array_ + size_ + count);
+          size_ = index;
+        }
+        throw;
+      }
+    }
+    size_ += count;
+    return array_ + index;
+  }
+
+  // Shifts [index, size_) right by count and destroys whatever is left in
+  // [index, index + count), leaving that range as raw storage.
+  void OpenGap_(size_type index, size_type count) {
+    if constexpr (kRelocatable_) {
+      MoveBytes_(array_ + index + count, array_ + index, size_ - index);
+      return;
+    }
+    pointer old_end = array_ + size_;
+    pointer src = array_ + index;
+    size_type tail = size_ - index;
+    if (count < tail) {
+      UninitializedMove_(old_end - count, old_end, old_end);
+      std::move_backward(src, old_end - count, old_end);
+      Destroy_(src, src + count);
+    } else {
+      UninitializedMove_(src, old_end, src + count);
+      Destroy_(src, old_end);
+    }
   }
 
- private:
   size_type size_;
   size_type capacity_;
   pointer array_;
+  allocator_type alloc_;
+  growth_stats stats_;
 };
+
+// Vector whose data() is always Align-byte aligned, so SIMD loads over it
+// never split a cache line.
+template <class T, std::size_t Align = 64,
+          class GrowthPolicy = growth::doubling>
+using aligned_vector = vector<T, aligned_allocator<T, Align>, GrowthPolicy>;
+
+namespace pmr {
+template <class T>
+using vector = s21::vector<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
 }  // namespace s21
-#endif  // CPP2_S21_CONTAINERS_SRC_S21_VECTOR_H_
\ No newline at end of file
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_VECTOR_H_
@@ -0,0 +1,156 @@
+// Copyright 2023 School21 @tandraym
+#ifndef CPP2_S21_CONTAINERS_SRC_S21_WS_DEQUE_H_
+#define CPP2_S21_CONTAINERS_SRC_S21_WS_DEQUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "s21_memory.h"
+#include "s21_vector.h"
+
+namespace s21 {
+// Chase-Lev work-stealing deque, in the C11 formulation of Le, Pop, Cohen
+// and Zappa Nardelli. One owner thread pushes and pops at the bottom, LIFO,
+// without a CAS except when taking the last element; any other thread may
+// steal from the top, FIFO, with one CAS. The owner keeps recently pushed,
+// cache-warm work, and thieves take the oldest, which in fork-join code is
+// usually the largest piece.
+//
+// Elements live in a circular array of std::atomic<T>, since a thief reads
+// its slot before it knows whether its CAS wins; T must therefore be
+// trivially copyable, typically a pointer. The array doubles when full.
+// Thieves may still be reading the old one, so replaced arrays are kept
+// until the deque is destroyed; they add up to less than the current one.
+template <class T>
+class ws_deque {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "ws_deque elements must be trivially copyable");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  // Capacity is rounded up to a power of two, at least 2.
+  explicit ws_deque(size_type capacity = 64) {
+    size_type size = 2;
+    while (size < capacity) {
+      size *= 2;
+    }
+    arrays_.push_back(std::make_unique<Array_>(size));
+    array_.store(arrays_.back().get(), std::memory_order_relaxed);
+  }
+
+  ws_deque(const ws_deque &) = delete;
+  ws_deque &operator=(const ws_deque &) = delete;
+
+  // Owner only.
+  void push(T value) {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    Array_ *array = array_.load(std::memory_order_relaxed);
+    if (bottom - top >= array->size) {
+      array = Grow_(array, top, bottom);
+    }
+    array->Put(bottom, value);
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  // Owner only: takes the most recently pushed element. Returns false when
+  // the deque is empty or a thief took the last element first.
+  bool pop(T &out) {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array_ *array = array_.load(std::memory_order_relaxed);
+    // Claims the bottom slot before reading top; seq_cst pairs this store
+    // with the thieves' loads, as the fences of the original do.
+    bottom_.store(bottom, std::memory_order_seq_cst);
+    std::int64_t top = top_.load(std::memory_order_seq_cst);
+    if (top > bottom) {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+    out = array->Get(bottom);
+    if (top == bottom) {
+      // Last element: race the thieves for it through top.
+      bool won = top_.compare_exchange_strong(top, top + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed);
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  // Any thread: takes the oldest element. Returns false when the deque is
+  // empty or another thread won the race for that element; the caller may
+  // simply try again or elsewhere.
+  bool steal(T &out) {
+    std::int64_t top = top_.load(std::memory_order_seq_cst);
+    std::int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+    if (top >= bottom) {
+      return false;
+    }
+    Array_ *array = array_.load(std::memory_order_acquire);
+    T value = array->Get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return false;
+    }
+    out = value;
+    return true;
+  }
+
+  // A snapshot; exact only while no other thread is using the deque.
+  size_type size() const noexcept {
+    std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  size_type capacity() const noexcept {
+    return static_cast<size_type>(
+        array_.load(std::memory_order_acquire)->size);
+  }
+
+ private:
+  struct Array_ {
+    explicit Array_(size_type n)
+        : size(static_cast<std::int64_t>(n)),
+          slots(std::make_unique<std::atomic<T>[]>(n)) {}
+
+    T Get(std::int64_t i) const noexcept {
+      return slots[i & (size - 1)].load(std::memory_order_relaxed);
+    }
+
+    void Put(std::int64_t i, T value) noexcept {
+      slots[i & (size - 1)].store(value, std::memory_order_relaxed);
+    }
+
+    std::int64_t size;
+    std::unique_ptr<std::atomic<T>[]> slots;
+  };
+
+  Array_ *Grow_(Array_ *old, std::int64_t top, std::int64_t bottom) {
+    arrays_.push_back(
+        std::make_unique<Array_>(static_cast<size_type>(old->size) * 2));
+    Array_ *array = arrays_.back().get();
+    for (std::int64_t i = top; i < bottom; ++i) {
+      array->Put(i, old->Get(i));
+    }
+    array_.store(array, std::memory_order_release);
+    return array;
+  }
+
+  alignas(cache_line_size) std::atomic<std::int64_t> top_{0};
+  alignas(cache_line_size) std::atomic<std::int64_t> bottom_{0};
+  alignas(cache_line_size) std::atomic<Array_ *> array_{nullptr};
+  // Every array ever used, newest last; touched by the owner only.
+  s21::vector<std::unique_ptr<Array_>> arrays_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_SRC_S21_WS_DEQUE_H_
@@ -1,9 +1,25 @@
 #include <gtest/gtest.h>
+#include <sys/stat.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <limits>
 #include <list>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <optional>
 #include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
 #include <vector>
 
 #include "../s21_containers.h"
@@ -393,6 +409,408 @@ TEST(vector_insert_many_back, TEST_32) {
   EXPECT_EQ(vector_string[3], "!");
 }
 
+struct NoDefault {
+  explicit NoDefault(int v) : value(v) { ++alive; }
+  NoDefault(const NoDefault &other) : value(other.value) { ++alive; }
+  NoDefault(NoDefault &&other) noexcept : value(other.value) { ++alive; }
+  NoDefault &operator=(const NoDefault &) = default;
+  NoDefault &operator=(NoDefault &&) noexcept = default;
+  ~NoDefault() { --alive; }
+
+  int value;
+  static int alive;
+};
+int NoDefault::alive = 0;
+
+TEST(vector, RawStorageNoDefaultConstructor) {
+  {
+    s21::vector<NoDefault> v;
+    v.reserve(16);
+    EXPECT_EQ(NoDefault::alive, 0);
+    for (int i = 0; i < 40; ++i) {
+      v.push_back(NoDefault(i));
+    }
+    EXPECT_EQ(NoDefault::alive, 40);
+    v.insert(v.begin(), NoDefault(-1));
+    v.erase(v.begin() + 10);
+    v.pop_back();
+    EXPECT_EQ(NoDefault::alive, 39);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 39U);
+    EXPECT_EQ(v[0].value, -1);
+    EXPECT_EQ(v[10].value, 10);
+    EXPECT_EQ(v.back().value, 38);
+    v.clear();
+    EXPECT_EQ(NoDefault::alive, 0);
+    v.push_back(NoDefault(7));
+  }
+  EXPECT_EQ(NoDefault::alive, 0);
+}
+
+TEST(vector, MoveOnlyGrowth) {
+  s21::vector<std::unique_ptr<int>> v;
+  for (int i = 0; i < 10; ++i) {
+    v.insert_many(v.begin(), std::make_unique<int>(i));
+  }
+  v.reserve(100);
+  v.shrink_to_fit();
+  EXPECT_EQ(v.size(), 10U);
+  EXPECT_EQ(v.capacity(), 10U);
+  EXPECT_EQ(*v[0], 9);
+  EXPECT_EQ(*v[9], 0);
+}
+
+TEST(vector, InsertFrontAndAliasing) {
+  s21::vector<std::string> v{"b", "c"};
+  v.reserve(8);
+  v.insert(v.begin(), v[1]);
+  v.insert_many(v.begin(), "a");
+  ASSERT_EQ(v.size(), 4U);
+  EXPECT_EQ(v[0], "a");
+  EXPECT_EQ(v[1], "c");
+  EXPECT_EQ(v[2], "b");
+  EXPECT_EQ(v[3], "c");
+  auto it = v.insert(v.end(), v[0]);
+  EXPECT_EQ(*it, "a");
+  EXPECT_EQ(v.size(), 5U);
+}
+
+struct CopyCounter {
+  CopyCounter(int v, std::string s) : value(v), text(std::move(s)) {}
+  CopyCounter(const CopyCounter &other) : value(other.value), text(other.text) {
+    ++copies;
+  }
+  CopyCounter(CopyCounter &&other) noexcept = default;
+  CopyCounter &operator=(const CopyCounter &other) {
+    value = other.value;
+    text = other.text;
+    ++copies;
+    return *this;
+  }
+  CopyCounter &operator=(CopyCounter &&other) noexcept = default;
+  bool operator<(const CopyCounter &other) const { return value < other.value; }
+
+  int value;
+  std::string text;
+  static int copies;
+};
+int CopyCounter::copies = 0;
+
+TEST(vector, EmplaceWithoutCopies) {
+  CopyCounter::copies = 0;
+  s21::vector<CopyCounter> v;
+  for (int i = 0; i < 20; ++i) {
+    v.emplace_back(i, "row");
+  }
+  v.push_back(CopyCounter(20, "moved"));
+  auto it = v.emplace(v.begin() + 3, -3, "middle");
+  EXPECT_EQ(it->value, -3);
+  v.insert(v.begin(), CopyCounter(-1, "front"));
+  v.insert_many_back(CopyCounter(21, "a"), CopyCounter(22, "b"));
+  EXPECT_EQ(CopyCounter::copies, 0);
+  EXPECT_EQ(v[0].value, -1);
+  EXPECT_EQ(v[4].value, -3);
+  EXPECT_EQ(v.back().text, "b");
+  EXPECT_EQ(v.size(), 25U);
+  CopyCounter &ref = v.emplace_back(23, "ref");
+  EXPECT_EQ(&ref, &v[25]);
+}
+
+TEST(vector, EmplaceAliasingElement) {
+  s21::vector<std::string> v{"a", "b", "c"};
+  v.reserve(10);
+  v.emplace(v.begin(), v[2]);
+  v.emplace_back(v[0]);
+  EXPECT_EQ(v[0], "c");
+  EXPECT_EQ(v[3], "c");
+  EXPECT_EQ(v[4], "c");
+}
+
+struct OwnedValue {
+  std::unique_ptr<int> owner;
+};
+
+template <>
+struct s21::is_trivially_relocatable<OwnedValue> : std::true_type {};
+
+TEST(vector, TriviallyRelocatableShifts) {
+  s21::vector<OwnedValue> v;
+  for (int i = 0; i < 10; ++i) {
+    v.push_back(OwnedValue{std::make_unique<int>(i)});
+  }
+  v.insert(v.begin() + 5, OwnedValue{std::make_unique<int>(50)});
+  v.insert_many(v.begin(), OwnedValue{std::make_unique<int>(-2)},
+                OwnedValue{std::make_unique<int>(-1)});
+  v.erase(v.begin() + 2);
+  v.shrink_to_fit();
+  int expected[] = {-2, -1, 1, 2, 3, 4, 50, 5, 6, 7, 8, 9};
+  ASSERT_EQ(v.size(), 12U);
+  for (int i = 0; i < 12; ++i) {
+    EXPECT_EQ(*v[i].owner, expected[i]);
+  }
+}
+
+TEST(vector, MallocAllocatorReallocGrowth) {
+  s21::vector<int, s21::malloc_allocator<int>> v;
+  for (int i = 0; i < 1000; ++i) {
+    v.push_back(i);
+  }
+  v.emplace_back(v[0]);
+  v.insert(v.begin() + 1, -1);
+  v.erase(v.begin());
+  EXPECT_EQ(v.size(), 1001U);
+  EXPECT_EQ(v[0], -1);
+  EXPECT_EQ(v[999], 999);
+  EXPECT_EQ(v.back(), 0);
+  v.clear();
+  v.shrink_to_fit();
+  EXPECT_EQ(v.capacity(), 0U);
+  EXPECT_TRUE((s21::is_trivially_relocatable_v<int>));
+  EXPECT_FALSE((s21::is_trivially_relocatable_v<std::string>));
+}
+
+TEST(vector, RangeInsertSingleReallocation) {
+  s21::vector<int> v{1, 2, 3};
+  std::vector<int> src{10, 11, 12, 13, 14};
+  auto it = v.insert(v.begin() + 1, src.begin(), src.end());
+  EXPECT_EQ(it, v.begin() + 1);
+  EXPECT_EQ(v.stats().reallocations, 1U);
+  std::vector<int> expected{1, 10, 11, 12, 13, 14, 2, 3};
+  ASSERT_EQ(v.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(v[i], expected[i]);
+  }
+  std::list<int> list_src{7, 8};
+  v.reserve(20);
+  v.insert(v.end(), list_src.begin(), list_src.end());
+  v.insert(v.begin(), {-2, -1});
+  v.insert(v.begin() + 3, 2, v[0]);
+  EXPECT_EQ(v.size(), 14U);
+  EXPECT_EQ(v[0], -2);
+  EXPECT_EQ(v[3], -2);
+  EXPECT_EQ(v[4], -2);
+  EXPECT_EQ(v[5], 10);
+  EXPECT_EQ(v.back(), 8);
+  EXPECT_EQ(v.stats().reallocations, 2U);
+}
+
+TEST(vector, RangeInsertInputIterator) {
+  s21::vector<std::string> v{"a", "d"};
+  std::istringstream in("b c");
+  v.insert(v.begin() + 1, std::istream_iterator<std::string>(in),
+           std::istream_iterator<std::string>());
+  ASSERT_EQ(v.size(), 4U);
+  EXPECT_EQ(v[0], "a");
+  EXPECT_EQ(v[1], "b");
+  EXPECT_EQ(v[2], "c");
+  EXPECT_EQ(v[3], "d");
+}
+
+TEST(vector, RangeEraseShiftsOnce) {
+  s21::vector<std::string> v{"0", "1", "2", "3", "4", "5"};
+  auto it = v.erase(v.begin() + 1, v.begin() + 4);
+  EXPECT_EQ(*it, "4");
+  ASSERT_EQ(v.size(), 3U);
+  EXPECT_EQ(v[0], "0");
+  EXPECT_EQ(v[2], "5");
+  it = v.erase(v.begin(), v.begin());
+  EXPECT_EQ(it, v.begin());
+  it = v.erase(v.begin() + 1, v.end());
+  EXPECT_EQ(it, v.end());
+  EXPECT_EQ(v.size(), 1U);
+
+  s21::vector<int> ints{1, 2, 3, 4, 5};
+  ints.erase(ints.begin() + 3, ints.end());
+  ints.erase(ints.begin());
+  ASSERT_EQ(ints.size(), 2U);
+  EXPECT_EQ(ints[0], 2);
+  EXPECT_EQ(ints[1], 3);
+}
+
+TEST(vector, AssignAndResize) {
+  s21::vector<std::string> v{"x", "y", "z"};
+  std::vector<std::string> src{"a", "b"};
+  v.assign(src.begin(), src.end());
+  ASSERT_EQ(v.size(), 2U);
+  EXPECT_EQ(v.capacity(), 3U);
+  EXPECT_EQ(v[1], "b");
+  v.assign(5, "q");
+  EXPECT_EQ(v.size(), 5U);
+  EXPECT_EQ(v.capacity(), 5U);
+  EXPECT_EQ(v[4], "q");
+  v.assign({"k"});
+  EXPECT_EQ(v.size(), 1U);
+  v.assign(3, v[0]);
+  EXPECT_EQ(v[2], "k");
+
+  v.resize(6);
+  EXPECT_EQ(v.size(), 6U);
+  EXPECT_EQ(v[5], "");
+  v.resize(2);
+  EXPECT_EQ(v.size(), 2U);
+  v.resize(4, "r");
+  EXPECT_EQ(v[3], "r");
+
+  s21::vector<int> grown;
+  for (int i = 1; i <= 64; ++i) {
+    grown.resize(i, i);
+  }
+  EXPECT_EQ(grown[63], 64);
+  EXPECT_EQ(grown.stats().reallocations, 7U);
+}
+
+TEST(vector, InsertManyGrowsGeometrically) {
+  s21::vector<int> v;
+  for (int i = 0; i < 64; ++i) {
+    v.insert_many_back(i, i);
+  }
+  EXPECT_EQ(v.size(), 128U);
+  EXPECT_EQ(v.stats().reallocations, 7U);
+  EXPECT_EQ(v[127], 63);
+}
+
+TEST(vector, GrowthPolicies) {
+  s21::vector<int> doubling;
+  s21::vector<int, std::allocator<int>, s21::growth::one_and_half> one_half;
+  s21::vector<int, std::allocator<int>, s21::growth::fixed_increment<10>>
+      fixed;
+  s21::vector<char, std::allocator<char>, s21::growth::page_rounded<64>>
+      paged;
+  for (int i = 0; i < 100; ++i) {
+    doubling.push_back(i);
+    one_half.push_back(i);
+    fixed.push_back(i);
+    paged.push_back(static_cast<char>(i));
+  }
+  EXPECT_EQ(doubling.capacity(), 128U);
+  EXPECT_EQ(doubling.stats().reallocations, 8U);
+  EXPECT_EQ(fixed.capacity(), 100U);
+  EXPECT_EQ(fixed.stats().reallocations, 10U);
+  EXPECT_EQ(paged.capacity(), 128U);
+  EXPECT_EQ(paged.stats().reallocations, 2U);
+  EXPECT_GE(one_half.capacity(), 100U);
+  EXPECT_LT(one_half.capacity(), 150U);
+  EXPECT_GT(one_half.stats().reallocations, 8U);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(one_half[i], i);
+    EXPECT_EQ(fixed[i], i);
+  }
+  EXPECT_EQ(s21::growth::doubling::next(0, 0, 4), 1U);
+  EXPECT_EQ(s21::growth::doubling::next(8, 20, 4), 20U);
+  EXPECT_EQ(s21::growth::page_rounded<4096>::next(1, 2, 24), 170U);
+}
+
+TEST(vector, GrowthStatsBytesMoved) {
+  s21::vector<int> v;
+  v.reserve(4);
+  v.insert_many_back(1, 2, 3, 4);
+  EXPECT_EQ(v.stats().reallocations, 1U);
+  EXPECT_EQ(v.stats().bytes_moved, 0U);
+  v.push_back(5);
+  EXPECT_EQ(v.stats().reallocations, 2U);
+  EXPECT_EQ(v.stats().bytes_moved, 4 * sizeof(int));
+
+  s21::vector<int, s21::malloc_allocator<int>> realloc_backed;
+  for (int i = 0; i < 1000; ++i) {
+    realloc_backed.push_back(i);
+  }
+  EXPECT_EQ(realloc_backed.stats().reallocations, 11U);
+  EXPECT_EQ(realloc_backed.stats().bytes_moved, 0U);
+}
+
+TEST(vector, MmapAllocatorGrowth) {
+  s21::vector<long, s21::mmap_allocator<long, 4096>> v;
+  for (long i = 0; i < 100000; ++i) {
+    v.push_back(i);
+  }
+  EXPECT_EQ(v.size(), 100000U);
+  for (long i = 0; i < 100000; i += 997) {
+    EXPECT_EQ(v[i], i);
+  }
+  EXPECT_EQ(v.stats().bytes_moved, 0U);
+  v.insert(v.begin(), -1L);
+  EXPECT_EQ(v.front(), -1L);
+  EXPECT_EQ(v.back(), 99999L);
+  v.erase(v.begin());
+  v.shrink_to_fit();
+  EXPECT_EQ(v.capacity(), 100000U);
+  EXPECT_EQ(v[500], 500L);
+  s21::vector<long, s21::mmap_allocator<long, 4096>> copy(v);
+  EXPECT_EQ(copy[99999], 99999L);
+  v.clear();
+  v.shrink_to_fit();
+  EXPECT_EQ(v.capacity(), 0U);
+}
+
+template <class T>
+struct CountingAllocator {
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::true_type;
+
+  explicit CountingAllocator(int *live) : live_(live) {}
+  template <class U>
+  CountingAllocator(const CountingAllocator<U> &other) : live_(other.live_) {}
+
+  T *allocate(std::size_t n) {
+    *live_ += static_cast<int>(n);
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T *p, std::size_t n) {
+    *live_ -= static_cast<int>(n);
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template <class U>
+  bool operator==(const CountingAllocator<U> &other) const {
+    return live_ == other.live_;
+  }
+  template <class U>
+  bool operator!=(const CountingAllocator<U> &other) const {
+    return live_ != other.live_;
+  }
+
+  int *live_;
+};
+
+TEST(vector, AllocatorCounting) {
+  int live = 0;
+  int other_live = 0;
+  {
+    using Alloc = CountingAllocator<std::string>;
+    s21::vector<std::string, Alloc> v{Alloc(&live)};
+    v.push_back("one");
+    v.push_back("two");
+    v.push_back("three");
+    EXPECT_EQ(live, 4);
+    s21::vector<std::string, Alloc> other{Alloc(&other_live)};
+    other = std::move(v);
+    EXPECT_EQ(other.size(), 3U);
+    EXPECT_EQ(other[2], "three");
+    EXPECT_EQ(other_live, 3);
+    EXPECT_EQ(other.get_allocator(), Alloc(&other_live));
+    other = v;
+    EXPECT_EQ(other.get_allocator(), Alloc(&live));
+    other.swap(v);
+    EXPECT_EQ(v.get_allocator(), Alloc(&live));
+  }
+  EXPECT_EQ(live, 0);
+  EXPECT_EQ(other_live, 0);
+}
+
+TEST(vector, PmrMonotonicBuffer) {
+  char buffer[1024];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  s21::pmr::vector<std::pmr::string> v(&arena);
+  v.push_back("a string that is too long for the small string buffer");
+  v.insert_many_back("x", "y");
+  EXPECT_EQ(v.size(), 3U);
+  EXPECT_EQ(v[0].get_allocator().resource(), &arena);
+  EXPECT_EQ(v.get_allocator().resource(), &arena);
+}
+
 TEST(array_def_constructor, TEST_33) {
   s21::array<int, 4> array_int;
   s21::array<std::string, 4> array_string;
@@ -1345,6 +1763,63 @@ TEST(list_splice, TEST_109) {
 //   EXPECT_EQ(s21_list_int_empty.empty(),true);
 // }
 
+TEST(list, AllocatorCounting) {
+  int live = 0;
+  {
+    using Alloc = CountingAllocator<NoDefault>;
+    s21::list<NoDefault, Alloc> l{Alloc(&live)};
+    EXPECT_EQ(live, 1);
+    l.push_back(NoDefault(1));
+    l.push_front(NoDefault(0));
+    l.insert(l.end(), NoDefault(2));
+    EXPECT_EQ(live, 4);
+    EXPECT_EQ(NoDefault::alive, 3);
+    l.pop_front();
+    EXPECT_EQ(live, 3);
+    EXPECT_EQ(l.front().value, 1);
+  }
+  EXPECT_EQ(live, 0);
+  EXPECT_EQ(NoDefault::alive, 0);
+}
+
+TEST(list, EmplaceWithoutCopies) {
+  CopyCounter::copies = 0;
+  s21::list<CopyCounter> l;
+  l.emplace_back(1, "one");
+  l.emplace_front(0, "zero");
+  l.push_back(CopyCounter(3, "three"));
+  l.push_front(CopyCounter(-1, "minus one"));
+  auto it = l.emplace(--l.end(), 2, "two");
+  l.insert(l.end(), CopyCounter(4, "four"));
+  l.insert_many_back(CopyCounter(5, "five"), CopyCounter(6, "six"));
+  l.insert_many_front(CopyCounter(-2, "minus two"));
+  EXPECT_EQ(CopyCounter::copies, 0);
+  EXPECT_EQ((*it).text, "two");
+  int expected = -2;
+  for (const CopyCounter &item : l) {
+    EXPECT_EQ(item.value, expected++);
+  }
+  EXPECT_EQ(l.size(), 9U);
+}
+
+TEST(list, InsertManyMoveOnly) {
+  s21::list<std::unique_ptr<int>> l;
+  l.insert_many_back(std::make_unique<int>(1), std::make_unique<int>(2));
+  auto it = l.insert_many(l.begin(), std::make_unique<int>(0));
+  EXPECT_EQ(**it, 0);
+  EXPECT_EQ(*l.back(), 2);
+  EXPECT_EQ(l.size(), 3U);
+}
+
+TEST(list, PmrMonotonicBuffer) {
+  std::pmr::monotonic_buffer_resource arena;
+  s21::pmr::list<std::pmr::string> l(&arena);
+  l.push_back("a string that is too long for the small string buffer");
+  l.insert_many_back("b", "c");
+  EXPECT_EQ(l.size(), 3U);
+  EXPECT_EQ(l.front().get_allocator().resource(), &arena);
+}
+
 TEST(stack_arg_constructor, TEST_113) {
   s21::stack<int> s21_stack_int{1, 2, 3, 4, 5};
   s21::stack<std::string> s21_stack_string{"1", "2", "3", "4", "5"};
@@ -1819,6 +2294,50 @@ TEST(set, Merge_set) {
   EXPECT_TRUE(set1.contains(7));
 }
 
+TEST(set, AllocatorCounting) {
+  int live = 0;
+  {
+    CountingAllocator<int> alloc(&live);
+    s21::set<int, std::less<int>, CountingAllocator<int>> s(alloc);
+    for (int i = 0; i < 10; ++i) {
+      s.insert(i);
+    }
+    EXPECT_EQ(live, 10);
+    s.erase(s.find(3));
+    s.erase(s.find(0));
+    EXPECT_EQ(live, 8);
+    EXPECT_EQ(s.size(), 8U);
+    EXPECT_EQ(*s.begin(), 1);
+    int expected[] = {1, 2, 4, 5, 6, 7, 8, 9};
+    int i = 0;
+    for (int value : s) {
+      EXPECT_EQ(value, expected[i++]);
+    }
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(set, EmplaceWithoutCopies) {
+  CopyCounter::copies = 0;
+  s21::set<CopyCounter> s;
+  EXPECT_TRUE(s.emplace(2, "two").second);
+  EXPECT_TRUE(s.insert(CopyCounter(1, "one")).second);
+  EXPECT_FALSE(s.emplace(2, "again").second);
+  auto it = s.emplace_hint(s.begin(), 3, "three");
+  EXPECT_EQ((*it).text, "three");
+  EXPECT_EQ(CopyCounter::copies, 0);
+  EXPECT_EQ(s.size(), 3U);
+  EXPECT_EQ((*s.begin()).text, "one");
+}
+
+TEST(set, PmrMonotonicBuffer) {
+  std::pmr::monotonic_buffer_resource arena;
+  s21::pmr::set<int> s({3, 1, 2}, &arena);
+  s21::pmr::set<int> copy(s, &arena);
+  EXPECT_EQ(copy.size(), 3U);
+  EXPECT_EQ(copy.get_allocator().resource(), &arena);
+}
+
 TEST(map, ConstructorDefaultMap) {
   s21::map<int, char> my_empty_map;
   std::map<int, char> orig_empty_map;
@@ -2067,6 +2586,87 @@ TEST(map, MergeMap) {
   EXPECT_TRUE(my_map.contains(3));
 }
 
+TEST(map, AllocatorCounting) {
+  int live = 0;
+  {
+    using Alloc = CountingAllocator<std::pair<const int, std::string>>;
+    s21::map<int, std::string, std::less<int>, Alloc> m{Alloc(&live)};
+    m.insert(1, "one");
+    m[2] = "two";
+    EXPECT_EQ(live, 2);
+    EXPECT_EQ(m.at(2), "two");
+    EXPECT_EQ(m.get_allocator(), Alloc(&live));
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(map, TryEmplaceAndEmplace) {
+  s21::map<std::string, NoDefault> m;
+  auto result = m.try_emplace("one", 1);
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ((*result.first).second.value, 1);
+  result = m.try_emplace("one", 100);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(m.at("one").value, 1);
+  EXPECT_TRUE(m.emplace("two", NoDefault(2)).second);
+  EXPECT_TRUE(m.insert({"three", NoDefault(3)}).second);
+  EXPECT_FALSE(m.emplace(std::make_pair("two", NoDefault(22))).second);
+  auto hinted = m.emplace_hint(m.begin(), "four", NoDefault(4));
+  EXPECT_EQ((*hinted).second.value, 4);
+  EXPECT_TRUE(m.contains("three"));
+  EXPECT_EQ(m.find("two"), m.find(std::string("two")));
+  EXPECT_EQ(m.size(), 4U);
+}
+
+struct CountingLess {
+  static inline int calls = 0;
+
+  bool operator()(int lhs, int rhs) const {
+    ++calls;
+    return lhs < rhs;
+  }
+};
+
+TEST(map, TryEmplaceWalksTreeOnce) {
+  s21::map<int, std::string, CountingLess> m;
+  for (int i = 0; i < 1023; ++i) {
+    m.insert(i, "v");
+  }
+  // 1023 ascending keys make a perfect AVL tree of height 10; one descent
+  // costs two comparisons per level.
+  CountingLess::calls = 0;
+  EXPECT_TRUE(m.try_emplace(2000, "new").second);
+  EXPECT_LE(CountingLess::calls, 20);
+  CountingLess::calls = 0;
+  EXPECT_FALSE(m.try_emplace(511, "old").second);
+  EXPECT_LE(CountingLess::calls, 2);
+  EXPECT_THROW(m.try_emplace(3000, std::string(), 1, 0), std::out_of_range);
+  EXPECT_FALSE(m.contains(3000));
+  EXPECT_EQ(m.size(), 1024U);
+}
+
+TEST(map, InsertOrAssignMoveOnly) {
+  s21::map<int, std::unique_ptr<int>> m;
+  EXPECT_TRUE(m.insert_or_assign(1, std::make_unique<int>(10)).second);
+  EXPECT_FALSE(m.insert_or_assign(1, std::make_unique<int>(11)).second);
+  EXPECT_EQ(*m.at(1), 11);
+  m[2] = std::make_unique<int>(20);
+  EXPECT_EQ(*m.at(2), 20);
+  EXPECT_EQ(m.size(), 2U);
+}
+
+TEST(map, PmrMonotonicBuffer) {
+  std::pmr::monotonic_buffer_resource arena;
+  s21::pmr::map<int, int> m(&arena);
+  m.insert(1, 10);
+  m.insert(2, 20);
+  EXPECT_EQ(m.at(2), 20);
+  EXPECT_EQ(m.get_allocator().resource(), &arena);
+  s21::pmr::multiset<int> ms({1, 1, 2}, &arena);
+  EXPECT_EQ(ms.count(1), 2U);
+  EXPECT_EQ(ms.get_allocator().resource(), &arena);
+}
+
 TEST(multiset, DefaultConstructor) {
   s21::multiset<int> defaultSet;
 
@@ -2250,6 +2850,2291 @@ TEST(multiset, UpperBoundMethod) {
   EXPECT_EQ(it3, testSet.end());
 }
 
+TEST(multiset, EmplaceAndMove) {
+  s21::multiset<std::string> ms;
+  ms.emplace(3, 'a');
+  std::string value = "aaa";
+  ms.insert(std::move(value));
+  ms.insert("b");
+  EXPECT_EQ(ms.count("aaa"), 2U);
+  EXPECT_EQ(ms.size(), 3U);
+}
+
+TEST(stack, EmplaceAndMovePush) {
+  s21::stack<std::unique_ptr<int>> st;
+  st.push(std::make_unique<int>(1));
+  std::unique_ptr<int> &top = st.emplace(new int(2));
+  EXPECT_EQ(*top, 2);
+  EXPECT_EQ(*st.top(), 2);
+  EXPECT_EQ(st.size(), 2U);
+}
+
+TEST(queue, EmplaceAndMovePush) {
+  s21::queue<std::string> q;
+  std::string value = "first";
+  q.push(std::move(value));
+  q.emplace(2, 'x');
+  EXPECT_EQ(q.front(), "first");
+  EXPECT_EQ(q.back(), "xx");
+}
+
+// A container whose moves are not noexcept.
+struct MayThrowOnMove : s21::vector<int> {
+  MayThrowOnMove() = default;
+  MayThrowOnMove(const MayThrowOnMove &) = default;
+  MayThrowOnMove(MayThrowOnMove &&other) : s21::vector<int>(other) {}
+  MayThrowOnMove &operator=(const MayThrowOnMove &) = default;
+  MayThrowOnMove &operator=(MayThrowOnMove &&other) {
+    s21::vector<int>::operator=(other);
+    return *this;
+  }
+};
+
+TEST(queue, MoveIsNoexceptOnlyIfContainerIs) {
+  EXPECT_EQ(std::is_nothrow_move_assignable_v<s21::queue<int>>,
+            std::is_nothrow_move_assignable_v<s21::deque<int>>);
+  EXPECT_TRUE(std::is_nothrow_move_assignable_v<s21::stack<int>>);
+  EXPECT_TRUE(std::is_nothrow_move_constructible_v<s21::stack<int>>);
+  using Stack = s21::stack<int, MayThrowOnMove>;
+  using Queue = s21::queue<int, MayThrowOnMove>;
+  EXPECT_FALSE(std::is_nothrow_move_assignable_v<Stack>);
+  EXPECT_FALSE(std::is_nothrow_move_constructible_v<Stack>);
+  EXPECT_FALSE(std::is_nothrow_move_assignable_v<Queue>);
+  EXPECT_FALSE(std::is_nothrow_move_constructible_v<Queue>);
+  Stack a;
+  a.push(1);
+  Stack b;
+  b = std::move(a);
+  EXPECT_EQ(b.top(), 1);
+}
+
+TEST(small_vector, InlineThenHeap) {
+  s21::small_vector<std::string, 4> v{"a", "b"};
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(v.capacity(), 4U);
+  v.push_back("c");
+  v.emplace_back(1, 'd');
+  EXPECT_TRUE(v.is_inline());
+  v.insert(v.begin(), "z");
+  EXPECT_FALSE(v.is_inline());
+  EXPECT_EQ(v.size(), 5U);
+  EXPECT_EQ(v[0], "z");
+  EXPECT_EQ(v.back(), "d");
+  v.erase(v.begin());
+  v.pop_back();
+  v.shrink_to_fit();
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(v.size(), 3U);
+  EXPECT_EQ(v[2], "c");
+  EXPECT_ANY_THROW(v.at(3));
+}
+
+TEST(small_vector, InsertMany) {
+  s21::small_vector<int, 3> v{1, 5};
+  auto it = v.insert_many(v.begin() + 1, 2, 3, 4);
+  EXPECT_EQ(*it, 2);
+  v.insert_many_back(6, 7);
+  v.insert_many(v.begin(), 0);
+  ASSERT_EQ(v.size(), 8U);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(v[i], i);
+  }
+}
+
+TEST(small_vector, MoveAndSwapStates) {
+  s21::small_vector<std::unique_ptr<int>, 2> local;
+  local.push_back(std::make_unique<int>(1));
+  s21::small_vector<std::unique_ptr<int>, 2> heap;
+  for (int i = 10; i < 15; ++i) {
+    heap.push_back(std::make_unique<int>(i));
+  }
+  const std::unique_ptr<int> *heap_data = heap.data();
+  local.swap(heap);
+  EXPECT_EQ(local.data(), heap_data);
+  EXPECT_TRUE(heap.is_inline());
+  EXPECT_EQ(*heap[0], 1);
+  EXPECT_EQ(local.size(), 5U);
+
+  s21::small_vector<std::unique_ptr<int>, 2> moved(std::move(local));
+  EXPECT_EQ(moved.data(), heap_data);
+  EXPECT_TRUE(local.empty());
+  EXPECT_TRUE(local.is_inline());
+
+  s21::small_vector<std::unique_ptr<int>, 2> other;
+  other.push_back(std::make_unique<int>(2));
+  other.push_back(std::make_unique<int>(3));
+  heap.swap(other);
+  EXPECT_EQ(heap.size(), 2U);
+  EXPECT_EQ(*heap[1], 3);
+  EXPECT_EQ(*other[0], 1);
+  other = std::move(heap);
+  EXPECT_EQ(other.size(), 2U);
+  EXPECT_EQ(*other[0], 2);
+}
+
+namespace {
+// Copies, and so relocates, only while copies_left is positive.
+struct CopyBudget {
+  explicit CopyBudget(int v) : value(v) {}
+  CopyBudget(const CopyBudget &other) : value(other.value) {
+    if (copies_left-- <= 0) {
+      throw std::runtime_error("copy");
+    }
+  }
+  CopyBudget &operator=(const CopyBudget &) = default;
+
+  static inline int copies_left = 0;
+  int value;
+};
+}  // namespace
+
+TEST(small_vector, ThrowingSwapLeavesBothIntact) {
+  s21::small_vector<CopyBudget, 2> local;
+  s21::small_vector<CopyBudget, 2> heap;
+  CopyBudget::copies_left = 100;
+  local.emplace_back(1);
+  local.emplace_back(2);
+  for (int i = 10; i < 15; ++i) {
+    heap.emplace_back(i);
+  }
+  const CopyBudget *heap_data = heap.data();
+  CopyBudget::copies_left = 1;
+  EXPECT_THROW(local.swap(heap), std::runtime_error);
+  EXPECT_TRUE(local.is_inline());
+  ASSERT_EQ(local.size(), 2U);
+  EXPECT_EQ(local[1].value, 2);
+  EXPECT_EQ(heap.data(), heap_data);
+  ASSERT_EQ(heap.size(), 5U);
+  EXPECT_EQ(heap[4].value, 14);
+  CopyBudget::copies_left = 100;
+  heap.swap(local);
+  EXPECT_EQ(local.data(), heap_data);
+  EXPECT_TRUE(heap.is_inline());
+  EXPECT_EQ(heap[0].value, 1);
+}
+
+TEST(small_vector, CopyAndNoDefault) {
+  {
+    s21::small_vector<NoDefault, 2> v;
+    for (int i = 0; i < 5; ++i) {
+      v.emplace_back(i);
+    }
+    s21::small_vector<NoDefault, 2> copy(v);
+    EXPECT_EQ(NoDefault::alive, 10);
+    copy = v;
+    copy.emplace(copy.begin() + 2, 42);
+    EXPECT_EQ(copy[2].value, 42);
+    EXPECT_EQ(copy[3].value, 2);
+  }
+  EXPECT_EQ(NoDefault::alive, 0);
+}
+
+const s21::simd::isa kAllIsas[] = {s21::simd::isa::scalar,
+                                   s21::simd::isa::sse2, s21::simd::isa::avx2,
+                                   s21::simd::isa::avx512};
+
+template <class T>
+void CheckSimdAgainstStd(const std::vector<T> &values) {
+  for (std::size_t n = 0; n <= values.size(); n += 7) {
+    const T *first = values.data();
+    const T *last = first + n;
+    for (s21::simd::isa level : kAllIsas) {
+      s21::simd::set_isa(level);
+      for (std::size_t i = 0; i < n; i += 5) {
+        EXPECT_EQ(s21::simd::find(first, last, values[i]),
+                  std::find(first, last, values[i]));
+        EXPECT_EQ(s21::simd::count(first, last, values[i]),
+                  static_cast<std::size_t>(std::count(first, last, values[i])));
+      }
+      EXPECT_EQ(s21::simd::find(first, last, T(1000)), last);
+      EXPECT_EQ(s21::simd::min_element(first, last),
+                std::min_element(first, last));
+      EXPECT_EQ(s21::simd::max_element(first, last),
+                std::max_element(first, last));
+      std::vector<T> copy(first, last);
+      EXPECT_TRUE(s21::simd::equal(first, last, copy.data()));
+      if (n != 0) {
+        copy[n - 1] = T(-1000);
+        EXPECT_FALSE(s21::simd::equal(first, last, copy.data()));
+        s21::simd::fill(copy.data(), copy.data() + n, T(3));
+        EXPECT_EQ(std::count(copy.begin(), copy.end(), T(3)),
+                  static_cast<std::ptrdiff_t>(n));
+      }
+    }
+  }
+  s21::simd::set_isa(s21::simd::detected_isa());
+}
+
+TEST(simd, MatchesStdAlgorithmsOnEveryIsa) {
+  std::vector<std::int32_t> ints;
+  std::vector<float> floats;
+  std::vector<double> doubles;
+  unsigned seed = 12345;
+  for (int i = 0; i < 150; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int value = static_cast<int>(seed >> 16) % 97 - 48;
+    ints.push_back(value);
+    floats.push_back(static_cast<float>(value) / 4);
+    doubles.push_back(value);
+  }
+  CheckSimdAgainstStd(ints);
+  CheckSimdAgainstStd(floats);
+  CheckSimdAgainstStd(doubles);
+}
+
+TEST(simd, FloatNanAndSignedZero) {
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<float> values(40, 2.0f);
+  values[3] = nan;
+  values[17] = 0.0f;
+  values[21] = -0.0f;
+  values[33] = nan;
+  std::vector<float> leading_nan(values);
+  leading_nan[0] = nan;
+  for (s21::simd::isa level : kAllIsas) {
+    s21::simd::set_isa(level);
+    const float *first = values.data();
+    const float *last = first + values.size();
+    EXPECT_EQ(s21::simd::min_element(first, last), first + 17);
+    EXPECT_EQ(s21::simd::max_element(first, last), first);
+    EXPECT_EQ(s21::simd::find(first, last, nan), last);
+    EXPECT_EQ(s21::simd::find(first, last, -0.0f), first + 17);
+    EXPECT_EQ(s21::simd::count(first, last, 0.0f), 2U);
+    EXPECT_FALSE(s21::simd::equal(first, last, first));
+    EXPECT_EQ(s21::simd::min_element(leading_nan.data(),
+                                     leading_nan.data() + 40),
+              leading_nan.data());
+  }
+  s21::simd::set_isa(s21::simd::detected_isa());
+}
+
+TEST(simd, ContainerOverloads) {
+  s21::vector<std::int32_t> v(100);
+  s21::simd::fill(v, 7);
+  v[60] = -2;
+  v[61] = 9;
+  EXPECT_EQ(s21::simd::count(v, 7), 98U);
+  EXPECT_EQ(s21::simd::find(v, 9), v.data() + 61);
+  EXPECT_EQ(*s21::simd::min_element(v), -2);
+  EXPECT_EQ(*s21::simd::max_element(v), 9);
+  const s21::vector<std::int32_t> &cv = v;
+  EXPECT_EQ(s21::simd::find(cv, 42), cv.data() + cv.size());
+
+  s21::array<float, 20> a;
+  s21::array<float, 20> b;
+  s21::simd::fill(a, 1.5f);
+  s21::simd::fill(b, 1.5f);
+  EXPECT_TRUE(s21::simd::equal(a, b));
+  b[19] = 0.0f;
+  EXPECT_FALSE(s21::simd::equal(a, b));
+  EXPECT_TRUE(s21::simd::set_isa(s21::simd::isa::avx512) <=
+              s21::simd::detected_isa());
+  s21::simd::set_isa(s21::simd::detected_isa());
+}
+
+TEST(parallel, ParUsesTheDefaultTaskPool) {
+  EXPECT_EQ(&s21::parallel::internal::PoolOf(s21::parallel::par),
+            &s21::default_task_pool());
+  s21::vector<long> v(100000);
+  s21::parallel::fill(s21::parallel::par, v.begin(), v.end(), 3L);
+  EXPECT_EQ(s21::parallel::reduce(s21::parallel::par, v.begin(), v.end()),
+            300000L);
+}
+
+TEST(parallel, ElementwiseAlgorithmsMatchStd) {
+  s21::task_pool pool(3);
+  s21::parallel::policy pol{&pool, 100};
+  s21::vector<long> v(10007);
+  s21::parallel::fill(pol, v.begin(), v.end(), 2L);
+  EXPECT_EQ(std::count(v.begin(), v.end(), 2L), 10007);
+  std::iota(v.begin(), v.end(), -5000L);
+
+  s21::vector<long> squares(v.size());
+  s21::parallel::transform(pol, v.begin(), v.end(), squares.begin(),
+                           [](long x) { return x * x; });
+  s21::vector<long> sums(v.size());
+  s21::parallel::transform(pol, v.begin(), v.end(), squares.begin(),
+                           sums.begin(), std::plus<>());
+  s21::parallel::for_each(pol, v.begin(), v.end(), [](long &x) { x *= 3; });
+  for (std::size_t i = 0; i < v.size(); i += 97) {
+    long x = static_cast<long>(i) - 5000;
+    EXPECT_EQ(squares[i], x * x);
+    EXPECT_EQ(sums[i], x + x * x);
+    EXPECT_EQ(v[i], 3 * x);
+  }
+
+  s21::vector<long> copy(v.size());
+  EXPECT_EQ(s21::parallel::copy(pol, v.begin(), v.end(), copy.begin()),
+            copy.end());
+  EXPECT_TRUE(std::equal(v.begin(), v.end(), copy.begin()));
+
+  s21::array<int, 5> small{1, 2, 3, 4, 5};
+  s21::parallel::for_each(s21::parallel::par, small.begin(), small.end(),
+                          [](int &x) { x = -x; });
+  EXPECT_EQ(small[4], -5);
+}
+
+TEST(parallel, ReduceAndScanKeepOrder) {
+  s21::task_pool pool(4);
+  s21::parallel::policy pol{&pool, 64};
+  s21::vector<std::string> words(1000);
+  for (std::size_t i = 0; i < words.size(); ++i) {
+    words[i] = std::string(1, static_cast<char>('a' + i % 26));
+  }
+  std::string expected =
+      std::accumulate(words.begin(), words.end(), std::string(">"));
+  EXPECT_EQ(s21::parallel::reduce(pol, words.begin(), words.end(),
+                                  std::string(">"), std::plus<>()),
+            expected);
+
+  s21::vector<long> v(5000);
+  std::iota(v.begin(), v.end(), 1L);
+  EXPECT_EQ(s21::parallel::reduce(pol, v.begin(), v.end()), 5000L * 5001 / 2);
+  EXPECT_EQ(s21::parallel::reduce(pol, v.begin(), v.begin(), 7L), 7L);
+
+  s21::vector<long> scanned(v.size());
+  s21::parallel::inclusive_scan(pol, v.begin(), v.end(), scanned.begin());
+  s21::parallel::inclusive_scan(pol, v.begin(), v.end(), v.begin());
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    long n = static_cast<long>(i) + 1;
+    ASSERT_EQ(scanned[i], n * (n + 1) / 2);
+    ASSERT_EQ(v[i], scanned[i]);
+  }
+}
+
+TEST(parallel, SortAndStableSort) {
+  s21::task_pool pool(4);
+  s21::parallel::policy pol{&pool, 50};
+  s21::vector<int> values(9999);
+  unsigned seed = 7;
+  for (int &x : values) {
+    seed = seed * 1103515245 + 12345;
+    x = static_cast<int>(seed >> 16) % 1000;
+  }
+  s21::vector<int> expected(values);
+  std::sort(expected.begin(), expected.end());
+  s21::parallel::sort(pol, values.begin(), values.end());
+  EXPECT_TRUE(std::equal(values.begin(), values.end(), expected.begin()));
+  s21::parallel::sort(pol, values.begin(), values.end(), std::greater<>());
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end(), std::greater<>()));
+
+  s21::vector<std::pair<int, int>> pairs;
+  for (int i = 0; i < 5000; ++i) {
+    pairs.push_back({(i * 7919) % 13, i});
+  }
+  s21::parallel::stable_sort(
+      pol, pairs.begin(), pairs.end(),
+      [](const auto &a, const auto &b) { return a.first < b.first; });
+  for (std::size_t i = 1; i < pairs.size(); ++i) {
+    ASSERT_TRUE(pairs[i - 1].first < pairs[i].first ||
+                (pairs[i - 1].first == pairs[i].first &&
+                 pairs[i - 1].second < pairs[i].second));
+  }
+
+  s21::vector<std::unique_ptr<int>> owners;
+  for (int i = 300; i > 0; --i) {
+    owners.push_back(std::make_unique<int>(i));
+  }
+  s21::parallel::sort(pol, owners.begin(), owners.end(),
+                      [](const auto &a, const auto &b) { return *a < *b; });
+  for (int i = 0; i < 300; ++i) {
+    ASSERT_EQ(*owners[i], i + 1);
+  }
+}
+
+namespace {
+// Counts live objects; copying the value -1 throws.
+struct LiveCount {
+  explicit LiveCount(int v) : value(v) { ++live; }
+  LiveCount(const LiveCount &other) : value(other.value) {
+    if (value < 0) {
+      throw std::runtime_error("copy");
+    }
+    ++live;
+  }
+  ~LiveCount() { --live; }
+
+  static inline std::atomic<int> live{0};
+  int value;
+};
+}  // namespace
+
+TEST(parallel, UninitializedFillAndCopyIntoRawStorage) {
+  s21::task_pool pool(3);
+  s21::parallel::policy pol{&pool, 100};
+  constexpr std::size_t kCount = 10007;
+  std::allocator<std::string> strings;
+  std::string *raw = strings.allocate(kCount);
+  s21::parallel::uninitialized_fill(pol, raw, raw + kCount,
+                                    std::string("filled in parallel"));
+  EXPECT_EQ(raw[kCount - 1], "filled in parallel");
+  std::string *copy = strings.allocate(kCount);
+  EXPECT_EQ(s21::parallel::uninitialized_copy(pol, raw, raw + kCount, copy),
+            copy + kCount);
+  EXPECT_TRUE(std::equal(raw, raw + kCount, copy));
+  std::destroy(raw, raw + kCount);
+  std::destroy(copy, copy + kCount);
+  strings.deallocate(raw, kCount);
+  strings.deallocate(copy, kCount);
+
+  {
+    s21::vector<LiveCount> source;
+    source.reserve(1000);
+    for (int i = 0; i < 1000; ++i) {
+      source.emplace_back(i == 777 ? -1 : i);
+    }
+    std::allocator<LiveCount> alloc;
+    LiveCount *out = alloc.allocate(source.size());
+    EXPECT_THROW(s21::parallel::uninitialized_copy(pol, source.begin(),
+                                                   source.end(), out),
+                 std::runtime_error);
+    EXPECT_EQ(LiveCount::live, 1000);
+    EXPECT_THROW(s21::parallel::uninitialized_fill(pol, out, out + 1000,
+                                                   source[777]),
+                 std::runtime_error);
+    EXPECT_EQ(LiveCount::live, 1000);
+    alloc.deallocate(out, source.size());
+  }
+  EXPECT_EQ(LiveCount::live, 0);
+}
+
+TEST(parallel, ExceptionsAndNestedCalls) {
+  s21::task_pool pool(2);
+  s21::parallel::policy pol{&pool, 10};
+  s21::vector<int> v(1000);
+  EXPECT_THROW(
+      s21::parallel::for_each(pol, v.begin(), v.end(),
+                              [](int &) { throw std::runtime_error("x"); }),
+      std::runtime_error);
+
+  s21::vector<s21::vector<int>> rows(20);
+  for (s21::vector<int> &row : rows) {
+    row.resize(500);
+  }
+  s21::parallel::policy outer{&pool, 1};
+  s21::parallel::for_each(outer, rows.begin(), rows.end(),
+                          [&](s21::vector<int> &row) {
+                            s21::parallel::fill(pol, row.begin(), row.end(),
+                                                 4);
+                          });
+  for (s21::vector<int> &row : rows) {
+    EXPECT_EQ(std::count(row.begin(), row.end(), 4), 500);
+  }
+}
+
+TEST(mmap_vector, AppendCloseAndReopen) {
+  std::string path = testing::TempDir() + "s21_mmap_vector_append.bin";
+  std::remove(path.c_str());
+  {
+    s21::mmap_vector<std::int64_t> v(path);
+    EXPECT_TRUE(v.is_open());
+    EXPECT_TRUE(v.empty());
+    for (std::int64_t i = 0; i < 100000; ++i) {
+      v.push_back(i * 3);
+    }
+    v.emplace_back(v[7]);
+    EXPECT_EQ(v.size(), 100001U);
+    EXPECT_GE(v.capacity(), v.size());
+    EXPECT_EQ(v.back(), 21);
+    v.pop_back();
+    v.flush();
+  }
+  struct stat st;
+  ASSERT_EQ(stat(path.c_str(), &st), 0);
+  EXPECT_EQ(static_cast<std::size_t>(st.st_size),
+            100000 * sizeof(std::int64_t));
+
+  s21::mmap_vector<std::int64_t> reopened(path);
+  ASSERT_EQ(reopened.size(), 100000U);
+  EXPECT_EQ(reopened.front(), 0);
+  EXPECT_EQ(reopened[99999], 299997);
+  reopened.advise(s21::mmap_vector<std::int64_t>::access::sequential);
+  EXPECT_EQ(std::accumulate(reopened.begin(), reopened.end(), std::int64_t{0}),
+            std::int64_t{3} * 99999 * 100000 / 2);
+  reopened.advise(s21::mmap_vector<std::int64_t>::access::random);
+  reopened.push_back(-1);
+  EXPECT_EQ(reopened.at(100000), -1);
+  EXPECT_THROW(reopened.at(100001), std::out_of_range);
+  reopened.close();
+  EXPECT_FALSE(reopened.is_open());
+  std::remove(path.c_str());
+}
+
+TEST(mmap_vector, FlushedFileReopensWithoutClose) {
+  std::string path = testing::TempDir() + "s21_mmap_vector_flush.bin";
+  std::remove(path.c_str());
+  s21::mmap_vector<std::int64_t> v(path);
+  for (std::int64_t i = 0; i < 1000; ++i) {
+    v.push_back(i);
+  }
+  ASSERT_GT(v.capacity(), v.size());
+  v.flush();
+  {
+    // A second mapping sees what a reopen after a crash would.
+    s21::mmap_vector<std::int64_t> crashed(
+        path, s21::mmap_vector<std::int64_t>::mode::read_only);
+    ASSERT_EQ(crashed.size(), 1000U);
+    EXPECT_EQ(crashed.back(), 999);
+  }
+  for (std::int64_t i = 1000; i < 1500; ++i) {
+    v.push_back(i);
+  }
+  v.resize(1600, 7);
+  v.flush(true);
+  {
+    s21::mmap_vector<std::int64_t> crashed(
+        path, s21::mmap_vector<std::int64_t>::mode::read_only);
+    ASSERT_EQ(crashed.size(), 1600U);
+    EXPECT_EQ(crashed[1499], 1499);
+    EXPECT_EQ(crashed.back(), 7);
+  }
+  v.close();
+  std::remove(path.c_str());
+}
+
+TEST(mmap_vector, ReadOnlyResizeAndMove) {
+  std::string path = testing::TempDir() + "s21_mmap_vector_resize.bin";
+  std::remove(path.c_str());
+  {
+    s21::mmap_vector<float> v(path);
+    v.resize(10, 1.5f);
+    v.resize(5000, 2.5f);
+    EXPECT_EQ(v[9], 1.5f);
+    EXPECT_EQ(v[4999], 2.5f);
+    v.resize(20);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 20U);
+    s21::mmap_vector<float> moved(std::move(v));
+    EXPECT_FALSE(v.is_open());
+    EXPECT_EQ(moved.size(), 20U);
+    moved.flush(true);
+  }
+  using ReadOnly = s21::mmap_vector<float>;
+  ReadOnly ro(path, ReadOnly::mode::read_only);
+  EXPECT_FALSE(ro.is_writable());
+  ASSERT_EQ(ro.size(), 20U);
+  EXPECT_EQ(ro[19], 2.5f);
+  EXPECT_THROW(ro.push_back(1.0f), std::logic_error);
+  EXPECT_THROW(ro.clear(), std::logic_error);
+  ro.close();
+
+  s21::mmap_vector<std::array<char, 3>> odd;
+  EXPECT_THROW(odd.open(path, decltype(odd)::mode::read_only),
+               std::runtime_error);
+  EXPECT_THROW(ReadOnly(path + ".missing", ReadOnly::mode::read_only),
+               std::system_error);
+  std::remove(path.c_str());
+
+  s21::mmap_vector<int> emptied(path);
+  emptied.push_back(1);
+  emptied.clear();
+  emptied.shrink_to_fit();
+  EXPECT_EQ(emptied.capacity(), 0U);
+  emptied.push_back(2);
+  EXPECT_EQ(emptied[0], 2);
+  emptied.close();
+  std::remove(path.c_str());
+}
+
+struct SnapshotRecord {
+  std::int64_t id;
+  double score;
+  char tag[4];
+};
+
+TEST(snapshot, RawVectorRoundTripAndView) {
+  std::string path = testing::TempDir() + "s21_snapshot_raw.bin";
+  s21::vector<SnapshotRecord> records;
+  for (int i = 0; i < 50000; ++i) {
+    records.push_back({i, i * 0.5, {'r', 'e', 'c', 0}});
+  }
+  s21::save(path, records);
+
+  s21::vector<SnapshotRecord> loaded;
+  s21::load(path, loaded);
+  ASSERT_EQ(loaded.size(), records.size());
+  EXPECT_EQ(loaded[49999].id, 49999);
+  EXPECT_EQ(loaded[123].score, 61.5);
+  EXPECT_STREQ(loaded[7].tag, "rec");
+
+  s21::snapshot_view<SnapshotRecord> view(path);
+  ASSERT_EQ(view.size(), 50000U);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(view.data()) % 64, 0U);
+  EXPECT_EQ(view.front().id, 0);
+  EXPECT_EQ(view.back().id, 49999);
+  EXPECT_EQ(view.at(10).score, 5.0);
+  EXPECT_THROW(view.at(50000), std::out_of_range);
+  std::int64_t sum = 0;
+  for (const SnapshotRecord &r : view) {
+    sum += r.id;
+  }
+  EXPECT_EQ(sum, std::int64_t{49999} * 50000 / 2);
+  s21::snapshot_view<SnapshotRecord> moved(std::move(view));
+  EXPECT_TRUE(view.empty());
+  EXPECT_EQ(moved[3].id, 3);
+  std::remove(path.c_str());
+}
+
+TEST(snapshot, ArrayAndEmpty) {
+  std::string path = testing::TempDir() + "s21_snapshot_array.bin";
+  s21::array<int, 5> a{1, 2, 3, 4, 5};
+  s21::save(path, a);
+  s21::array<int, 5> b;
+  s21::load(path, b);
+  EXPECT_EQ(b[0], 1);
+  EXPECT_EQ(b[4], 5);
+  s21::array<int, 4> wrong;
+  EXPECT_THROW(s21::load(path, wrong), std::runtime_error);
+  s21::vector<int> as_vector;
+  s21::load(path, as_vector);
+  EXPECT_EQ(as_vector.size(), 5U);
+
+  s21::save(path, s21::vector<int>());
+  s21::load(path, as_vector);
+  EXPECT_TRUE(as_vector.empty());
+  EXPECT_TRUE(s21::snapshot_view<int>(path).empty());
+  std::remove(path.c_str());
+}
+
+struct alignas(256) OverAlignedRecord {
+  std::int64_t id;
+};
+
+TEST(snapshot, OverAlignedPaddingIsZero) {
+  std::string path = testing::TempDir() + "s21_snapshot_aligned.bin";
+  s21::vector<OverAlignedRecord> records;
+  for (int i = 0; i < 3; ++i) {
+    records.push_back({i + 1});
+  }
+  s21::save(path, records);
+
+  std::FILE *file = std::fopen(path.c_str(), "rb");
+  ASSERT_NE(file, nullptr);
+  unsigned char bytes[256];
+  ASSERT_EQ(std::fread(bytes, 1, sizeof(bytes), file), sizeof(bytes));
+  std::fclose(file);
+  for (std::size_t i = sizeof(s21::snapshot_header); i < sizeof(bytes); ++i) {
+    ASSERT_EQ(bytes[i], 0) << "padding byte " << i;
+  }
+
+  s21::snapshot_view<OverAlignedRecord> view(path);
+  ASSERT_EQ(view.size(), 3U);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(view.data()) % 256, 0U);
+  EXPECT_EQ(view[2].id, 3);
+  s21::vector<OverAlignedRecord> loaded;
+  s21::load(path, loaded);
+  ASSERT_EQ(loaded.size(), 3U);
+  EXPECT_EQ(loaded[0].id, 1);
+  std::remove(path.c_str());
+}
+
+TEST(snapshot, CodecsForNonTrivialTypes) {
+  std::string path = testing::TempDir() + "s21_snapshot_codec.bin";
+  s21::vector<std::string> words{"", "alpha", std::string(100000, 'x')};
+  s21::save(path, words);
+  s21::vector<std::string> loaded{"stale"};
+  s21::load(path, loaded);
+  ASSERT_EQ(loaded.size(), 3U);
+  EXPECT_EQ(loaded[0], "");
+  EXPECT_EQ(loaded[1], "alpha");
+  EXPECT_EQ(loaded[2].size(), 100000U);
+
+  s21::vector<s21::vector<std::string>> nested;
+  nested.push_back(s21::vector<std::string>{"a", "b"});
+  nested.push_back(s21::vector<std::string>());
+  nested.push_back(s21::vector<std::string>{"c"});
+  s21::save(path, nested);
+  s21::vector<s21::vector<std::string>> nested_loaded;
+  s21::load(path, nested_loaded);
+  ASSERT_EQ(nested_loaded.size(), 3U);
+  EXPECT_EQ(nested_loaded[0][1], "b");
+  EXPECT_TRUE(nested_loaded[1].empty());
+  EXPECT_EQ(nested_loaded[2][0], "c");
+
+  std::remove(path.c_str());
+}
+
+TEST(snapshot, RejectsMismatchedFiles) {
+  std::string path = testing::TempDir() + "s21_snapshot_errors.bin";
+  s21::save(path, s21::vector<std::string>{"a", "b", "c"});
+  s21::array<std::string, 3> fixed;
+  s21::load(path, fixed);
+  EXPECT_EQ(fixed[2], "c");
+  s21::vector<int> ints;
+  EXPECT_THROW(s21::load(path, ints), std::runtime_error);
+  EXPECT_THROW(s21::snapshot_view<int>{path}, std::runtime_error);
+
+  s21::save(path, s21::vector<std::int32_t>(1000));
+  s21::vector<std::int64_t> wide;
+  EXPECT_THROW(s21::load(path, wide), std::runtime_error);
+  ASSERT_EQ(truncate(path.c_str(), 1000), 0);
+  EXPECT_THROW(s21::load(path, ints), std::runtime_error);
+  EXPECT_THROW(s21::snapshot_view<std::int32_t>{path}, std::runtime_error);
+  ASSERT_EQ(truncate(path.c_str(), 10), 0);
+  EXPECT_THROW(s21::snapshot_view<std::int32_t>{path}, std::runtime_error);
+  EXPECT_THROW(s21::load(path + ".missing", ints), std::system_error);
+  std::remove(path.c_str());
+}
+
+namespace {
+struct Label {
+  std::string text;
+};
+}  // namespace
+
+template <>
+struct s21::codec<Label> {
+  static constexpr std::uint32_t version = 2;
+  static void encode(snapshot_writer &out, const Label &label) {
+    codec<std::string>::encode(out, label.text);
+  }
+  static Label decode(snapshot_reader &in) {
+    return Label{codec<std::string>::decode(in)};
+  }
+};
+
+TEST(snapshot, EncodedHeaderRecordsCodecVersionNotLayout) {
+  std::string path = testing::TempDir() + "s21_snapshot_codec_version.bin";
+  auto read_header = [&path] {
+    s21::snapshot_header header{};
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    EXPECT_EQ(std::fread(&header, sizeof(header), 1, file), 1U);
+    std::fclose(file);
+    return header;
+  };
+  s21::save(path, s21::vector<std::string>{"a", "b"});
+  s21::snapshot_header header = read_header();
+  EXPECT_EQ(header.flags, 0U);
+  EXPECT_EQ(header.element_size, 0U);
+  EXPECT_EQ(header.element_align, 1U);
+
+  s21::save(path, s21::vector<Label>{{"a"}, {"b"}});
+  header = read_header();
+  EXPECT_EQ(header.element_size, 0U);
+  EXPECT_EQ(header.element_align, 2U);
+  s21::vector<std::string> words;
+  EXPECT_THROW(s21::load(path, words), std::runtime_error);
+  s21::vector<Label> labels;
+  s21::load(path, labels);
+  ASSERT_EQ(labels.size(), 2U);
+  EXPECT_EQ(labels[1].text, "b");
+
+  header.element_size = sizeof(Label);
+  std::FILE *file = std::fopen(path.c_str(), "r+b");
+  ASSERT_EQ(std::fwrite(&header, sizeof(header), 1, file), 1U);
+  std::fclose(file);
+  EXPECT_THROW(s21::load(path, labels), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+template <std::size_t Align, class T>
+bool IsAligned(const T *p) {
+  return reinterpret_cast<std::uintptr_t>(p) % Align == 0;
+}
+
+TEST(aligned_storage, VectorKeepsAlignment) {
+  s21::aligned_vector<float> v;
+  EXPECT_EQ(decltype(v)::allocator_type::alignment, 64U);
+  for (int i = 0; i < 1000; ++i) {
+    v.push_back(static_cast<float>(i));
+    ASSERT_TRUE(IsAligned<64>(v.data()));
+  }
+  v.insert(v.begin() + 3, 5000, 1.0f);
+  EXPECT_TRUE(IsAligned<64>(v.data()));
+  v.shrink_to_fit();
+  EXPECT_TRUE(IsAligned<64>(v.data()));
+  s21::aligned_vector<float> copy(v);
+  EXPECT_TRUE(IsAligned<64>(copy.data()));
+  EXPECT_EQ(copy[999 + 5000], 999.0f);
+  s21::aligned_vector<float> assigned;
+  assigned = copy;
+  EXPECT_TRUE(IsAligned<64>(assigned.data()));
+  s21::aligned_vector<float> moved(std::move(copy));
+  EXPECT_TRUE(IsAligned<64>(moved.data()));
+  moved.swap(v);
+  EXPECT_TRUE(IsAligned<64>(moved.data()));
+
+  s21::aligned_vector<char, 4096> page(10);
+  page.resize(100000);
+  EXPECT_TRUE(IsAligned<4096>(page.data()));
+  s21::aligned_vector<std::string, 32> strings;
+  for (int i = 0; i < 100; ++i) {
+    strings.emplace_back(std::to_string(i));
+  }
+  EXPECT_TRUE(IsAligned<32>(strings.data()));
+  EXPECT_EQ(strings[42], "42");
+}
+
+TEST(aligned_storage, ArrayAlignment) {
+  struct Holder {
+    char pad;
+    s21::aligned_array<int, 10> values;
+  };
+  Holder h;
+  EXPECT_TRUE(IsAligned<64>(h.values.data()));
+  EXPECT_EQ(alignof(s21::array<double, 4, 32>), 32U);
+  s21::array<int, 3, 16> a{1, 2, 3};
+  EXPECT_TRUE(IsAligned<16>(a.data()));
+  EXPECT_EQ(a[2], 3);
+  EXPECT_EQ(alignof(s21::array<double, 4>), alignof(double));
+}
+
+TEST(soa_vector, ColumnsAndRows) {
+  s21::soa_vector<float, double, int> v;
+  EXPECT_TRUE(v.empty());
+  for (int i = 0; i < 1000; ++i) {
+    v.emplace_back(i * 1.0f, i * 0.5, i);
+  }
+  EXPECT_EQ(v.size(), 1000U);
+  EXPECT_GE(v.capacity(), 1000U);
+  EXPECT_TRUE(IsAligned<64>(v.data<0>()));
+  EXPECT_TRUE(IsAligned<64>(v.data<1>()));
+  EXPECT_TRUE(IsAligned<64>(v.data<2>()));
+
+  auto ids = v.get<2>();
+  EXPECT_EQ(ids.size(), 1000U);
+  EXPECT_EQ(std::accumulate(ids.begin(), ids.end(), 0), 999 * 1000 / 2);
+  for (float &x : v.get<0>()) {
+    x += 1.0f;
+  }
+  EXPECT_EQ(v.get<0>()[10], 11.0f);
+
+  auto [x, y, id] = v[20];
+  x = -1.0f;
+  EXPECT_EQ(v.get<0>()[20], -1.0f);
+  EXPECT_EQ(y, 10.0);
+  EXPECT_EQ(id, 20);
+  v[21] = std::make_tuple(2.0f, 3.0, 4);
+  EXPECT_EQ(std::get<2>(v.at(21)), 4);
+  EXPECT_EQ(std::get<1>(v.front()), 0.0);
+  EXPECT_EQ(std::get<2>(v.back()), 999);
+  EXPECT_THROW(v.at(1000), std::out_of_range);
+
+  const auto &cv = v;
+  EXPECT_EQ(std::get<2>(cv[5]), 5);
+  EXPECT_EQ(cv.get<1>().back(), 499.5);
+  int count = 0;
+  for (auto row : cv) {
+    count += std::get<2>(row) >= 0;
+  }
+  EXPECT_EQ(count, 1000);
+  EXPECT_EQ(cv.end() - cv.begin(), 1000);
+}
+
+TEST(soa_vector, InsertEraseAndCapacity) {
+  s21::soa_vector<int, std::string> v{{1, "one"}, {3, "three"}};
+  auto it = v.insert(v.begin() + 1, std::make_tuple(2, std::string("two")));
+  EXPECT_EQ(std::get<0>(*it), 2);
+  v.push_back(std::make_tuple(4, std::string("four")));
+  v.insert(v.begin(), std::make_tuple(0, std::string("zero")));
+  ASSERT_EQ(v.size(), 5U);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(v.get<0>()[i], i);
+  }
+  EXPECT_EQ(v.get<1>()[2], "two");
+
+  it = v.erase(v.begin() + 1, v.begin() + 3);
+  EXPECT_EQ(std::get<1>(*it), "three");
+  v.erase(v.begin());
+  ASSERT_EQ(v.size(), 2U);
+  EXPECT_EQ(v.get<1>()[1], "four");
+
+  v.reserve(100);
+  EXPECT_EQ(v.capacity(), 100U);
+  EXPECT_EQ(v.get<1>()[0], "three");
+  v.shrink_to_fit();
+  EXPECT_EQ(v.capacity(), 2U);
+  v.resize(4);
+  EXPECT_EQ(v.get<1>()[3], "");
+  v.resize(6, std::make_tuple(7, std::string("seven")));
+  EXPECT_EQ(v.get<0>()[5], 7);
+  v.push_back(v[5]);
+  EXPECT_EQ(v.get<1>()[6], "seven");
+  v.pop_back();
+  v.resize(1);
+  EXPECT_EQ(v.size(), 1U);
+
+  s21::soa_vector<int, std::string> copy(v);
+  copy.emplace_back(9, "nine");
+  EXPECT_EQ(v.size(), 1U);
+  EXPECT_EQ(copy.get<1>()[1], "nine");
+  s21::soa_vector<int, std::string> moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  v = moved;
+  EXPECT_EQ(v.size(), 2U);
+  v.clear();
+  EXPECT_TRUE(v.empty());
+  EXPECT_EQ(v.capacity(), 2U);
+  s21::soa_vector<char, long double> sized(3);
+  EXPECT_EQ(sized.get<1>()[2], 0.0L);
+}
+
+TEST(dynamic_bitset, BitsAndProxies) {
+  s21::dynamic_bitset bits;
+  EXPECT_TRUE(bits.empty());
+  EXPECT_EQ(bits.find_first(), s21::dynamic_bitset::npos);
+  for (int i = 0; i < 200; ++i) {
+    bits.push_back(i % 3 == 0);
+  }
+  EXPECT_EQ(bits.size(), 200U);
+  EXPECT_EQ(bits.num_blocks(), 4U);
+  EXPECT_EQ(bits.count(), 67U);
+  EXPECT_TRUE(bits[3]);
+  EXPECT_FALSE(bits[4]);
+  bits[4] = true;
+  bits[3] = bits[5];
+  EXPECT_TRUE(bits.test(4));
+  EXPECT_FALSE(bits.test(3));
+  EXPECT_FALSE(~bits[4]);
+  bits[4].flip();
+  EXPECT_FALSE(bits[4]);
+  EXPECT_THROW(bits.test(200), std::out_of_range);
+  EXPECT_THROW(bits.set(200), std::out_of_range);
+
+  EXPECT_EQ(bits.find_first(), 0U);
+  EXPECT_EQ(bits.find_next(0), 6U);
+  EXPECT_EQ(bits.find_next(62), 63U);
+  EXPECT_EQ(bits.find_next(63), 66U);
+  EXPECT_EQ(bits.find_next(198), s21::dynamic_bitset::npos);
+  std::size_t visited = 0;
+  for (std::size_t i = bits.find_first(); i != s21::dynamic_bitset::npos;
+       i = bits.find_next(i)) {
+    ++visited;
+  }
+  EXPECT_EQ(visited, bits.count());
+
+  bits.flip();
+  EXPECT_EQ(bits.count(), 134U);
+  bits.set();
+  EXPECT_TRUE(bits.all());
+  EXPECT_EQ(bits.count(), 200U);
+  bits.reset();
+  EXPECT_TRUE(bits.none());
+  bits.set(199).flip(198).reset(199);
+  EXPECT_EQ(bits.find_first(), 198U);
+  bits.pop_back();
+  bits.pop_back();
+  EXPECT_EQ(bits.size(), 198U);
+  EXPECT_TRUE(bits.none());
+}
+
+TEST(dynamic_bitset, ResizeAppendAndBulkOps) {
+  s21::dynamic_bitset a(100, true);
+  EXPECT_EQ(a.count(), 100U);
+  a.resize(130, false);
+  EXPECT_EQ(a.count(), 100U);
+  a.resize(300, true);
+  EXPECT_EQ(a.count(), 270U);
+  EXPECT_FALSE(a[129]);
+  EXPECT_TRUE(a[130]);
+  a.resize(70);
+  EXPECT_EQ(a.count(), 70U);
+  EXPECT_EQ(a.num_blocks(), 2U);
+
+  s21::dynamic_bitset words;
+  words.push_back(true);
+  words.append(0xF0F0F0F0F0F0F0F0ULL);
+  words.append(0x7, 3);
+  words.append(0xFF, 2);
+  EXPECT_EQ(words.size(), 70U);
+  EXPECT_EQ(words.count(), 1U + 32U + 3U + 2U);
+  EXPECT_TRUE(words[5]);
+  EXPECT_FALSE(words[1]);
+  EXPECT_TRUE(words[64]);
+  EXPECT_TRUE(words[69]);
+  EXPECT_THROW(words.append(~0ULL, 65), std::invalid_argument);
+  EXPECT_EQ(words.size(), 70U);
+
+  const std::size_t n = 10000;
+  s21::dynamic_bitset evens(n), threes(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    evens[i] = i % 2 == 0;
+    threes[i] = i % 3 == 0;
+  }
+  for (auto level : {s21::simd::isa::scalar, s21::simd::isa::sse2,
+                     s21::simd::isa::avx2, s21::simd::isa::avx512}) {
+    s21::simd::set_isa(level);
+    EXPECT_EQ((evens & threes).count(), 1667U);
+    EXPECT_EQ((evens | threes).count(), 6667U);
+    EXPECT_EQ((evens ^ threes).count(), 5000U);
+    s21::dynamic_bitset odd_multiples = threes;
+    odd_multiples.and_not(evens);
+    EXPECT_EQ(odd_multiples.count(), 1667U);
+    EXPECT_EQ(odd_multiples.find_first(), 3U);
+    EXPECT_EQ(odd_multiples.find_next(3), 9U);
+  }
+  s21::simd::set_isa(s21::simd::detected_isa());
+  s21::dynamic_bitset copy = evens;
+  EXPECT_EQ(copy, evens);
+  copy[1] = true;
+  EXPECT_NE(copy, evens);
+  EXPECT_THROW(evens &= a, std::invalid_argument);
+  copy.swap(a);
+  EXPECT_EQ(copy.size(), 70U);
+  a.clear();
+  EXPECT_TRUE(a.empty());
+}
+
+namespace {
+// Tracks the bytes it has handed out and not yet taken back.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  long live() const { return live_; }
+
+ private:
+  void *do_allocate(std::size_t bytes, std::size_t align) override {
+    live_ += static_cast<long>(bytes);
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+  void do_deallocate(void *p, std::size_t bytes, std::size_t align) override {
+    live_ -= static_cast<long>(bytes);
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  long live_ = 0;
+};
+}  // namespace
+
+TEST(deque, PushPopBothEnds) {
+  s21::deque<int> d;
+  EXPECT_TRUE(d.empty());
+  for (int i = 0; i < 5000; ++i) {
+    d.push_back(i);
+    d.push_front(-i - 1);
+  }
+  ASSERT_EQ(d.size(), 10000U);
+  EXPECT_EQ(d.front(), -5000);
+  EXPECT_EQ(d.back(), 4999);
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_EQ(d[i], i - 5000);
+  }
+  EXPECT_EQ(d.at(5000), 0);
+  EXPECT_THROW(d.at(10000), std::out_of_range);
+  EXPECT_EQ(std::accumulate(d.begin(), d.end(), 0), -5000);
+  auto it = d.begin() + 100;
+  EXPECT_EQ(*it, -4900);
+  EXPECT_EQ(it[1], -4899);
+  EXPECT_EQ(d.end() - it, 9900);
+  for (int i = 0; i < 4000; ++i) {
+    d.pop_front();
+    d.pop_back();
+  }
+  ASSERT_EQ(d.size(), 2000U);
+  EXPECT_EQ(d.front(), -1000);
+  EXPECT_EQ(d.back(), 999);
+  d.clear();
+  EXPECT_TRUE(d.empty());
+  d.push_front(7);
+  EXPECT_EQ(d.back(), 7);
+}
+
+TEST(deque, ReferencesStayValid) {
+  s21::deque<std::string> d{"middle"};
+  std::string *middle = &d.front();
+  s21::vector<const std::string *> addresses;
+  for (int i = 0; i < 3000; ++i) {
+    d.emplace_back(std::to_string(i));
+    addresses.push_back(&d.back());
+    d.push_front(d.back());
+  }
+  EXPECT_EQ(&d[3000], middle);
+  EXPECT_EQ(*middle, "middle");
+  for (int i = 0; i < 3000; ++i) {
+    ASSERT_EQ(addresses[i], &d[3001 + i]);
+    ASSERT_EQ(d[2999 - i], std::to_string(i));
+  }
+}
+
+TEST(deque, QueueWorkloadReusesBlocks) {
+  s21::deque<std::int64_t> d;
+  std::int64_t next = 0, expected = 0;
+  for (int round = 0; round < 200000; ++round) {
+    d.push_back(next++);
+    if (d.size() > 1000) {
+      ASSERT_EQ(d.front(), expected++);
+      d.pop_front();
+    }
+  }
+  EXPECT_EQ(d.size(), 1000U);
+  EXPECT_EQ(d.back(), 199999);
+  d.shrink_to_fit();
+  EXPECT_EQ(d.front(), 199000);
+
+  s21::deque<std::int64_t> copy(d);
+  EXPECT_EQ(copy.size(), 1000U);
+  EXPECT_EQ(copy[999], 199999);
+  s21::deque<std::int64_t> moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  copy = moved;
+  EXPECT_EQ(copy.front(), 199000);
+  const s21::deque<std::int64_t> &cd = copy;
+  EXPECT_EQ(*cd.begin(), 199000);
+  EXPECT_EQ(cd.at(1), 199001);
+  s21::deque<std::int64_t> sized(3);
+  EXPECT_EQ(sized[2], 0);
+}
+
+TEST(deque, AssignmentKeepsItsOwnResource) {
+  CountingResource a, b, fallback;
+  std::pmr::memory_resource *old = std::pmr::set_default_resource(&fallback);
+  {
+    using Alloc = std::pmr::polymorphic_allocator<int>;
+    s21::deque<int, Alloc> source{Alloc(&b)};
+    for (int i = 0; i < 1000; ++i) {
+      source.push_back(i);
+    }
+    s21::deque<int, Alloc> target{Alloc(&a)};
+    target.push_back(-1);
+    long source_bytes = b.live();
+    target = source;
+    EXPECT_EQ(target.get_allocator().resource(), &a);
+    EXPECT_EQ(target[999], 999);
+    EXPECT_EQ(b.live(), source_bytes);
+    EXPECT_GT(a.live(), 0);
+    target = std::move(source);
+    EXPECT_EQ(target.size(), 1000U);
+    EXPECT_EQ(target.back(), 999);
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ(b.live(), source_bytes);
+  }
+  std::pmr::set_default_resource(old);
+  EXPECT_EQ(a.live(), 0);
+  EXPECT_EQ(b.live(), 0);
+  EXPECT_EQ(fallback.live(), 0);
+}
+
+TEST(adapters, StackOverContainers) {
+  s21::stack<int> on_vector;
+  static_assert(std::is_same_v<decltype(on_vector)::container_type,
+                               s21::vector<int>>);
+  on_vector.reserve(100);
+  for (int i = 0; i < 100; ++i) {
+    on_vector.push(i);
+  }
+  on_vector.top() += 1000;
+  EXPECT_EQ(on_vector.top(), 1099);
+  EXPECT_EQ(on_vector.size(), 100U);
+
+  s21::stack<std::string, s21::list<std::string>> on_list;
+  std::string moved_from = "moved";
+  on_list.push(std::move(moved_from));
+  EXPECT_EQ(on_list.emplace(3, 'x'), "xxx");
+  on_list.pop();
+  const auto &const_list = on_list;
+  EXPECT_EQ(const_list.top(), "moved");
+
+  s21::stack<int, s21::deque<int>> on_deque(s21::deque<int>{1, 2, 3});
+  EXPECT_EQ(on_deque.top(), 3);
+  on_deque.pop();
+  EXPECT_EQ(on_deque.top(), 2);
+}
+
+TEST(adapters, QueueOverContainers) {
+  s21::queue<int> on_deque;
+  static_assert(std::is_same_v<decltype(on_deque)::container_type,
+                               s21::deque<int>>);
+  for (int i = 0; i < 10000; ++i) {
+    on_deque.push(i);
+    if (i % 2 == 1) {
+      on_deque.pop();
+    }
+  }
+  EXPECT_EQ(on_deque.size(), 5000U);
+  EXPECT_EQ(on_deque.front(), 5000);
+  EXPECT_EQ(on_deque.back(), 9999);
+  on_deque.front() = -1;
+  const auto &const_deque = on_deque;
+  EXPECT_EQ(const_deque.front(), -1);
+
+  s21::queue<std::string, s21::list<std::string>> on_list;
+  EXPECT_EQ(on_list.emplace(2, 'y'), "yy");
+  on_list.push(std::string("z"));
+  on_list.pop();
+  EXPECT_EQ(on_list.front(), "z");
+  EXPECT_EQ(on_list.size(), 1U);
+}
+
+TEST(ring_buffer, GrowAndWrap) {
+  s21::ring_buffer<int> ring;
+  EXPECT_EQ(ring.capacity(), 0U);
+  for (int i = 0; i < 10; ++i) {
+    ring.push_back(i);
+  }
+  EXPECT_EQ(ring.capacity(), 16U);
+  for (int i = 0; i < 8; ++i) {
+    ring.pop_front();
+  }
+  for (int i = 10; i < 24; ++i) {
+    ring.emplace_back(i);
+  }
+  EXPECT_EQ(ring.capacity(), 16U);
+  EXPECT_TRUE(ring.full());
+  EXPECT_EQ(ring.front(), 8);
+  EXPECT_EQ(ring.back(), 23);
+  EXPECT_EQ(ring[15], 23);
+  ring.push_back(ring.front());
+  EXPECT_EQ(ring.capacity(), 32U);
+  EXPECT_EQ(ring.back(), 8);
+  for (int i = 0; i < 16; ++i) {
+    ASSERT_EQ(ring.at(i), 8 + i);
+  }
+  EXPECT_THROW(ring.at(17), std::out_of_range);
+  EXPECT_EQ(std::accumulate(ring.begin(), ring.end(), 0),
+            (8 + 23) * 16 / 2 + 8);
+
+  s21::ring_buffer<int> sized(100);
+  EXPECT_EQ(sized.capacity(), 128U);
+  EXPECT_TRUE(sized.empty());
+  sized.reserve(129);
+  EXPECT_EQ(sized.capacity(), 256U);
+}
+
+TEST(ring_buffer, BulkPushPop) {
+  s21::ring_buffer<std::string> ring(8);
+  std::string batch[6] = {"a", "b", "c", "d", "e", "f"};
+  ring.push(batch, 6);
+  std::string out[8];
+  EXPECT_EQ(ring.pop(out, 4), 4U);
+  EXPECT_EQ(out[3], "d");
+  ring.push(batch, 6);
+  EXPECT_EQ(ring.size(), 8U);
+  EXPECT_EQ(ring.capacity(), 8U);
+  EXPECT_EQ(ring.front(), "e");
+  EXPECT_EQ(ring.back(), "f");
+  EXPECT_EQ(ring.pop(out, 100), 8U);
+  EXPECT_EQ(out[0], "e");
+  EXPECT_EQ(out[2], "a");
+  EXPECT_EQ(out[7], "f");
+  EXPECT_TRUE(ring.empty());
+
+  s21::vector<std::string> more(20);
+  ring.push(more);
+  EXPECT_EQ(ring.size(), 20U);
+  EXPECT_EQ(ring.capacity(), 32U);
+  s21::ring_buffer<std::string> copy(ring);
+  EXPECT_EQ(copy.size(), 20U);
+  s21::ring_buffer<std::string> moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.size(), 20U);
+  s21::ring_buffer<int> listed{1, 2, 3};
+  EXPECT_EQ(listed.back(), 3);
+}
+
+TEST(ring_buffer, BulkPathsUseAllocator) {
+  std::pmr::monotonic_buffer_resource arena;
+  using Alloc = std::pmr::polymorphic_allocator<std::pmr::string>;
+  s21::ring_buffer<std::pmr::string, Alloc> ring(4, decltype(ring)::mode::grow,
+                                                 Alloc(&arena));
+  std::pmr::string batch[3] = {"a long string that does not fit inline",
+                               "b", "c"};
+  ring.push(batch, 3);
+  ring.push(batch, 3);
+  ASSERT_EQ(ring.size(), 6U);
+  for (const std::pmr::string &value : ring) {
+    EXPECT_EQ(value.get_allocator().resource(), &arena);
+  }
+  std::pmr::string out[6];
+  EXPECT_EQ(ring.pop(out, 6), 6U);
+  EXPECT_EQ(out[3], batch[0]);
+}
+
+TEST(ring_buffer, AssignmentKeepsItsOwnResource) {
+  CountingResource a, b, fallback;
+  std::pmr::memory_resource *old = std::pmr::set_default_resource(&fallback);
+  {
+    using Alloc = std::pmr::polymorphic_allocator<int>;
+    using Ring = s21::ring_buffer<int, Alloc>;
+    Ring source(1000, Ring::mode::overwrite, Alloc(&b));
+    for (int i = 0; i < 1000; ++i) {
+      source.push_back(i);
+    }
+    Ring target(1, Ring::mode::grow, Alloc(&a));
+    long source_bytes = b.live();
+    target = source;
+    EXPECT_EQ(target.get_allocator().resource(), &a);
+    EXPECT_EQ(target.overflow_mode(), Ring::mode::overwrite);
+    EXPECT_EQ(target.capacity(), source.capacity());
+    EXPECT_EQ(target[999], 999);
+    EXPECT_EQ(b.live(), source_bytes);
+    EXPECT_GT(a.live(), 0);
+    target = std::move(source);
+    EXPECT_EQ(target.size(), 1000U);
+    EXPECT_EQ(target.back(), 999);
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ(b.live(), source_bytes);
+  }
+  std::pmr::set_default_resource(old);
+  EXPECT_EQ(a.live(), 0);
+  EXPECT_EQ(b.live(), 0);
+  EXPECT_EQ(fallback.live(), 0);
+}
+
+TEST(ring_buffer, OverwriteOldest) {
+  using Ring = s21::ring_buffer<int>;
+  Ring latest(4, Ring::mode::overwrite);
+  EXPECT_EQ(latest.overflow_mode(), Ring::mode::overwrite);
+  for (int i = 0; i < 10; ++i) {
+    latest.push_back(i);
+  }
+  EXPECT_EQ(latest.capacity(), 4U);
+  EXPECT_EQ(latest.size(), 4U);
+  EXPECT_EQ(latest.front(), 6);
+  EXPECT_EQ(latest.back(), 9);
+  latest.push_back(latest.front());
+  EXPECT_EQ(latest.back(), 6);
+  EXPECT_EQ(latest.front(), 7);
+
+  int samples[7] = {10, 11, 12, 13, 14, 15, 16};
+  latest.push(samples, 2);
+  EXPECT_EQ(latest.front(), 9);
+  latest.push(samples, 7);
+  EXPECT_EQ(latest.front(), 13);
+  EXPECT_EQ(latest.back(), 16);
+  Ring copy = latest;
+  copy.push_back(17);
+  EXPECT_EQ(copy.front(), 14);
+  EXPECT_EQ(latest.front(), 13);
+}
+
+TEST(ring_buffer, BacksQueue) {
+  s21::queue<int, s21::ring_buffer<int>> q;
+  q.reserve(64);
+  for (int i = 0; i < 1000; ++i) {
+    q.push(i);
+    if (i % 4 != 0) {
+      q.pop();
+    }
+  }
+  EXPECT_EQ(q.size(), 250U);
+  EXPECT_EQ(q.front(), 750);
+  EXPECT_EQ(q.back(), 999);
+}
+
+TEST(spsc_queue, SingleThreaded) {
+  s21::spsc_queue<std::string> q(3);
+  EXPECT_EQ(q.capacity(), 4U);
+  EXPECT_TRUE(q.empty());
+  EXPECT_EQ(q.front(), nullptr);
+  std::string out;
+  EXPECT_FALSE(q.try_pop(out));
+  std::string kept = "kept";
+  EXPECT_TRUE(q.try_push(std::string("a")));
+  EXPECT_TRUE(q.try_emplace(2, 'b'));
+  EXPECT_TRUE(q.try_push(kept));
+  EXPECT_TRUE(q.try_push("d"));
+  EXPECT_FALSE(q.try_push(std::move(kept)));
+  EXPECT_EQ(kept, "kept");
+  EXPECT_EQ(q.size(), 4U);
+  ASSERT_TRUE(q.try_pop(out));
+  EXPECT_EQ(out, "a");
+  EXPECT_EQ(*q.front(), "bb");
+  q.pop();
+
+  std::string batch[3] = {"x", "y", "z"};
+  EXPECT_EQ(q.try_push(batch, 3), 2U);
+  std::string popped[8];
+  EXPECT_EQ(q.try_pop(popped, 8), 4U);
+  EXPECT_EQ(popped[0], "kept");
+  EXPECT_EQ(popped[3], "y");
+  EXPECT_TRUE(q.empty());
+  EXPECT_TRUE(q.try_push("left for the destructor"));
+}
+
+// Move assignment throws for the value armed, once.
+struct ThrowOnMoveAssign {
+  static inline int armed = -1;
+
+  ThrowOnMoveAssign() = default;
+  explicit ThrowOnMoveAssign(int v) : value(v), text(std::to_string(v)) {}
+  ThrowOnMoveAssign(const ThrowOnMoveAssign &) = default;
+  ThrowOnMoveAssign &operator=(ThrowOnMoveAssign &&other) {
+    if (other.value == armed) {
+      armed = -1;
+      throw std::runtime_error("move");
+    }
+    value = other.value;
+    text = std::move(other.text);
+    return *this;
+  }
+
+  int value = -1;
+  std::string text;
+};
+
+TEST(spsc_queue, ThrowingBulkPopKeepsTheRest) {
+  s21::spsc_queue<ThrowOnMoveAssign> q(8);
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_TRUE(q.try_emplace(i));
+  }
+  ThrowOnMoveAssign out[6];
+  ThrowOnMoveAssign::armed = 3;
+  EXPECT_THROW(q.try_pop(out, 6), std::runtime_error);
+  EXPECT_EQ(out[2].text, "2");
+  EXPECT_EQ(q.size(), 3U);
+  EXPECT_EQ(q.try_pop(out, 6), 3U);
+  EXPECT_EQ(out[0].text, "3");
+  EXPECT_EQ(out[2].text, "5");
+  EXPECT_TRUE(q.try_emplace(6));
+}
+
+TEST(spsc_queue, TwoThreadsKeepOrder) {
+  constexpr int kCount = 200000;
+  s21::spsc_queue<int> q(64);
+  std::thread producer([&] {
+    int batch[7];
+    int next = 0;
+    while (next < kCount) {
+      if (next % 3 == 0) {
+        int n = std::min(7, kCount - next);
+        for (int i = 0; i < n; ++i) {
+          batch[i] = next + i;
+        }
+        std::size_t pushed = q.try_push(batch, n);
+        next += static_cast<int>(pushed);
+        if (pushed == 0) {
+          std::this_thread::yield();
+        }
+      } else if (q.try_push(next)) {
+        ++next;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+  int expected = 0;
+  bool ordered = true;
+  int out[5];
+  while (expected < kCount) {
+    if (expected % 2 == 0) {
+      std::size_t n = q.try_pop(out, 5);
+      for (std::size_t i = 0; i < n; ++i) {
+        ordered = ordered && out[i] == expected++;
+      }
+      if (n == 0) {
+        std::this_thread::yield();
+      }
+    } else if (q.try_pop(out[0])) {
+      ordered = ordered && out[0] == expected++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(mpmc_queue, SingleThreaded) {
+  s21::mpmc_queue<std::string> q(3);
+  EXPECT_EQ(q.capacity(), 4U);
+  EXPECT_TRUE(q.empty());
+  std::string out;
+  EXPECT_FALSE(q.try_pop(out));
+  std::string kept = "kept";
+  EXPECT_TRUE(q.try_push(std::string("a")));
+  EXPECT_TRUE(q.try_emplace(2, 'b'));
+  q.push(kept);
+  q.emplace("d");
+  EXPECT_FALSE(q.try_push(std::move(kept)));
+  EXPECT_EQ(kept, "kept");
+  EXPECT_EQ(q.size(), 4U);
+  q.pop(out);
+  EXPECT_EQ(out, "a");
+  ASSERT_TRUE(q.try_pop(out));
+  EXPECT_EQ(out, "bb");
+
+  std::string batch[3] = {"x", "y", "z"};
+  EXPECT_EQ(q.try_push(batch, 3), 2U);
+  EXPECT_EQ(q.try_push(batch, 3), 0U);
+  std::string popped[8];
+  EXPECT_EQ(q.try_pop(popped, 8), 4U);
+  EXPECT_EQ(popped[0], "kept");
+  EXPECT_EQ(popped[3], "y");
+  EXPECT_EQ(q.try_pop(popped, 8), 0U);
+  EXPECT_TRUE(q.empty());
+  EXPECT_TRUE(q.try_push("left for the destructor"));
+}
+
+// Constructing from a negative value throws; moves never do.
+struct NonNegative {
+  explicit NonNegative(int v = 0) : value(v) {
+    if (v < 0) {
+      throw std::invalid_argument("negative");
+    }
+  }
+
+  int value;
+};
+
+TEST(mpmc_queue, ThrowingEmplaceClaimsNoSlot) {
+  s21::mpmc_queue<NonNegative> q(2);
+  EXPECT_THROW(q.try_emplace(-1), std::invalid_argument);
+  EXPECT_THROW(q.emplace(-2), std::invalid_argument);
+  EXPECT_TRUE(q.empty());
+  EXPECT_TRUE(q.try_emplace(1));
+  q.emplace(2);
+  NonNegative out;
+  q.pop(out);
+  EXPECT_EQ(out.value, 1);
+  ASSERT_TRUE(q.try_pop(out));
+  EXPECT_EQ(out.value, 2);
+  EXPECT_FALSE(q.try_pop(out));
+}
+
+// Copying a negative value throws; moves never do.
+struct FragileCopy {
+  explicit FragileCopy(int v = 0) : value(v) {}
+  FragileCopy(const FragileCopy &other) : value(other.value) {
+    if (value < 0) {
+      throw std::invalid_argument("negative");
+    }
+  }
+  FragileCopy(FragileCopy &&) noexcept = default;
+  FragileCopy &operator=(FragileCopy &&) noexcept = default;
+
+  int value;
+};
+
+TEST(mpmc_queue, ThrowingBulkCopyClaimsNoSlot) {
+  s21::mpmc_queue<FragileCopy> q(4);
+  FragileCopy batch[3] = {FragileCopy(1), FragileCopy(-1), FragileCopy(3)};
+  EXPECT_THROW(q.try_push(batch, 3), std::invalid_argument);
+  EXPECT_EQ(q.size(), 1U);
+  EXPECT_EQ(q.try_push(batch + 2, 1), 1U);
+  FragileCopy out[4];
+  ASSERT_EQ(q.try_pop(out, 4), 2U);
+  EXPECT_EQ(out[0].value, 1);
+  EXPECT_EQ(out[1].value, 3);
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(mpmc_queue, ManyProducersManyConsumers) {
+  constexpr int kProducers = 4;
+  constexpr int kConsumers = 3;
+  constexpr int kPerProducer = 20000;
+  s21::mpmc_queue<int> q(16);
+  std::atomic<long long> sum{0};
+  std::atomic<int> received{0};
+  std::atomic<bool> ordered{true};
+  std::vector<std::thread> threads;
+  for (int p = 0; p < kProducers; ++p) {
+    threads.emplace_back([&, p] {
+      int batch[5];
+      int next = 0;
+      while (next < kPerProducer) {
+        if (next % 4 == 0) {
+          int n = std::min(5, kPerProducer - next);
+          for (int i = 0; i < n; ++i) {
+            batch[i] = p * kPerProducer + next + i;
+          }
+          std::size_t pushed = q.try_push(batch, n);
+          next += static_cast<int>(pushed);
+          if (pushed == 0) {
+            std::this_thread::yield();
+          }
+        } else {
+          q.push(p * kPerProducer + next++);
+        }
+      }
+    });
+  }
+  for (int c = 0; c < kConsumers; ++c) {
+    threads.emplace_back([&] {
+      // Values of one producer must reach any one consumer in order.
+      std::vector<int> last(kProducers, -1);
+      int out[6];
+      while (received.load() < kProducers * kPerProducer) {
+        std::size_t n = q.try_pop(out, 6);
+        if (n == 0) {
+          std::this_thread::yield();
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+          int p = out[i] / kPerProducer;
+          if (out[i] <= last[p]) {
+            ordered = false;
+          }
+          last[p] = out[i];
+          sum += out[i];
+        }
+        received += static_cast<int>(n);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  long long total = kProducers * kPerProducer;
+  EXPECT_EQ(received.load(), total);
+  EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(mpmc_queue, BlockingCallsPark) {
+  constexpr int kCount = 2000;
+  s21::mpmc_queue<int> q(2);
+  long long sum = 0;
+  std::thread consumer([&] {
+    for (int i = 0; i < kCount; ++i) {
+      int value = 0;
+      q.pop(value);
+      sum += value;
+    }
+  });
+  std::thread producer([&] {
+    for (int i = 0; i < kCount; ++i) {
+      q.push(i);
+    }
+  });
+  producer.join();
+  consumer.join();
+  EXPECT_EQ(sum, static_cast<long long>(kCount) * (kCount - 1) / 2);
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(concurrent_queue, SingleThreaded) {
+  s21::concurrent_queue<std::string> q;
+  EXPECT_TRUE(q.empty());
+  std::string out;
+  EXPECT_FALSE(q.try_pop(out));
+  EXPECT_FALSE(q.wait_pop_for(out, std::chrono::milliseconds(1)));
+  std::string kept = "c";
+  EXPECT_TRUE(q.push(std::string("a")));
+  EXPECT_TRUE(q.emplace(2, 'b'));
+  EXPECT_TRUE(q.push(kept));
+  EXPECT_TRUE(q.push("d"));
+  EXPECT_EQ(q.size(), 4U);
+  ASSERT_TRUE(q.wait_pop(out));
+  EXPECT_EQ(out, "a");
+  ASSERT_TRUE(q.wait_pop_for(out, std::chrono::seconds(1)));
+  EXPECT_EQ(out, "bb");
+  std::string batch[8];
+  EXPECT_EQ(q.pop_batch(batch, 0), 0U);
+  EXPECT_EQ(q.pop_batch(batch, 8), 2U);
+  EXPECT_EQ(batch[0], "c");
+  EXPECT_EQ(batch[1], "d");
+
+  EXPECT_TRUE(q.push("e"));
+  q.close();
+  EXPECT_TRUE(q.closed());
+  EXPECT_FALSE(q.push("refused"));
+  EXPECT_EQ(q.size(), 1U);
+  ASSERT_TRUE(q.wait_pop(out));
+  EXPECT_EQ(out, "e");
+  EXPECT_FALSE(q.wait_pop(out));
+  EXPECT_FALSE(q.wait_pop_for(out, std::chrono::seconds(1)));
+  EXPECT_EQ(q.pop_batch(batch, 8), 0U);
+}
+
+TEST(concurrent_queue, CloseReleasesConsumers) {
+  constexpr int kProducers = 4;
+  constexpr int kPerProducer = 5000;
+  s21::concurrent_queue<int> q;
+  std::atomic<long long> sum{0};
+  std::atomic<int> received{0};
+  s21::vector<std::thread> consumers;
+  for (int c = 0; c < 3; ++c) {
+    consumers.push_back(std::thread([&, c] {
+      int batch[16];
+      int value = 0;
+      if (c == 0) {
+        while (q.wait_pop(value)) {
+          sum += value;
+          ++received;
+        }
+        return;
+      }
+      while (std::size_t n = q.pop_batch(batch, 16)) {
+        for (std::size_t i = 0; i < n; ++i) {
+          sum += batch[i];
+        }
+        received += static_cast<int>(n);
+      }
+    }));
+  }
+  s21::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.push_back(std::thread([&, p] {
+      for (int i = 0; i < kPerProducer; ++i) {
+        q.push(p * kPerProducer + i);
+      }
+    }));
+  }
+  for (std::thread &thread : producers) {
+    thread.join();
+  }
+  q.close();
+  for (std::thread &thread : consumers) {
+    thread.join();
+  }
+  long long total = kProducers * kPerProducer;
+  EXPECT_EQ(received.load(), total);
+  EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+}
+
+TEST(priority_queue, BinaryHeapMatchesSortedOrder) {
+  s21::priority_queue<int> q;
+  EXPECT_TRUE(q.empty());
+  std::vector<int> values;
+  for (int i = 0; i < 200; ++i) {
+    values.push_back((i * 7919) % 101);
+  }
+  for (int v : values) {
+    q.push(v);
+  }
+  EXPECT_EQ(q.size(), values.size());
+  std::sort(values.rbegin(), values.rend());
+  for (int v : values) {
+    ASSERT_EQ(q.top(), v);
+    q.pop();
+  }
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(priority_queue, FourAryMinHeapAndPushMany) {
+  s21::priority_queue<std::string, s21::vector<std::string>,
+                      std::greater<std::string>, 4>
+      q{"pear", "apple", "fig"};
+  EXPECT_EQ(q.arity, 4U);
+  EXPECT_EQ(q.top(), "apple");
+  std::vector<std::string> more = {"kiwi", "banana", "date", "cherry",
+                                   "grape", "lime", "mango", "plum"};
+  q.push_many(more.begin(), more.end());
+  q.emplace(3, 'a');
+  std::string few[2] = {"zucchini", "aa"};
+  q.push_many(few, few + 2);
+  EXPECT_EQ(q.size(), 14U);
+  std::vector<std::string> order;
+  while (!q.empty()) {
+    order.push_back(q.top());
+    q.pop();
+  }
+  EXPECT_TRUE(std::is_sorted(order.begin(), order.end()));
+  EXPECT_EQ(order.front(), "aa");
+  EXPECT_EQ(order.back(), "zucchini");
+
+  s21::vector<int> raw{3, 9, 1, 7, 5};
+  s21::priority_queue<int, s21::vector<int>, std::less<int>, 3> heap(
+      std::less<int>(), std::move(raw));
+  heap.reserve(16);
+  EXPECT_EQ(heap.top(), 9);
+  heap.pop();
+  EXPECT_EQ(heap.top(), 7);
+}
+
+TEST(indexed_heap, DecreaseKeyUpdateErase) {
+  s21::indexed_heap<int, std::greater<int>> heap;
+  s21::vector<std::size_t> h;
+  for (int v : {50, 40, 30, 20, 10, 60}) {
+    h.push_back(heap.push(v));
+  }
+  EXPECT_EQ(heap.top(), 10);
+  EXPECT_EQ(heap.top_handle(), h[4]);
+  heap.decrease_key(h[0], 5);
+  EXPECT_EQ(heap.top(), 5);
+  EXPECT_EQ(heap[h[0]], 5);
+  EXPECT_THROW(heap.decrease_key(h[1], 45), std::invalid_argument);
+  heap.update(h[0], 55);
+  EXPECT_EQ(heap.top(), 10);
+  heap.erase(h[4]);
+  EXPECT_FALSE(heap.contains(h[4]));
+  EXPECT_THROW(heap.at(h[4]), std::out_of_range);
+  EXPECT_THROW(heap.erase(h[4]), std::out_of_range);
+  EXPECT_EQ(heap.top(), 20);
+  std::size_t reused = heap.push(1);
+  EXPECT_EQ(reused, h[4]);
+  EXPECT_EQ(heap.top_handle(), reused);
+  std::vector<int> order;
+  while (!heap.empty()) {
+    order.push_back(heap.top());
+    heap.pop();
+  }
+  EXPECT_EQ(order, (std::vector<int>{1, 20, 30, 40, 55, 60}));
+}
+
+TEST(indexed_heap, ThrowingEmplaceTakesNoHandle) {
+  struct ByValue {
+    bool operator()(const NonNegative &a, const NonNegative &b) const {
+      return a.value < b.value;
+    }
+  };
+  s21::indexed_heap<NonNegative, ByValue> heap;
+  std::size_t first = heap.emplace(1);
+  std::size_t second = heap.emplace(2);
+  heap.erase(second);
+  EXPECT_THROW(heap.emplace(-1), std::invalid_argument);
+  EXPECT_FALSE(heap.contains(second));
+  EXPECT_EQ(heap.size(), 1U);
+  EXPECT_THROW(heap.emplace(-1), std::invalid_argument);
+  std::size_t third = heap.emplace(3);
+  EXPECT_EQ(third, second);
+  EXPECT_FALSE(heap.contains(third + 1));
+  heap.erase(first);
+  EXPECT_EQ(heap.top().value, 3);
+  EXPECT_EQ(heap.size(), 1U);
+}
+
+TEST(indexed_heap, RandomOperationsKeepHandlesConsistent) {
+  s21::indexed_heap<int, std::less<int>, 4> heap;
+  std::map<std::size_t, int> model;
+  unsigned state = 12345;
+  auto next = [&state] {
+    state = state * 1103515245 + 12345;
+    return static_cast<int>((state >> 8) % 1000);
+  };
+  for (int step = 0; step < 3000; ++step) {
+    int op = next() % 4;
+    if (op < 2 || model.empty()) {
+      int v = next();
+      model[heap.push(v)] = v;
+    } else {
+      auto it = model.begin();
+      std::advance(it, next() % model.size());
+      if (op == 2) {
+        int v = next();
+        heap.update(it->first, v);
+        it->second = v;
+      } else {
+        heap.erase(it->first);
+        model.erase(it);
+      }
+    }
+    ASSERT_EQ(heap.size(), model.size());
+    if (!model.empty()) {
+      int best = 0;
+      for (const auto &[handle, value] : model) {
+        best = std::max(best, value);
+        ASSERT_EQ(heap[handle], value);
+      }
+      ASSERT_EQ(heap.top(), best);
+    }
+  }
+}
+
+TEST(ws_deque, OwnerLifoThiefFifoAndGrowth) {
+  s21::ws_deque<int> d(2);
+  EXPECT_EQ(d.capacity(), 2U);
+  int out = 0;
+  EXPECT_FALSE(d.pop(out));
+  EXPECT_FALSE(d.steal(out));
+  for (int i = 0; i < 10; ++i) {
+    d.push(i);
+  }
+  EXPECT_EQ(d.size(), 10U);
+  EXPECT_GE(d.capacity(), 10U);
+  ASSERT_TRUE(d.pop(out));
+  EXPECT_EQ(out, 9);
+  ASSERT_TRUE(d.steal(out));
+  EXPECT_EQ(out, 0);
+  ASSERT_TRUE(d.steal(out));
+  EXPECT_EQ(out, 1);
+  for (int expected = 8; expected >= 2; --expected) {
+    ASSERT_TRUE(d.pop(out));
+    EXPECT_EQ(out, expected);
+  }
+  EXPECT_TRUE(d.empty());
+  EXPECT_FALSE(d.pop(out));
+}
+
+TEST(ws_deque, EveryElementTakenOnce) {
+  constexpr int kCount = 20000;
+  s21::ws_deque<int> d(4);
+  std::vector<std::atomic<int>> taken(kCount);
+  std::atomic<bool> done{false};
+  std::atomic<int> total{0};
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < 3; ++t) {
+    thieves.emplace_back([&] {
+      int value = 0;
+      while (!done.load() || !d.empty()) {
+        if (d.steal(value)) {
+          ++taken[value];
+          ++total;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  int value = 0;
+  for (int i = 0; i < kCount; ++i) {
+    d.push(i);
+    if (i % 3 == 0 && d.pop(value)) {
+      ++taken[value];
+      ++total;
+    }
+  }
+  while (d.pop(value)) {
+    ++taken[value];
+    ++total;
+  }
+  done = true;
+  for (std::thread &thread : thieves) {
+    thread.join();
+  }
+  EXPECT_EQ(total.load(), kCount);
+  for (int i = 0; i < kCount; ++i) {
+    ASSERT_EQ(taken[i].load(), 1) << i;
+  }
+}
+
+namespace {
+long ForkJoinFib(s21::task_pool &pool, int n) {
+  if (n < 12) {
+    return n < 2 ? n : ForkJoinFib(pool, n - 1) + ForkJoinFib(pool, n - 2);
+  }
+  s21::task_pool::group g;
+  long left = 0;
+  pool.spawn(g, [&] { left = ForkJoinFib(pool, n - 1); });
+  long right = ForkJoinFib(pool, n - 2);
+  pool.wait(g);
+  return left + right;
+}
+}  // namespace
+
+TEST(task_pool, SpawnWaitAndNestedForkJoin) {
+  s21::task_pool pool(3);
+  EXPECT_EQ(pool.size(), 3U);
+  std::atomic<int> ran{0};
+  for (int i = 0; i < 100; ++i) {
+    pool.spawn([&] { ++ran; });
+  }
+  pool.wait();
+  EXPECT_EQ(ran.load(), 100);
+  EXPECT_EQ(ForkJoinFib(pool, 22), 17711);
+  long result = 0;
+  s21::task_pool::group g;
+  pool.spawn(g, [&] { result = ForkJoinFib(pool, 20); });
+  pool.wait(g);
+  EXPECT_EQ(result, 6765);
+}
+
+TEST(task_pool, ParallelForAndExceptions) {
+  s21::task_pool pool(4);
+  s21::vector<long> v(100000);
+  pool.parallel_for(0, v.size(), 1000, [&](std::size_t b, std::size_t e) {
+    for (std::size_t i = b; i < e; ++i) {
+      v[i] = static_cast<long>(i);
+    }
+  });
+  EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0L), 99999L * 100000 / 2);
+  std::atomic<int> calls{0};
+  pool.parallel_for(5, 5, 10, [&](std::size_t, std::size_t) { ++calls; });
+  EXPECT_EQ(calls.load(), 0);
+  EXPECT_THROW(pool.parallel_for(0, 1000, 10,
+                                 [](std::size_t b, std::size_t) {
+                                   if (b >= 500) {
+                                     throw std::runtime_error("chunk");
+                                   }
+                                 }),
+               std::runtime_error);
+  pool.spawn([] { throw std::logic_error("task"); });
+  EXPECT_THROW(pool.wait(), std::logic_error);
+  pool.wait();
+  {
+    s21::task_pool unwaited(2);
+    unwaited.spawn([] { throw std::runtime_error("dropped"); });
+  }
+
+  std::atomic<long> sum{0};
+  s21::default_task_pool().parallel_for(
+      0, 1000, 64, [&](std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) {
+          sum += static_cast<long>(i);
+        }
+      });
+  EXPECT_EQ(sum.load(), 999L * 1000 / 2);
+}
+
+TEST(concurrent_stack, SingleThreaded) {
+  s21::concurrent_stack<std::string> s;
+  EXPECT_TRUE(s.empty());
+  std::string out;
+  EXPECT_FALSE(s.try_pop(out));
+  std::string kept = "c";
+  s.push(std::string("a"));
+  s.emplace(2, 'b');
+  s.push(kept);
+  EXPECT_EQ(kept, "c");
+  ASSERT_TRUE(s.try_pop(out));
+  EXPECT_EQ(out, "c");
+  s.push("d");
+  s21::vector<std::string> all = s.pop_all();
+  ASSERT_EQ(all.size(), 3U);
+  EXPECT_EQ(all[0], "d");
+  EXPECT_EQ(all[1], "bb");
+  EXPECT_EQ(all[2], "a");
+  EXPECT_TRUE(s.empty());
+  EXPECT_TRUE(s.pop_all().empty());
+  s.push("left for the destructor");
+}
+
+TEST(concurrent_stack, ContendedPushPopLosesNothing) {
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 20000;
+  s21::concurrent_stack<int> s;
+  std::vector<std::atomic<int>> seen(kThreads * kPerThread);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      int value = 0;
+      for (int i = 0; i < kPerThread; ++i) {
+        s.push(t * kPerThread + i);
+        if (i % 2 == 1 && s.try_pop(value)) {
+          ++seen[value];
+        }
+        if (i % 1000 == 999) {
+          for (int v : s.pop_all()) {
+            ++seen[v];
+          }
+        }
+        if (i % 64 == 0) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  int value = 0;
+  while (s.try_pop(value)) {
+    ++seen[value];
+  }
+  for (int i = 0; i < kThreads * kPerThread; ++i) {
+    ASSERT_EQ(seen[i].load(), 1) << i;
+  }
+}
+
+namespace {
+struct EpochNode {
+  static inline std::atomic<int> live{0};
+
+  explicit EpochNode(int v) : value(v), check(~v) { ++live; }
+  ~EpochNode() {
+    check = 0;
+    --live;
+  }
+
+  int value;
+  int check;
+};
+
+// Epochs advance only one step per collect, so a few passes are needed.
+void CollectUntilFreed() {
+  for (int i = 0; i < 8 && EpochNode::live.load() != 0; ++i) {
+    s21::epoch::collect();
+  }
+}
+}  // namespace
+
+TEST(epoch, GuardHoldsBackReclamation) {
+  {
+    s21::epoch::guard outer;
+    {
+      s21::epoch::guard inner;
+      for (int i = 0; i < 10; ++i) {
+        s21::epoch::retire(new EpochNode(i));
+      }
+    }
+    for (int i = 0; i < 4; ++i) {
+      s21::epoch::collect();
+    }
+    EXPECT_EQ(EpochNode::live.load(), 10);
+  }
+  CollectUntilFreed();
+  EXPECT_EQ(EpochNode::live.load(), 0);
+  s21::epoch::retire(static_cast<void*>(new EpochNode(0)), [](void* p) {
+    delete static_cast<EpochNode*>(p);
+  });
+  CollectUntilFreed();
+  EXPECT_EQ(EpochNode::live.load(), 0);
+}
+
+// Readers dereference whatever node is current while writers keep
+// swapping it out and retiring the old one; under test_asan a node freed
+// too early shows up as a use-after-free.
+TEST(epoch, ReadersNeverSeeFreedNodes) {
+  constexpr int kReaders = 3;
+  constexpr int kWriters = 2;
+  constexpr int kSwaps = 20000;
+  std::atomic<EpochNode*> current{new EpochNode(0)};
+  std::atomic<int> writing{kWriters};
+  std::atomic<long> bad{0};
+  std::vector<std::thread> threads;
+  for (int r = 0; r < kReaders; ++r) {
+    threads.emplace_back([&] {
+      for (int i = 0; writing.load() != 0; ++i) {
+        s21::epoch::guard g;
+        EpochNode* node = current.load(std::memory_order_acquire);
+        if (node->check != ~node->value) {
+          ++bad;
+        }
+        if (i % 64 == 0) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (int w = 0; w < kWriters; ++w) {
+    threads.emplace_back([&, w] {
+      for (int i = 1; i <= kSwaps; ++i) {
+        EpochNode* old = current.exchange(new EpochNode(w * kSwaps + i),
+                                          std::memory_order_acq_rel);
+        s21::epoch::retire(old);
+        if (i % 256 == 0) {
+          std::this_thread::yield();
+        }
+      }
+      --writing;
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(bad.load(), 0);
+  s21::epoch::retire(current.load());
+  CollectUntilFreed();
+  EXPECT_EQ(EpochNode::live.load(), 0);
+}
+
+#if defined(__cpp_impl_coroutine)
+namespace {
+s21::task SendRange(s21::channel<int>& ch, int first, int last,
+                    bool close_after) {
+  for (int i = first; i < last; ++i) {
+    if (!co_await ch.send(i)) {
+      co_return;
+    }
+  }
+  if (close_after) {
+    ch.close();
+  }
+}
+
+s21::task ReceiveAll(s21::channel<int>& ch, std::vector<int>& out) {
+  while (std::optional<int> value = co_await ch.receive()) {
+    out.push_back(*value);
+  }
+}
+
+s21::task SendOnce(s21::channel<int>& ch, int value, int& result) {
+  result = (co_await ch.send(value)) ? 1 : 0;
+}
+
+s21::task Throw() {
+  throw std::runtime_error("task failed");
+  co_return;
+}
+}  // namespace
+
+TEST(channel, TryOperationsAndClose) {
+  s21::executor ex;
+  s21::channel<std::string> ch(ex, 2);
+  EXPECT_EQ(ch.capacity(), 2U);
+  std::string kept = "b";
+  EXPECT_TRUE(ch.try_send("a"));
+  EXPECT_TRUE(ch.try_send(kept));
+  std::string rejected = "c";
+  EXPECT_FALSE(ch.try_send(std::move(rejected)));
+  EXPECT_EQ(rejected, "c");
+  EXPECT_EQ(ch.size(), 2U);
+  EXPECT_EQ(ch.try_receive(), "a");
+  ch.close();
+  EXPECT_TRUE(ch.closed());
+  EXPECT_FALSE(ch.try_send("d"));
+  EXPECT_EQ(ch.try_receive(), "b");
+  EXPECT_EQ(ch.try_receive(), std::nullopt);
+
+  s21::channel<int> unbounded(ex);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(unbounded.try_send(i));
+  }
+  unbounded.cancel();
+  EXPECT_TRUE(unbounded.empty());
+  EXPECT_EQ(unbounded.try_receive(), std::nullopt);
+  EXPECT_EQ(ex.run(), 0U);
+}
+
+TEST(channel, BoundedChannelSuspendsSender) {
+  s21::executor ex;
+  s21::channel<int> ch(ex, 4);
+  std::vector<int> got;
+  ex.spawn(SendRange(ch, 0, 100, true));
+  ex.spawn(ReceiveAll(ch, got));
+  EXPECT_EQ(ex.tasks(), 2U);
+  ASSERT_TRUE(ex.run_one());
+  // The sender filled the buffer and is now waiting.
+  EXPECT_EQ(ch.size(), 4U);
+  EXPECT_TRUE(ch.try_receive().has_value());
+  ex.run();
+  EXPECT_EQ(ex.tasks(), 0U);
+  ASSERT_EQ(got.size(), 99U);
+  for (int i = 0; i < 99; ++i) {
+    EXPECT_EQ(got[i], i + 1);
+  }
+}
+
+TEST(channel, RendezvousDeliversEachValueOnce) {
+  s21::executor ex;
+  s21::channel<int> ch(ex, 0);
+  std::vector<int> got[3];
+  for (std::vector<int>& out : got) {
+    ex.spawn(ReceiveAll(ch, out));
+  }
+  ex.spawn(SendRange(ch, 0, 30, true));
+  ex.run();
+  EXPECT_EQ(ex.tasks(), 0U);
+  std::vector<int> all;
+  for (const std::vector<int>& out : got) {
+    EXPECT_FALSE(out.empty());
+    EXPECT_TRUE(std::is_sorted(out.begin(), out.end()));
+    all.insert(all.end(), out.begin(), out.end());
+  }
+  std::sort(all.begin(), all.end());
+  std::vector<int> expected(30);
+  std::iota(expected.begin(), expected.end(), 0);
+  EXPECT_EQ(all, expected);
+}
+
+TEST(channel, CloseWakesWaitersAndErrorsPropagate) {
+  std::vector<int> got;
+  int sent = -1;
+  {
+    s21::executor ex;
+    s21::channel<int> full(ex, 1);
+    s21::channel<int> idle(ex);
+    s21::channel<int> never(ex);
+    ASSERT_TRUE(full.try_send(7));
+    ex.spawn(SendOnce(full, 8, sent));
+    ex.spawn(ReceiveAll(idle, got));
+    ex.spawn(ReceiveAll(never, got));
+    ex.run();
+    EXPECT_EQ(ex.tasks(), 3U);
+    full.close();
+    idle.cancel();
+    ex.run();
+    EXPECT_EQ(sent, 0);
+    EXPECT_TRUE(got.empty());
+    // The receiver on never is still suspended; the executor frees it.
+    EXPECT_EQ(ex.tasks(), 1U);
+    ex.spawn(Throw());
+    EXPECT_THROW(ex.run(), std::runtime_error);
+  }
+  {
+    s21::executor ex;
+    auto ch = std::make_unique<s21::channel<int>>(ex);
+    ex.spawn(ReceiveAll(*ch, got));
+    ex.run();
+    ch.reset();
+  }
+  EXPECT_TRUE(got.empty());
+}
+#endif
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();